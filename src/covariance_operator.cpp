@@ -0,0 +1,387 @@
+//=============================================================================
+// covariance_operator.cpp
+//
+//    The exponential covariance matrix of a set of observations as an
+//    operator: products are computed on the fly from the coordinates, and
+//    systems are solved by preconditioned conjugate gradients.
+//
+// references:
+// o  Golub, G.H., and Van Loan, C.F., 1996, MATRIX COMPUTATIONS, 3rd Edition,
+//    Johns Hopkins University Press, Baltimore, Maryland, 694 pp.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "covariance_operator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+
+#include "linear_systems.h"
+#include "parallel-inl.h"
+
+namespace{
+   // The maximum number of observations in one block.
+   const int BLOCK_SIZE = 256;
+
+   // Blocks separated by more than CUTOFF ranges do not interact; the
+   // exponential covariance is then below 1e-16 of the partial sill.
+   const double CUTOFF = 12.5;
+
+   // The maximum number of conjugate gradient iterations.
+   const int MAXIMUM_ITERATIONS = 1000;
+}
+
+//=============================================================================
+// CovarianceOperator
+//
+//    Partition the observations into compact blocks.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observations.
+//
+// Notes:
+//
+// o  The observations are reordered by recursive coordinate bisection into
+//    blocks of at most BLOCK_SIZE observations. The blocks serve both the
+//    threaded matrix-vector product and the preconditioner.
+//
+// o  Only the coordinates and the preconditioner are stored: O(N) memory
+//    for a fixed BLOCK_SIZE.
+//=============================================================================
+CovarianceOperator::CovarianceOperator( double nugget, double sill, double range, const std::vector<ObsRecord>& obs )
+   : m_Nugget(nugget), m_Sill(sill), m_Range(range)
+{
+   assert( obs.size() > 0 );
+
+   const int N = obs.size();
+
+   m_Perm.resize(N);
+   for (int n = 0; n < N; ++n)
+      m_Perm[n] = n;
+
+   m_X.resize(N);
+   m_Y.resize(N);
+   for (int n = 0; n < N; ++n) {
+      m_X[n] = obs[n].x;
+      m_Y[n] = obs[n].y;
+   }
+
+   Bisect(0, N);
+
+   std::vector<double> x(m_X), y(m_Y);
+   for (int n = 0; n < N; ++n) {
+      m_X[n] = x[m_Perm[n]];
+      m_Y[n] = y[m_Perm[n]];
+   }
+
+   for (unsigned k = 0; k < m_Blocks.size(); ++k) {
+      Block& block = m_Blocks[k];
+      block.xmin = block.xmax = m_X[block.begin];
+      block.ymin = block.ymax = m_Y[block.begin];
+      for (int n = block.begin+1; n < block.end; ++n) {
+         block.xmin = std::min(block.xmin, m_X[n]);
+         block.xmax = std::max(block.xmax, m_X[n]);
+         block.ymin = std::min(block.ymin, m_Y[n]);
+         block.ymax = std::max(block.ymax, m_Y[n]);
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Recursively split the index range [begin, end) of m_Perm at the median of
+// the longer side of its bounding box.
+//-----------------------------------------------------------------------------
+void CovarianceOperator::Bisect( int begin, int end )
+{
+   if (end - begin <= BLOCK_SIZE) {
+      Block block;
+      block.begin = begin;
+      block.end   = end;
+      m_Blocks.push_back(block);
+      return;
+   }
+
+   double xmin = m_X[m_Perm[begin]], xmax = xmin;
+   double ymin = m_Y[m_Perm[begin]], ymax = ymin;
+   for (int n = begin+1; n < end; ++n) {
+      xmin = std::min(xmin, m_X[m_Perm[n]]);
+      xmax = std::max(xmax, m_X[m_Perm[n]]);
+      ymin = std::min(ymin, m_Y[m_Perm[n]]);
+      ymax = std::max(ymax, m_Y[m_Perm[n]]);
+   }
+   const std::vector<double>& key = (xmax-xmin >= ymax-ymin) ? m_X : m_Y;
+
+   int middle = begin + (end-begin)/2;
+   std::nth_element( m_Perm.begin()+begin, m_Perm.begin()+middle, m_Perm.begin()+end,
+      [&](int a, int b) { return key[a] < key[b]; } );
+
+   Bisect(begin, middle);
+   Bisect(middle, end);
+}
+
+//-----------------------------------------------------------------------------
+// The covariance between the observations i and j, in the block order.
+//-----------------------------------------------------------------------------
+double CovarianceOperator::Entry( int i, int j ) const
+{
+   if (i == j) return m_Sill;
+
+   double dx = m_X[i] - m_X[j];
+   double dy = m_Y[i] - m_Y[j];
+   return (m_Sill-m_Nugget)*exp(-3.0*sqrt(dx*dx + dy*dy)/m_Range);
+}
+
+//-----------------------------------------------------------------------------
+// The distance between the bounding boxes of two blocks.
+//-----------------------------------------------------------------------------
+double CovarianceOperator::Gap( const Block& a, const Block& b ) const
+{
+   double dx = std::max(0.0, std::max(a.xmin - b.xmax, b.xmin - a.xmax));
+   double dy = std::max(0.0, std::max(a.ymin - b.ymax, b.ymin - a.ymax));
+   return sqrt(dx*dx + dy*dy);
+}
+
+//=============================================================================
+// Factor
+//
+//    Compute the block Jacobi preconditioner: the Cholesky decomposition of
+//    the covariance matrix of each block.
+//
+// Return:
+//
+//    true  if every block was factored successfully;
+//    false if not.
+//=============================================================================
+bool CovarianceOperator::Factor()
+{
+   std::atomic<bool> ok(true);
+
+   ParallelFor(0, m_Blocks.size(), [&](int k) {
+      Block& block = m_Blocks[k];
+      const int n = block.end - block.begin;
+
+      block.L.Resize(n);
+      for (int i = 0; i < n; ++i)
+         for (int j = 0; j <= i; ++j)
+            block.L(i,j) = Entry(block.begin+i, block.begin+j);
+
+      if (!CholeskyDecomposition(block.L, block.L)) ok = false;
+   });
+
+   return ok;
+}
+
+//-----------------------------------------------------------------------------
+// z = M~r, where M is the block diagonal of C, in the block order.
+//-----------------------------------------------------------------------------
+void CovarianceOperator::Precondition( const Matrix& r, Matrix& z ) const
+{
+   const int R = r.nCols();
+
+   z.Resize(r.nRows(), R);
+
+   ParallelFor(0, m_Blocks.size(), [&](int k) {
+      const Block& block = m_Blocks[k];
+      const int n = block.end - block.begin;
+
+      Matrix rb(n, R, r.Base(block.begin,0)), zb;
+      CholeskySolve(block.L, rb, zb);
+      std::copy( zb.begin(), zb.end(), z.Base(block.begin,0) );
+   });
+}
+
+//=============================================================================
+// Multiply
+//
+//    y = C x, for an (N x R) Matrix x in the original observation order.
+//
+// Notes:
+//
+// o  The covariances are computed on the fly and never stored. Each one is
+//    used for all R columns of x, so multiplying many vectors at once
+//    amortizes the cost of the exponentials.
+//
+// o  The rows are processed block by block in parallel. Pairs of blocks
+//    more than CUTOFF ranges apart are skipped, so the cost is O(N^2) for a
+//    range comparable to the domain, and nearer O(N) for a small range.
+//=============================================================================
+void CovarianceOperator::Multiply( const Matrix& x, Matrix& y ) const
+{
+   assert( x.nRows() == nRows() );
+
+   const int N = nRows();
+   const int R = x.nCols();
+
+   Matrix xp(N, R), yp;
+   for (int n = 0; n < N; ++n)
+      for (int r = 0; r < R; ++r)
+         xp(n,r) = x(m_Perm[n],r);
+
+   MultiplyPermuted(xp, yp);
+
+   y.Resize(N, R);
+   for (int n = 0; n < N; ++n)
+      for (int r = 0; r < R; ++r)
+         y(m_Perm[n],r) = yp(n,r);
+}
+
+//-----------------------------------------------------------------------------
+void CovarianceOperator::MultiplyPermuted( const Matrix& x, Matrix& y ) const
+{
+   const int R = x.nCols();
+
+   y.Resize(x.nRows(), R);
+
+   ParallelFor(0, m_Blocks.size(), [&](int k) {
+      const Block& a = m_Blocks[k];
+
+      for (unsigned l = 0; l < m_Blocks.size(); ++l) {
+         const Block& b = m_Blocks[l];
+         if (Gap(a, b) > CUTOFF*m_Range) continue;
+
+         for (int i = a.begin; i < a.end; ++i) {
+            double* p = y.Base(i,0);
+            for (int j = b.begin; j < b.end; ++j) {
+               const double c = Entry(i, j);
+               const double* q = x.Base(j,0);
+               for (int r = 0; r < R; ++r)
+                  p[r] += c*q[r];
+            }
+         }
+      }
+   });
+}
+
+//=============================================================================
+// Solve
+//
+//    Solve C x = b by preconditioned conjugate gradients.
+//
+// Arguments:
+//
+//    b     the (N x R) right hand sides, in the original observation order.
+//
+//    x     on exit, the (N x R) solutions.
+//
+//    tolerance
+//          the convergence criterion: ||b - Cx|| <= tolerance ||b|| for
+//          every column.
+//
+//    iterations
+//          on exit, the number of iterations taken.
+//
+// Return:
+//
+//    true  if every column converged;
+//    false if not.
+//
+// Notes:
+//
+// o  Each column runs its own conjugate gradient recurrence, but all of the
+//    columns share each matrix product. Converged columns are frozen. See
+//    Golub and Van Loan (1996), Algorithm 10.3.1.
+//
+// o  The Factor routine must have been called first. Solve may be called
+//    concurrently.
+//=============================================================================
+bool CovarianceOperator::Solve( const Matrix& b, Matrix& x, double tolerance, int& iterations ) const
+{
+   assert( b.nRows() == nRows() );
+
+   const int N = nRows();
+   const int R = b.nCols();
+
+   Matrix bp(N, R);
+   for (int n = 0; n < N; ++n)
+      for (int c = 0; c < R; ++c)
+         bp(n,c) = b(m_Perm[n],c);
+
+   // The column-wise dot products of two (N x R) matrices.
+   auto dot = [&](const Matrix& u, const Matrix& v, std::vector<double>& d) {
+      d.assign(R, 0.0);
+      for (int n = 0; n < N; ++n) {
+         const double* p = u.Base(n,0);
+         const double* q = v.Base(n,0);
+         for (int c = 0; c < R; ++c)
+            d[c] += p[c]*q[c];
+      }
+   };
+
+   Matrix xp(N, R, 0.0);
+   Matrix r(bp), z, p, q;
+   Precondition(r, z);
+   p = z;
+
+   std::vector<double> bb, rz, pq, rr;
+   dot(bp, bp, bb);
+   dot(r, z, rz);
+
+   std::vector<int> active(R);
+   int nActive = 0;
+   for (int c = 0; c < R; ++c) {
+      active[c] = (bb[c] > 0.0);
+      nActive += active[c];
+   }
+
+   for (iterations = 0; nActive > 0 && iterations < MAXIMUM_ITERATIONS; ++iterations) {
+      MultiplyPermuted(p, q);
+      dot(p, q, pq);
+
+      for (int n = 0; n < N; ++n) {
+         for (int c = 0; c < R; ++c) {
+            if (!active[c]) continue;
+            double alpha = rz[c]/pq[c];
+            xp(n,c) += alpha*p(n,c);
+            r(n,c)  -= alpha*q(n,c);
+         }
+      }
+
+      dot(r, r, rr);
+      for (int c = 0; c < R; ++c) {
+         if (active[c] && rr[c] <= tolerance*tolerance*bb[c]) {
+            active[c] = 0;
+            --nActive;
+         }
+      }
+
+      Precondition(r, z);
+
+      std::vector<double> rznew;
+      dot(r, z, rznew);
+
+      std::vector<double> beta(R, 0.0);
+      for (int c = 0; c < R; ++c) {
+         if (active[c]) beta[c] = rznew[c]/rz[c];
+         rz[c] = rznew[c];
+      }
+
+      for (int n = 0; n < N; ++n)
+         for (int c = 0; c < R; ++c)
+            p(n,c) = active[c] ? z(n,c) + beta[c]*p(n,c) : 0.0;
+   }
+
+   x.Resize(N, R);
+   for (int n = 0; n < N; ++n)
+      for (int c = 0; c < R; ++c)
+         x(m_Perm[n],c) = xp(n,c);
+
+   return (nActive == 0);
+}
+
+//-----------------------------------------------------------------------------
+int CovarianceOperator::nRows() const
+{
+   return m_Perm.size();
+}
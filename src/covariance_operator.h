@@ -0,0 +1,67 @@
+//=============================================================================
+// covariance_operator.h
+//
+//    The exponential covariance matrix of a set of observations as an
+//    operator: products are computed on the fly from the coordinates, and
+//    systems are solved by preconditioned conjugate gradients.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef COVARIANCE_OPERATOR_H
+#define COVARIANCE_OPERATOR_H
+
+#include <vector>
+
+#include "matrix.h"
+#include "packed_matrix.h"
+#include "read_obs.h"
+
+//=============================================================================
+// CovarianceOperator
+//=============================================================================
+class CovarianceOperator
+{
+public:
+   // Life cycle
+   CovarianceOperator( double nugget, double sill, double range, const std::vector<ObsRecord>& obs );
+
+   // Operations
+   bool Factor();                                     // block Jacobi preconditioner
+   void Multiply( const Matrix& x, Matrix& y ) const; // y = C x
+   bool Solve( const Matrix& b, Matrix& x, double tolerance, int& iterations ) const;
+
+   // Inquiry.
+   int nRows() const;                                 // number of observations
+
+private:
+   struct Block {
+      int    begin;                                   // first (permuted) index
+      int    end;                                     // one past the last index
+      double xmin, xmax, ymin, ymax;                  // bounding box
+      PackedMatrix L;                                 // Cholesky of C(block)
+   };
+
+   void Bisect( int begin, int end );
+   double Entry( int i, int j ) const;
+   double Gap( const Block& a, const Block& b ) const;
+   void Precondition( const Matrix& r, Matrix& z ) const;
+   void MultiplyPermuted( const Matrix& x, Matrix& y ) const;
+
+   double m_Nugget;
+   double m_Sill;
+   double m_Range;
+
+   std::vector<int>    m_Perm;                        // block order -> input order
+   std::vector<double> m_X;                           // coordinates in block order
+   std::vector<double> m_Y;
+   std::vector<Block>  m_Blocks;
+};
+
+//=============================================================================
+#endif  // COVARIANCE_OPERATOR_H
@@ -10,31 +10,1919 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <iomanip>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <math.h>
 #include <numeric>
 #include <sstream>
+#include <unordered_map>
 
+#include "covariance_operator.h"
 #include "engine.h"
+#include "fixed_matrix-inl.h"
+#include "gemm.h"
+#include "hmatrix.h"
+#include "likelihood.h"
 #include "matrix.h"
+#include "mixed_cholesky.h"
 #include "linear_systems.h"
+#include "packed_matrix.h"
+#include "parallel-inl.h"
+#include "sparse_matrix.h"
+#include "spatial_order.h"
+#include "special_functions.h"
+#include "weight_operator.h"
+
+namespace{
+   // Manifest constants.
+   const int MINIMUM_COUNT = 10;
+   const int MAXIMUM_COUNT = 500;
+   const double MIN_EIGENVALUE = 1e-12;
+   const int TARGET_PANEL = 8;
+   const int WEIGHT_BLOCK = 256;
+   const int PROBABILITY_BLOCK = 1024;
+   const double MIN_KEPT_SUM = 1e-2;
+
+   // Manifest constants for the iterative solver.
+   const int MAXIMUM_ITERATIVE_COUNT = 1000000;
+   const int TARGET_BATCH = 32;
+   const double SOLVER_TOLERANCE = 1e-10;
+
+   // Manifest constants for the hierarchical matrix engine.
+   const int MAXIMUM_HMATRIX_COUNT = 1000000;
+
+   // Manifest constants for the tapered engine.
+   const int MAXIMUM_TAPER_COUNT = 1000000;
+
+   // Manifest constants for the mixed precision engine.
+   const int MAXIMUM_MIXED_COUNT = 10000;
+
+   // Manifest constants for the local neighborhood engine.
+   const int MAXIMUM_LOCAL_COUNT = 10000000;
+   const int LOCAL_LANES = 4;
+   const int LOCAL_BLOCK = 64;
+   const unsigned LOCAL_CACHE_ENTRIES = 1024;
+
+   // Manifest constants for the parameter estimation.
+   const int MAXIMUM_ESTIMATE_COUNT = 5000;
+   const int MAXIMUM_ITERATIONS = 100;
+   const double FUNCTION_TOLERANCE = 1e-10;
+   const double GRADIENT_TOLERANCE = 1e-6;
+   const double MAXIMUM_STEP = 2.0;
+
+   //--------------------------------------------------------------------------
+   // Validate the number of observations against the limits of an engine.
+   //--------------------------------------------------------------------------
+   void CheckObservationCount( int N, int maximum = MAXIMUM_COUNT, int minimum = MINIMUM_COUNT )
+   {
+      if (N < minimum) {
+         std::stringstream message;
+         message << "There must be at least " << minimum << " observations.";
+         throw TooFewObservations(message.str());
+      }
+
+      if (N > maximum) {
+         std::stringstream message;
+         message << "There must be no more than " << maximum << " observations.";
+         throw TooManyObservations(message.str());
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // Create the covariance matrix for all of the observations.
+   //--------------------------------------------------------------------------
+   void Covariance( double nugget, double sill, double range, const std::vector<ObsRecord>& obs, PackedMatrix& C )
+   {
+      const int N = obs.size();
+
+      C.Resize(N);
+      for (int i = 0; i < N; ++i) {
+         for (int j = 0; j < i; ++j) {
+            double h = hypot( obs[i].x-obs[j].x, obs[i].y-obs[j].y );
+            C(i,j) = (sill-nugget)*exp(-3.0*h/range);
+         }
+         C(i,i) = sill;
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // Compute the Ordinary Kriging estimate and standard deviation at one
+   // target, given the covariance vector b, u = C~b, v = C~1, and
+   // sumv = 1'v.
+   //--------------------------------------------------------------------------
+   void Predict( double sill, const Matrix& u, const Matrix& v, double sumv, const Matrix& Z, const Matrix& b, double& zhat, double& kstd )
+   {
+      // Solve the Ordinary Kriging system.
+      double lambda = (Sum(u) - 1) / sumv;
+
+      Matrix w = u - lambda*v;
+
+      zhat = DotProduct(w, Z);
+      kstd = sqrt( sill - DotProduct(b, w) - lambda );
+   }
+
+   //--------------------------------------------------------------------------
+   // Create and factor, in place, the covariance matrix C of the
+   // observations, and solve for [v a] = C~[1 z].
+   //--------------------------------------------------------------------------
+   void Factor( double nugget, double sill, double range, const std::vector<ObsRecord>& obs, PackedMatrix& L, Matrix& va )
+   {
+      const int N = obs.size();
+
+      Covariance(nugget, sill, range, obs, L);
+      if (!CholeskyDecomposition(L,L)) {
+         throw CholeskyDecompositionFailed("Cholesky decomposition of the Kriging system failed.");
+      }
+
+      Matrix rhs(N, 2);
+      for (int n = 0; n < N; ++n) {
+         rhs(n,0) = 1.0;
+         rhs(n,1) = obs[n].z;
+      }
+      CholeskySolve(L,rhs,va);
+   }
+
+   //--------------------------------------------------------------------------
+   // Correct the order relations of an estimated ccdf, F[0..K-1] at
+   // increasing thresholds: the average of an upward and a downward pass,
+   // each of which clips to [0,1] and forces the values to be
+   // non-decreasing, as in GSLIB.
+   //--------------------------------------------------------------------------
+   void OrderRelations( double* F, int K, double* up )
+   {
+      double f = 0.0;
+      for (int k = 0; k < K; ++k) {
+         f = std::max( f, std::min(F[k], 1.0) );
+         up[k] = f;
+      }
+
+      f = 1.0;
+      for (int k = K-1; k >= 0; --k) {
+         f = std::min( f, std::max(F[k], 0.0) );
+         F[k] = 0.5*(up[k] + f);
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // The factored Ordinary Kriging system of Engine, for kriging panels of
+   // up to TARGET_PANEL targets.
+   //
+   // o  With L the Cholesky factor of C, w = L~b, v = C~1, a = C~z,
+   //    sumv = 1'v, vz = 1'a, and lambda = (v'b - 1)/sumv:
+   //
+   //       zhat = a'b - lambda*vz
+   //       kstd = sqrt( sill - w'w + lambda*v'b - lambda )
+   //
+   //    which is Predict rearranged so that only the forward substitution
+   //    is needed; see also KrigingModel::Predict.
+   //
+   // o  All of it is done in one sweep through the rows of L. Row i of
+   //    every right hand side b is generated from the coordinates just
+   //    before it is needed, v'b, a'b, and w'w are accumulated as the row
+   //    is finished, and each row of L is used for the whole panel at once,
+   //    so L is read once per panel and no N-vector is built and reread.
+   //
+   // o  The panel of w is interleaved, one target per column, so that the
+   //    innermost loop is over the targets, with unit stride.
+   //--------------------------------------------------------------------------
+   struct Panel {
+      double nugget, sill, range;
+      const std::vector<ObsRecord>& obs;
+      const PackedMatrix& L;
+      const Matrix& va;                   // [v a]
+      double sumv;
+      double vz;
+
+      // The forward sweep: w = L~b, interleaved with P = TARGET_PANEL
+      // columns, and the sums v'b, a'b, and w'w, for each target.
+      void Forward( const TargetRecord* targets, int count, double* w, double* vb, double* ab, double* ww ) const {
+         const int N = obs.size();
+         const int P = TARGET_PANEL;
+         assert( 0 < count && count <= P );
+
+         for (int p = 0; p < P; ++p)
+            vb[p] = ab[p] = ww[p] = 0.0;
+
+         for (int i = 0; i < N; ++i) {
+            // Row i of the right hand sides, and their projections.
+            double t[P] = { 0.0 };
+            for (int p = 0; p < count; ++p) {
+               double h = hypot(targets[p].x - obs[i].x, targets[p].y - obs[i].y);
+               t[p] = (sill - nugget) * exp(-3.0 * h / range);
+            }
+            const double vi = va(i,0), ai = va(i,1);
+            for (int p = 0; p < P; ++p) {
+               vb[p] += vi * t[p];
+               ab[p] += ai * t[p];
+            }
+
+            // Row i of the forward substitution, for the whole panel.
+            const double* Li = L.Base(i);
+            for (int j = 0; j < i; ++j) {
+               const double lij = Li[j];
+               const double* wj = &w[static_cast<long>(j)*P];
+               for (int p = 0; p < P; ++p)
+                  t[p] -= lij * wj[p];
+            }
+            const double r = 1.0 / Li[i];
+            double* wi = &w[static_cast<long>(i)*P];
+            for (int p = 0; p < P; ++p) {
+               wi[p] = t[p] * r;
+               ww[p] += wi[p] * wi[p];
+            }
+         }
+      }
+
+      // The estimates and standard deviations, from the sums.
+      void Finish( const TargetRecord* targets, int count, const double* vb, const double* ab, const double* ww, ResultRecord* results ) const {
+         for (int p = 0; p < count; ++p) {
+            const double lambda = (vb[p] - 1) / sumv;
+            results[p].id   = targets[p].id;
+            results[p].x    = targets[p].x;
+            results[p].y    = targets[p].y;
+            results[p].zhat = ab[p] - lambda*vz;
+            results[p].kstd = sqrt( sill - ww[p] + lambda*vb[p] - lambda );
+         }
+      }
+
+      // Krige a panel of targets.
+      void Predict( const TargetRecord* targets, int count, ResultRecord* results ) const {
+         const int P = TARGET_PANEL;
+         std::vector<double> w( static_cast<long>(obs.size())*P );
+         double vb[P], ab[P], ww[P];
+
+         Forward(targets, count, w.data(), vb, ab, ww);
+         Finish(targets, count, vb, ab, ww, results);
+      }
+
+      // Krige a panel of targets as Predict, and also write the Kriging
+      // weights of target p, C~b - lambda*v, to column p of W.
+      void Weights( const TargetRecord* targets, int count, double* W, int ldw, ResultRecord* results ) const {
+         const int N = obs.size();
+         const int P = TARGET_PANEL;
+         std::vector<double> w( static_cast<long>(N)*P );
+         double vb[P], ab[P], ww[P];
+
+         Forward(targets, count, w.data(), vb, ab, ww);
+         Finish(targets, count, vb, ab, ww, results);
+
+         // The back substitution, u = L'~w, by the rows of L.
+         for (int i = N-1; i >= 0; --i) {
+            const double* Li = L.Base(i);
+            double* wi = &w[static_cast<long>(i)*P];
+            const double r = 1.0 / Li[i];
+            for (int p = 0; p < P; ++p)
+               wi[p] *= r;
+            for (int j = 0; j < i; ++j) {
+               const double lij = Li[j];
+               double* wj = &w[static_cast<long>(j)*P];
+               for (int p = 0; p < P; ++p)
+                  wj[p] -= lij * wi[p];
+            }
+         }
+
+         // The weights; 1'u = v'b.
+         for (int i = 0; i < N; ++i) {
+            const double vi = va(i,0);
+            const double* ui = &w[static_cast<long>(i)*P];
+            double* Wi = W + static_cast<long>(i)*ldw;
+            for (int p = 0; p < count; ++p)
+               Wi[p] = ui[p] - (vb[p] - 1) / sumv * vi;
+         }
+      }
+   };
+
+   //--------------------------------------------------------------------------
+   // Ordinary Kriging with the covariance matrix as an operator, for more
+   // observations than can be factored densely.
+   //
+   // o  The covariance products are computed on the fly from coordinates, so
+   //    the memory is O(N). Systems are solved by block Jacobi
+   //    preconditioned conjugate gradients; see CovarianceOperator.
+   //
+   // o  The Lagrange constraint is handled outside of the conjugate gradient
+   //    iterations: v = C~1 is solved once, and each target then needs only
+   //    u = C~b, combined exactly as in Predict.
+   //
+   // o  The targets are solved in batches of TARGET_BATCH right hand sides,
+   //    which share each product with C. The products themselves are
+   //    computed in parallel.
+   //--------------------------------------------------------------------------
+   std::vector<ResultRecord> Iterative( double nugget, double sill, double range, const std::vector<ObsRecord>& obs, const std::vector<TargetRecord>& targets )
+   {
+      const int N = obs.size();
+      const int M = targets.size();
+
+      if (N > MAXIMUM_ITERATIVE_COUNT) {
+         std::stringstream message;
+         message << "There must be no more than " << MAXIMUM_ITERATIVE_COUNT << " observations.";
+         throw TooManyObservations(message.str());
+      }
+
+      // Create the matrix of observed values.
+      Matrix Z(N, 1);
+      for (int n = 0; n < N; ++n)
+         Z(n,0) = obs[n].z;
+
+      // Setup the covariance operator and its preconditioner.
+      CovarianceOperator C(nugget, sill, range, obs);
+      if (!C.Factor()) {
+         throw CholeskyDecompositionFailed("Cholesky decomposition of the Kriging preconditioner failed.");
+      }
+
+      // Precompute the v matrix.
+      Matrix ones(N, 1, 1.0);
+      Matrix v;
+      int iterations;
+      if (!C.Solve(ones, v, SOLVER_TOLERANCE, iterations)) {
+         throw IterativeSolverFailed("The conjugate gradient solution of the Kriging system did not converge.");
+      }
+      double sumv = Sum(v);
+
+      // Krige the targets in batches.
+      std::vector<ResultRecord> results(M);
+
+      for (int m0 = 0; m0 < M; m0 += TARGET_BATCH) {
+         const int R = std::min(TARGET_BATCH, M - m0);
+
+         Matrix B(N, R);
+         for (int n = 0; n < N; ++n) {
+            for (int r = 0; r < R; ++r) {
+               double h = hypot(targets[m0+r].x - obs[n].x, targets[m0+r].y - obs[n].y);
+               B(n,r) = (sill - nugget) * exp(-3.0 * h / range);
+            }
+         }
+
+         Matrix U;
+         if (!C.Solve(B, U, SOLVER_TOLERANCE, iterations)) {
+            throw IterativeSolverFailed("The conjugate gradient solution of the Kriging system did not converge.");
+         }
+
+         for (int r = 0; r < R; ++r) {
+            Matrix b(N,1), u(N,1);
+            for (int n = 0; n < N; ++n) {
+               b(n,0) = B(n,r);
+               u(n,0) = U(n,r);
+            }
+
+            ResultRecord& result = results[m0+r];
+            result.id = targets[m0+r].id;
+            result.x  = targets[m0+r].x;
+            result.y  = targets[m0+r].y;
+            Predict(sill, u, v, sumv, Z, b, result.zhat, result.kstd);
+         }
+      }
+
+      return results;
+   }
+
+   //--------------------------------------------------------------------------
+   // Compute the leave-one-out Ordinary Kriging residual and variance at all
+   // of the observations, given the diagonal of the inverse covariance
+   // matrix, v = C~1, and Cz = C~z. See Aakozi_Engine for the formulae.
+   //
+   // An observation with a zero diagonal (i.e. one whose row and column of
+   // C~ have been zeroed) gets a zero residual and a zero variance.
+   //--------------------------------------------------------------------------
+   void LeaveOneOut( const Matrix& diag, const Matrix& v, const Matrix& Cz, const Matrix& Z, Matrix& resid, Matrix& kvar )
+   {
+      const int N = diag.nRows();
+
+      double sumv = Sum(v);
+      double vz = DotProduct(v, Z);
+
+      resid.Resize(N, 1);
+      kvar.Resize(N, 1);
+
+      for (int n = 0; n < N; ++n) {
+         if (diag(n,0) <= 0.0) continue;
+
+         double q = diag(n,0) - v(n,0)*v(n,0)/sumv;
+         double r = Cz(n,0) - v(n,0)*vz/sumv;
+
+         resid(n,0) = r/q;
+         kvar(n,0)  = 1.0/q;
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // Compute the leave-one-out statistics from Cinv, the inverse of the
+   // covariance matrix.
+   //--------------------------------------------------------------------------
+   void LeaveOneOut( const PackedMatrix& Cinv, const Matrix& Z, Matrix& resid, Matrix& kvar )
+   {
+      const int N = Cinv.nRows();
+
+      Matrix diag(N, 1);
+      for (int n = 0; n < N; ++n)
+         diag(n,0) = Cinv(n,n);
+
+      Matrix ones(N, 1, 1.0);
+      Matrix v;
+      Multiply_SM(Cinv, ones, v);
+
+      Matrix Cz;
+      Multiply_SM(Cinv, Z, Cz);
+
+      LeaveOneOut(diag, v, Cz, Z, resid, kvar);
+   }
+
+   //--------------------------------------------------------------------------
+   // Compute the cross validation scores from the leave-one-out statistics.
+   //--------------------------------------------------------------------------
+   void Score( const Matrix& resid, const Matrix& kvar, SweepRecord& record )
+   {
+      const int N = resid.nRows();
+
+      double se = 0.0, sse = 0.0, ssse = 0.0;
+      for (int n = 0; n < N; ++n) {
+         se   += resid(n,0);
+         sse  += resid(n,0)*resid(n,0);
+         ssse += resid(n,0)*resid(n,0)/kvar(n,0);
+      }
+
+      record.me   = se/N;
+      record.rmse = sqrt(sse/N);
+      record.msse = ssse/N;
+   }
+
+   //--------------------------------------------------------------------------
+   // The Wendland taper, (1-r)^4 (4r+1) for r < 1 and 0 otherwise. It is
+   // positive definite in two and three dimensions, so the product of the
+   // taper and a covariance is a covariance. See Furrer et al. (2006).
+   //--------------------------------------------------------------------------
+   double Wendland( double r )
+   {
+      if (r >= 1.0) return 0.0;
+      double s = (1.0-r)*(1.0-r);
+      return s*s*(4.0*r + 1.0);
+   }
+
+   //--------------------------------------------------------------------------
+   // A uniform grid of square cells, for finding the observations within one
+   // cell width of a point.
+   //--------------------------------------------------------------------------
+   struct Grid {
+      double width;
+      std::unordered_map< long long, std::vector<int> > cells;
+      long long imin, imax, jmin, jmax;                  // occupied cells
+
+      Grid( const std::vector<ObsRecord>& obs, double w ) : width(w), imin(0), imax(-1), jmin(0), jmax(-1) {
+         for (unsigned n = 0; n < obs.size(); ++n) {
+            long long i = Cell(obs[n].x), j = Cell(obs[n].y);
+            cells[ Key(i,j) ].push_back(n);
+
+            if (n == 0) {
+               imin = imax = i;
+               jmin = jmax = j;
+            }
+            imin = std::min(imin, i);  imax = std::max(imax, i);
+            jmin = std::min(jmin, j);  jmax = std::max(jmax, j);
+         }
+      }
+
+      long long Cell( double x ) const {
+         return static_cast<long long>( floor(x/width) );
+      }
+
+      // The shift is done on unsigned values; cells left of or below the
+      // origin have negative indices.
+      long long Key( long long i, long long j ) const {
+         return static_cast<long long>( (static_cast<unsigned long long>(i) << 32) ^ static_cast<std::uint32_t>(j) );
+      }
+
+      // Append the candidates within one cell width of (x,y) to near.
+      void Near( double x, double y, std::vector<int>& near ) const {
+         near.clear();
+         long long ci = Cell(x), cj = Cell(y);
+         for (long long i = ci-1; i <= ci+1; ++i)
+            for (long long j = cj-1; j <= cj+1; ++j)
+               Append(i, j, near);
+      }
+
+      // The number of rings of cells between the cell holding (x,y) and the
+      // nearest occupied cell; the inner rings are all empty.
+      long long Gap( double x, double y ) const {
+         long long ci = Cell(x), cj = Cell(y);
+         return std::max( std::max(imin - ci, ci - imax), std::max(std::max(jmin - cj, cj - jmax), 0LL) );
+      }
+
+      // Set near to the candidates in the ring of cells exactly r cells
+      // away from the cell holding (x,y). Only the part of the ring that
+      // overlaps the occupied cells is searched, so a ring far from the
+      // data costs no more than one across it.
+      void Ring( double x, double y, long long r, std::vector<int>& near ) const {
+         near.clear();
+         long long ci = Cell(x), cj = Cell(y);
+         long long j0 = std::max(cj-r, jmin), j1 = std::min(cj+r, jmax);
+         for (long long i = std::max(ci-r, imin); i <= std::min(ci+r, imax); ++i) {
+            if (i == ci-r || i == ci+r) {
+               for (long long j = j0; j <= j1; ++j)
+                  Append(i, j, near);
+            }
+            else {
+               if (cj-r >= jmin && cj-r <= jmax) Append(i, cj-r, near);
+               if (cj+r >= jmin && cj+r <= jmax) Append(i, cj+r, near);
+            }
+         }
+      }
+
+      void Append( long long i, long long j, std::vector<int>& near ) const {
+         auto it = cells.find( Key(i,j) );
+         if (it != cells.end())
+            near.insert(near.end(), it->second.begin(), it->second.end());
+      }
+   };
+
+   //--------------------------------------------------------------------------
+   // Set best to the (squared distance, index) pairs of the k observations
+   // nearest to (x,y), in order of increasing index, so that targets with
+   // the same neighbors have identical Kriging systems.
+   //
+   // o  The rings of grid cells around (x,y) are searched outward, from
+   //    the first ring that reaches an occupied cell. An observation beyond
+   //    ring r is more than r cell widths away, so the search stops once
+   //    the k'th nearest candidate is closer than that.
+   //--------------------------------------------------------------------------
+   void Nearest( const Grid& grid, const std::vector<ObsRecord>& obs, double x, double y, int k,
+                 std::vector< std::pair<double,int> >& best, std::vector<int>& ring )
+   {
+      const unsigned N = obs.size();
+      unsigned seen = 0;
+
+      best.clear();
+      for (long long r = grid.Gap(x, y); seen < N; ++r) {
+         grid.Ring(x, y, r, ring);
+         seen += ring.size();
+
+         for (unsigned q = 0; q < ring.size(); ++q) {
+            double dx = x - obs[ring[q]].x;
+            double dy = y - obs[ring[q]].y;
+            best.push_back( std::make_pair(dx*dx + dy*dy, ring[q]) );
+         }
+
+         if (best.size() >= static_cast<unsigned>(k)) {
+            std::nth_element(best.begin(), best.begin() + (k-1), best.end());
+            best.resize(k);
+
+            double reach = r * grid.width;
+            if (best[k-1].first <= reach*reach)
+               break;
+         }
+      }
+      std::sort(best.begin(), best.end(), [](const std::pair<double,int>& a, const std::pair<double,int>& b) {
+         return a.second < b.second;
+      });
+   }
+
+   //--------------------------------------------------------------------------
+   // A factored local Kriging system: the Cholesky factor L of the
+   // covariance matrix of K observations, v = C~1, and sumv = 1'v.
+   //--------------------------------------------------------------------------
+   template <int K>
+   struct Neighborhood {
+      std::vector<int> index;             // the observations, in increasing order
+      FixedMatrix<K,K> L;
+      FixedMatrix<K,1> v;
+      double sumv;
+   };
+
+   //--------------------------------------------------------------------------
+   // A least-recently-used cache of factored neighborhoods, keyed by the
+   // set of observation indices, shared by all of the threads.
+   //
+   // o  The entries are handed out as shared pointers, so an entry that is
+   //    evicted while another thread is still using it stays alive until
+   //    that thread is done.
+   //--------------------------------------------------------------------------
+   template <int K>
+   class NeighborhoodCache {
+   public:
+      typedef std::shared_ptr< const Neighborhood<K> > Entry;
+
+      explicit NeighborhoodCache( unsigned capacity ) : m_Capacity(capacity), m_Lookups(0), m_Hits(0) {}
+
+      // The factored neighborhood with exactly these observations, or null.
+      Entry Find( const std::vector<int>& index ) {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         ++m_Lookups;
+
+         auto it = m_Map.find( Hash(index) );
+         if (it == m_Map.end() || (*it->second)->index != index)
+            return Entry();
+
+         m_List.splice(m_List.begin(), m_List, it->second);
+         ++m_Hits;
+         return *it->second;
+      }
+
+      // Add a newly factored neighborhood, evicting the least recently used.
+      void Insert( const Entry& entry ) {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+
+         const size_t key = Hash(entry->index);
+         auto it = m_Map.find(key);
+         if (it != m_Map.end()) {
+            m_List.erase(it->second);
+            m_Map.erase(it);
+         }
+         else if (m_List.size() >= m_Capacity) {
+            m_Map.erase( Hash(m_List.back()->index) );
+            m_List.pop_back();
+         }
+
+         m_List.push_front(entry);
+         m_Map[key] = m_List.begin();
+      }
+
+      long Lookups() const { return m_Lookups; }
+      long Hits() const { return m_Hits; }
+
+   private:
+      static size_t Hash( const std::vector<int>& index ) {
+         size_t h = 14695981039346656037ULL;
+         for (unsigned i = 0; i < index.size(); ++i)
+            h = (h ^ static_cast<unsigned>(index[i])) * 1099511628211ULL;
+         return h;
+      }
+
+      std::mutex m_Mutex;
+      unsigned m_Capacity;
+      long m_Lookups;
+      long m_Hits;
+      std::list<Entry> m_List;
+      std::unordered_map< size_t, typename std::list<Entry>::iterator > m_Map;
+   };
+
+   //--------------------------------------------------------------------------
+   // Local neighborhood Ordinary Kriging of all of the targets, called
+   // through FixedDispatch, so that K is a compile-time constant.
+   //
+   // o  The targets are taken in blocks of LOCAL_BLOCK consecutive targets,
+   //    and the blocks are kriged in parallel.
+   //
+   // o  A target whose neighborhood is in the cache needs only its own
+   //    right hand side, b, and one solve with the cached factor.
+   //
+   // o  The other targets are queued until there are LOCAL_LANES of them.
+   //    Their systems are then interleaved in FixedBatch objects, one per
+   //    SIMD lane, factored and solved together, and added to the cache.
+   //--------------------------------------------------------------------------
+   struct LocalKriging {
+      double nugget, sill, range;
+      const std::vector<ObsRecord>& obs;
+      const std::vector<TargetRecord>& targets;
+      const Grid& grid;
+      std::vector<ResultRecord>& results;
+      CacheRecord cache;
+      bool ok;
+
+      double Covariance( double h2 ) const {
+         return (sill - nugget) * exp(-3.0 * sqrt(h2) / range);
+      }
+
+      // Combine u = C~b and v = C~1 as in Predict.
+      template <int K>
+      void Finish( int m, const std::vector< std::pair<double,int> >& near,
+                   const double* u, int du, const double* v, int dv, double sumv, const double* b, int db ) {
+         double sumu = 0.0;
+         for (int i = 0; i < K; ++i)
+            sumu += u[i*du];
+         const double lambda = (sumu - 1) / sumv;
+
+         double wz = 0.0, wb = 0.0;
+         for (int i = 0; i < K; ++i) {
+            const double w = u[i*du] - lambda*v[i*dv];
+            wz += w * obs[near[i].second].z;
+            wb += w * b[i*db];
+         }
+
+         results[m].id   = targets[m].id;
+         results[m].x    = targets[m].x;
+         results[m].y    = targets[m].y;
+         results[m].zhat = wz;
+         results[m].kstd = sqrt( sill - wb - lambda );
+      }
+
+      // Factor and solve the n <= LOCAL_LANES queued targets as one batch.
+      // Returns false if one of the systems is not positive definite.
+      template <int K>
+      bool Flush( NeighborhoodCache<K>& store, const int* queue, std::vector< std::pair<double,int> >* near, int n ) {
+         const int L = LOCAL_LANES;
+         if (n == 0) return true;
+
+         // The covariance matrices, and the right hand sides [b, 1]. The
+         // unused lanes repeat the last target.
+         FixedBatch<K,K,L> C;
+         FixedBatch<K,2,L> U;
+         FixedBatch<K,1,L> b;
+         for (int l = 0; l < L; ++l) {
+            const std::vector< std::pair<double,int> >& p = near[std::min(l, n-1)];
+            for (int i = 0; i < K; ++i) {
+               const ObsRecord& a = obs[p[i].second];
+               for (int j = 0; j < i; ++j) {
+                  const ObsRecord& c = obs[p[j].second];
+                  double dx = a.x - c.x, dy = a.y - c.y;
+                  C(i,j)[l] = Covariance(dx*dx + dy*dy);
+               }
+               C(i,i)[l] = sill;
+               U(i,0)[l] = b(i,0)[l] = Covariance(p[i].first);
+               U(i,1)[l] = 1.0;
+            }
+         }
+
+         if (!CholeskyDecomposition(C))
+            return false;
+         CholeskySolve(C, U);
+
+         for (int l = 0; l < n; ++l) {
+            std::shared_ptr< Neighborhood<K> > entry(new Neighborhood<K>);
+            entry->index.resize(K);
+            entry->sumv = 0.0;
+            for (int i = 0; i < K; ++i) {
+               entry->index[i] = near[l][i].second;
+               for (int j = 0; j <= i; ++j)
+                  entry->L(i,j) = C(i,j)[l];
+               entry->v(i,0) = U(i,1)[l];
+               entry->sumv += U(i,1)[l];
+            }
+            store.Insert(entry);
+
+            Finish<K>(queue[l], near[l], U(0,0)+l, 2*L, U(0,1)+l, 2*L, entry->sumv, b(0,0)+l, L);
+         }
+         return true;
+      }
+
+      template <int K>
+      void Run() {
+         NeighborhoodCache<K> store(LOCAL_CACHE_ENTRIES);
+         const int M = targets.size();
+         std::atomic<bool> failed(false);
+
+         ParallelFor(0, (M + LOCAL_BLOCK - 1) / LOCAL_BLOCK, [&](int block) {
+            bool definite = true;
+            std::vector< std::pair<double,int> > near[LOCAL_LANES];
+            std::vector< std::pair<double,int> > here;
+            std::vector<int> index(K), ring;
+            int queue[LOCAL_LANES];
+            int n = 0;
+
+            for (int m = block*LOCAL_BLOCK; m < std::min(M, (block+1)*LOCAL_BLOCK); ++m) {
+               Nearest(grid, obs, targets[m].x, targets[m].y, K, here, ring);
+               for (int i = 0; i < K; ++i)
+                  index[i] = here[i].second;
+
+               // A neighborhood already in the queue must be factored
+               // before it can be shared.
+               for (int l = 0; l < n; ++l) {
+                  if (std::equal(index.begin(), index.end(), near[l].begin(),
+                                 [](int a, const std::pair<double,int>& p) { return a == p.second; })) {
+                     definite &= Flush<K>(store, queue, near, n);
+                     n = 0;
+                     break;
+                  }
+               }
+
+               typename NeighborhoodCache<K>::Entry entry = store.Find(index);
+               if (entry) {
+                  FixedMatrix<K,1> b, u;
+                  for (int i = 0; i < K; ++i)
+                     u(i,0) = b(i,0) = Covariance(here[i].first);
+                  CholeskySolve(entry->L, u);
+                  Finish<K>(m, here, u.Base(), 1, entry->v.Base(), 1, entry->sumv, b.Base(), 1);
+               }
+               else {
+                  queue[n] = m;
+                  near[n].swap(here);
+                  if (++n == LOCAL_LANES) {
+                     definite &= Flush<K>(store, queue, near, n);
+                     n = 0;
+                  }
+               }
+            }
+            definite &= Flush<K>(store, queue, near, n);
+
+            if (!definite)
+               failed = true;
+         });
+
+         ok = !failed;
+         cache.lookups = store.Lookups();
+         cache.hits = store.Hits();
+      }
+   };
+
+   //--------------------------------------------------------------------------
+   // The eigendecomposition R = Q diag(lambda) Q' of the correlation matrix
+   // for one range, and the projections of the data onto the eigenvectors:
+   // a = Q'1, c = Q'z, and G = Rt Q, where Rt is the (M x N) matrix of
+   // target-observation correlations.
+   //--------------------------------------------------------------------------
+   struct Spectrum {
+      bool   valid;
+      Matrix lambda;
+      Matrix Q;
+      Matrix a;
+      Matrix c;
+      Matrix G;
+   };
+
+}
+
+//=============================================================================
+//
+//=============================================================================
+std::vector<ResultRecord> Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets )
+{
+   const int M = targets.size();
+   if (M < 1) {
+      throw NoTargetsSpecified("No targets were specified.");
+   }
+
+   const int N = obs.size();
+
+   // Large systems are solved iteratively.
+   if (N > MAXIMUM_COUNT)
+      return Iterative(nugget, sill, range, obs, targets);
+
+   CheckObservationCount(N);
+
+   // Factor the Ordinary Kriging system, and precompute v = C~1 and
+   // a = C~z.
+   PackedMatrix L;
+   Matrix va;
+   Factor(nugget, sill, range, obs, L, va);
+
+   Panel panel = { nugget, sill, range, obs, L, va, 0.0, 0.0 };
+   for (int n = 0; n < N; ++n) {
+      panel.sumv += va(n,0);
+      panel.vz   += va(n,1);
+   }
+
+   // Krige the targets in panels, in parallel.
+   std::vector<ResultRecord> results(M);
+
+   ParallelFor(0, (M + TARGET_PANEL - 1) / TARGET_PANEL, [&](int k) {
+      const int m = k*TARGET_PANEL;
+      panel.Predict( &targets[m], std::min(TARGET_PANEL, M - m), &results[m] );
+   });
+
+   return results;
+}
+
+//=============================================================================
+// Engine
+//
+//    Ordinary Kriging of several measured variables at once: the values
+//    are the P columns of Z, and every variable shares the observation
+//    locations and the semi-variogram.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observation locations; obs[n].z is ignored.
+//
+//    Z     the (N x P) matrix of observed values.
+//
+//    targets
+//          the target locations.
+//
+//    Zhat  on exit, the (M x P) matrix of estimates.
+//
+// Return:
+//
+//    The results as in Engine, for the first variable. The Kriging
+//    standard deviation depends only on the locations and the variogram,
+//    so it is the same for every variable.
+//
+// Notes:
+//
+// o  The covariance matrix is factored once. The Kriging weights of the
+//    targets are computed WEIGHT_BLOCK at a time into an (N x WEIGHT_BLOCK)
+//    matrix W, and each block is applied to all of the variables at once
+//    by one matrix product, Zhat = W'Z. P variables cost little more than
+//    one.
+//
+// o  Only the dense path is available: N <= 500.
+//=============================================================================
+std::vector<ResultRecord> Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   const Matrix& Z,
+   std::vector<TargetRecord> targets,
+   Matrix& Zhat )
+{
+   const int M = targets.size();
+   if (M < 1) {
+      throw NoTargetsSpecified("No targets were specified.");
+   }
+
+   const int N = obs.size();
+   CheckObservationCount(N);
+
+   assert( Z.nRows() == N && Z.nCols() > 0 );
+   const int P = Z.nCols();
+
+   // The first variable is the one kriged by Panel::Finish.
+   for (int n = 0; n < N; ++n)
+      obs[n].z = Z(n,0);
+
+   PackedMatrix L;
+   Matrix va;
+   Factor(nugget, sill, range, obs, L, va);
+
+   Panel panel = { nugget, sill, range, obs, L, va, 0.0, 0.0 };
+   for (int n = 0; n < N; ++n) {
+      panel.sumv += va(n,0);
+      panel.vz   += va(n,1);
+   }
+
+   // Krige the targets in blocks, in parallel.
+   std::vector<ResultRecord> results(M);
+   Zhat.ResizeUninitialized(M, P);
+
+   ParallelFor(0, (M + WEIGHT_BLOCK - 1) / WEIGHT_BLOCK, [&](int k) {
+      const int m = k*WEIGHT_BLOCK;
+      const int count = std::min(WEIGHT_BLOCK, M - m);
+
+      std::vector<double> W( static_cast<long>(N)*WEIGHT_BLOCK );
+      for (int t = 0; t < count; t += TARGET_PANEL)
+         panel.Weights( &targets[m+t], std::min(TARGET_PANEL, count - t), &W[t], WEIGHT_BLOCK, &results[m+t] );
+
+      // Serial, since the blocks are already shared among the threads.
+      Gemm( true, false, count, P, N, W.data(), WEIGHT_BLOCK, Z.Base(), P, Zhat.Base(m,0), P, false );
+   });
+
+   return results;
+}
+
+//=============================================================================
+// Weight_Engine
+//
+//    Compute the Ordinary Kriging weights of the targets, for saving and
+//    applying later to any values observed at the same locations.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observation locations; obs[n].z is ignored.
+//
+//    targets
+//          the target locations.
+//
+//    keep  the number of weights kept for each target; 0 keeps them all.
+//
+//    W     on exit, the weight operator.
+//
+// Notes:
+//
+// o  With 0 < keep < N, only the keep weights of largest magnitude are
+//    kept for each target, rescaled to sum to one so that the estimate
+//    stays unbiased. The Kriging standard deviation is still that of the
+//    full set of weights. If the kept weights of any target do not sum to
+//    a clearly positive value, the rescaling would be meaningless, and
+//    EstimationFailed is thrown; keep more weights.
+//
+// o  Only the dense path is available: N <= 500.
+//=============================================================================
+void Weight_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   int keep,
+   WeightOperator& W )
+{
+   const int M = targets.size();
+   if (M < 1) {
+      throw NoTargetsSpecified("No targets were specified.");
+   }
+
+   const int N = obs.size();
+   CheckObservationCount(N);
+
+   const int K = (keep < 1 || keep > N) ? N : keep;
+
+   PackedMatrix L;
+   Matrix va;
+   Factor(nugget, sill, range, obs, L, va);
+
+   Panel panel = { nugget, sill, range, obs, L, va, 0.0, 0.0 };
+   for (int n = 0; n < N; ++n)
+      panel.sumv += va(n,0);
+
+   W.Reset(obs, targets, K);
+   std::vector<int> failed(M, 0);
+
+   // Each panel of targets in parallel: the weights, then the largest.
+   ParallelFor(0, (M + TARGET_PANEL - 1) / TARGET_PANEL, [&](int k) {
+      const int m = k*TARGET_PANEL;
+      const int count = std::min(TARGET_PANEL, M - m);
+
+      std::vector<double> w( static_cast<long>(N)*TARGET_PANEL );
+      ResultRecord results[TARGET_PANEL];
+      panel.Weights( &targets[m], count, w.data(), TARGET_PANEL, results );
+
+      std::vector<int> col(N);
+      std::vector<double> value(K);
+      for (int p = 0; p < count; ++p) {
+         std::iota(col.begin(), col.end(), 0);
+         if (K < N) {
+            std::nth_element(col.begin(), col.begin()+K, col.end(), [&](int a, int b) {
+               return fabs(w[static_cast<long>(a)*TARGET_PANEL + p]) > fabs(w[static_cast<long>(b)*TARGET_PANEL + p]);
+            });
+            std::sort(col.begin(), col.begin()+K);
+         }
+
+         double sum = 0.0;
+         for (int j = 0; j < K; ++j) {
+            value[j] = w[static_cast<long>(col[j])*TARGET_PANEL + p];
+            sum += value[j];
+         }
+         if (K < N) {
+            if (!(sum > MIN_KEPT_SUM)) {
+               failed[m+p] = 1;
+               continue;
+            }
+            for (int j = 0; j < K; ++j)
+               value[j] /= sum;
+         }
+
+         W.SetRow(m+p, col.data(), value.data(), results[p].kstd);
+      }
+   });
+
+   for (int m = 0; m < M; ++m) {
+      if (failed[m]) {
+         std::stringstream message;
+         message << "The " << K << " largest weights of target " << m+1 << " do not sum to a positive value; keep more weights.";
+         throw EstimationFailed(message.str());
+      }
+   }
+}
+
+//=============================================================================
+// Indicator_Engine
+//
+//    Median indicator Kriging: the conditional cumulative distribution
+//    function (ccdf) of the value at each target, at the given thresholds.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential model of the median indicator semi-variogram.
+//
+//    obs   the observations.
+//
+//    thresholds
+//          the K thresholds, in increasing order.
+//
+//    targets
+//          the target locations.
+//
+//    F     on exit, the (M x K) matrix of the ccdf, F(m,k) = Prob[ Z <=
+//          thresholds[k] ] at target m.
+//
+// Return:
+//
+//    The results as in Engine, for the first threshold, before the order
+//    relations are corrected. The Kriging standard deviation is that of
+//    every indicator.
+//
+// Notes:
+//
+// o  Every indicator shares the median indicator semi-variogram, so every
+//    threshold shares the Kriging weights: the K indicator columns are
+//    kriged together by the multiple-variable Engine, at little more than
+//    the cost of one.
+//
+// o  The estimates are then corrected for order relation violations, so
+//    that each ccdf lies in [0,1] and is non-decreasing.
+//=============================================================================
+std::vector<ResultRecord> Indicator_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   const std::vector<double>& thresholds,
+   std::vector<TargetRecord> targets,
+   Matrix& F )
+{
+   const int N = obs.size();
+   const int K = thresholds.size();
+   assert( K > 0 && std::is_sorted(thresholds.begin(), thresholds.end()) );
+
+   // The indicator transform.
+   Matrix I(N, K);
+   for (int n = 0; n < N; ++n)
+      for (int k = 0; k < K; ++k)
+         I(n,k) = (obs[n].z <= thresholds[k]) ? 1.0 : 0.0;
+
+   std::vector<ResultRecord> results = Engine(nugget, sill, range, obs, I, targets, F);
+
+   const int M = F.nRows();
+   std::vector<double> up(K);
+   for (int m = 0; m < M; ++m)
+      OrderRelations( F.Base(m,0), K, up.data() );
+
+   return results;
+}
+
+//=============================================================================
+// Exceedance
+//
+//    The probabilities that the values at the targets exceed each of the
+//    thresholds, P(m,k) = Prob[ Z > thresholds[k] ], taking the Kriging
+//    error at target m to be Gaussian with mean 0 and standard deviation
+//    results[m].kstd.
+//
+// Notes:
+//
+// o  P(m,k) = GaussianCDF( (zhat - t)/kstd ), evaluated by the batch
+//    GaussianCDF, PROBABILITY_BLOCK targets at a time, in parallel.
+//=============================================================================
+void Exceedance(
+   const std::vector<ResultRecord>& results,
+   const std::vector<double>& thresholds,
+   Matrix& P )
+{
+   const int M = results.size();
+   const int K = thresholds.size();
+   P.ResizeUninitialized(M, K);
+
+   ParallelFor(0, (M + PROBABILITY_BLOCK - 1) / PROBABILITY_BLOCK, [&](int b) {
+      const int m0 = b*PROBABILITY_BLOCK;
+      const int count = std::min(PROBABILITY_BLOCK, M - m0);
+
+      double x[PROBABILITY_BLOCK], p[PROBABILITY_BLOCK];
+      for (int k = 0; k < K; ++k) {
+         for (int i = 0; i < count; ++i)
+            x[i] = (results[m0+i].zhat - thresholds[k]) / results[m0+i].kstd;
+         GaussianCDF(x, p, count);
+         for (int i = 0; i < count; ++i)
+            P(m0+i,k) = p[i];
+      }
+   });
+}
+
+//=============================================================================
+// Quantiles
+//
+//    The quantiles of the values at the targets, Q(m,k) = zhat + kstd *
+//    GaussianCDFInv(probabilities[k]), taking the Kriging error to be
+//    Gaussian as in Exceedance. Each probability must satisfy 0 < p < 1.
+//=============================================================================
+void Quantiles(
+   const std::vector<ResultRecord>& results,
+   const std::vector<double>& probabilities,
+   Matrix& Q )
+{
+   const int M = results.size();
+   const int K = probabilities.size();
+
+   std::vector<double> z(K);
+   GaussianCDFInv(probabilities.data(), z.data(), K);
+
+   Q.ResizeUninitialized(M, K);
+   for (int m = 0; m < M; ++m)
+      for (int k = 0; k < K; ++k)
+         Q(m,k) = results[m].zhat + results[m].kstd * z[k];
+}
+
+//=============================================================================
+// Aakozi_Engine
+//
+//    Identify the outliers in the observations using the leave-one-out
+//    (boomerang) Ordinary Kriging statistics. The worst outlier is removed
+//    and the statistics are recomputed, until the worst remaining zscore is
+//    no longer significant at the specified level.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observations.
+//
+//    alpha the two-sided significance level, 0 < alpha < 1.
+//
+// Return:
+//
+//    The outliers in the order in which they were removed. The index refers
+//    to the position in obs, and zhat and zscore are the leave-one-out
+//    estimate and standardized residual at the time of removal.
+//
+// Notes:
+//
+// o  Let v = C~1 and P = C~ - vv'/(1'v). The leave-one-out residual and
+//    Kriging variance at observation i are (Dubrule, 1983)
+//
+//       z(i) - zhat(i) = (Pz)(i) / P(i,i)
+//       kvar(i)        = 1 / P(i,i)
+//
+//    so all N statistics are available from a single inverse.
+//
+// o  Removing observation i downdates the inverse in place,
+//
+//       C~(j,k) -= C~(j,i) C~(i,k) / C~(i,i)
+//
+//    which costs O(N^2) rather than an O(N^3) refactorization. The row and
+//    column of a removed observation are zeroed, so they drop out of all
+//    subsequent sums.
+//
+// o  The remaining observations are always tested, but once only the
+//    minimum number remain, a significant outlier is reported without
+//    being removed, and the search stops.
+//
+// References:
+//
+// o  Dubrule, O., 1983, Cross validation of kriging in a unique
+//    neighborhood, Mathematical Geology, v. 15, n. 6, p. 687-699.
+//=============================================================================
+std::vector<Outlier> Aakozi_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   double alpha )
+{
+   assert( alpha > 0 && alpha < 1 );
+
+   const int N = obs.size();
+   CheckObservationCount(N);
+
+   // Create the matrix of observed values.
+   Matrix Z(N, 1);
+   for (int n = 0; n < N; ++n)
+      Z(n,0) = obs[n].z;
+
+   // Compute the inverse of the covariance matrix, in place.
+   PackedMatrix Cinv;
+   Covariance(nugget, sill, range, obs, Cinv);
+
+   if (!CholeskyDecomposition(Cinv,Cinv)) {
+      throw CholeskyDecompositionFailed("Cholesky decomposition of the Kriging system failed.");
+   }
+   CholeskyInverse(Cinv, Cinv);
+
+   // The critical value of the two-sided test.
+   const double zcrit = GaussianCDFInv(1.0 - alpha/2.0);
+
+   // Remove the outliers one at a time.
+   std::vector<int> active(N, 1);
+   int nActive = N;
+
+   std::vector<Outlier> outliers;
+
+   for (;;) {
+      Matrix resid, kvar;
+      LeaveOneOut(Cinv, Z, resid, kvar);
+
+      // Find the worst of the remaining observations.
+      Outlier worst = { -1, 0.0, 0.0 };
+
+      for (int n = 0; n < N; ++n) {
+         if (!active[n]) continue;
+
+         double zscore = resid(n,0) / sqrt(kvar(n,0));
+
+         if (worst.index < 0 || fabs(zscore) > fabs(worst.zscore)) {
+            worst.index  = n;
+            worst.zhat   = Z(n,0) - resid(n,0);
+            worst.zscore = zscore;
+         }
+      }
+
+      if (fabs(worst.zscore) <= zcrit) break;
+      outliers.push_back(worst);
+
+      // Removing it would leave too few observations to test the rest.
+      if (nActive <= MINIMUM_COUNT) break;
+
+      // Downdate the inverse to remove the outlier. Only the lower triangle
+      // is stored.
+      const int i = worst.index;
+      Matrix c(N, 1);
+      for (int n = 0; n < N; ++n)
+         c(n,0) = (n >= i) ? Cinv(n,i) : Cinv(i,n);
+
+      for (int j = 0; j < N; ++j) {
+         double a = c(j,0) / c(i,0);
+         double* row = Cinv.Base(j);
+         for (int k = 0; k <= j; ++k)
+            row[k] -= a * c(k,0);
+      }
+
+      for (int n = 0; n < N; ++n) {
+         if (n >= i)
+            Cinv(n,i) = 0.0;
+         else
+            Cinv(i,n) = 0.0;
+      }
+
+      active[i] = 0;
+      --nActive;
+   }
+
+   return outliers;
+}
+
+//=============================================================================
+// Sweep_Engine
+//
+//    Run the Ordinary Kriging for each of the semi-variogram parameter sets,
+//    and score each set using leave-one-out cross validation.
+//
+// Arguments:
+//
+//    params   the semi-variogram parameter sets.
+//
+//    obs      the observations.
+//
+//    targets  the target locations.
+//
+// Return:
+//
+//    One SweepRecord for each parameter set, in the order given.
+//
+// Notes:
+//
+// o  The observation-observation and target-observation separation
+//    distances are computed once and shared by all of the parameter sets.
+//
+// o  The parameter sets are independent, and they are evaluated in parallel.
+//
+// o  The covariance matrix is C = (sill-nugget) R + nugget I, where R is the
+//    correlation matrix, which depends only on the range. When two or more
+//    parameter sets share a range, R = Q diag(lambda) Q' is computed once
+//    using SymmetricEigen, and then
+//
+//       C~ = Q diag( 1/((sill-nugget) lambda + nugget) ) Q'
+//
+//    for every set in the group. With the projections Q'1, Q'z and Q'r
+//    precomputed, each additional set costs O(N^2) for the cross validation
+//    and O(N) per target, instead of a fresh O(N^3) factorization.
+//
+// o  The cross validation scores are computed from the leave-one-out
+//    residuals e(i) = z(i) - zhat(i) and variances kvar(i):
+//
+//       me   = mean of e(i)
+//       rmse = sqrt of the mean of e(i)^2
+//       msse = mean of e(i)^2 / kvar(i)
+//
+//    A well-calibrated model has me near 0 and msse near 1.
+//=============================================================================
+std::vector<SweepRecord> Sweep_Engine(
+   std::vector<ParamsRecord> params,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets )
+{
+   const int P = params.size();
+   if (P < 1) {
+      throw NoParametersSpecified("No semi-variogram parameter sets were specified.");
+   }
+
+   const int M = targets.size();
+   if (M < 1) {
+      throw NoTargetsSpecified("No targets were specified.");
+   }
+
+   const int N = obs.size();
+   CheckObservationCount(N);
+
+   // Create the matrix of observed values.
+   Matrix Z(N, 1);
+   for (int n = 0; n < N; ++n)
+      Z(n,0) = obs[n].z;
+
+   // Compute all of the separation distances once.
+   PackedMatrix Dobs(N);
+   for (int i = 0; i < N; ++i)
+      for (int j = 0; j < i; ++j)
+         Dobs(i,j) = hypot( obs[i].x-obs[j].x, obs[i].y-obs[j].y );
+
+   Matrix Dtgt(M, N);
+   for (int m = 0; m < M; ++m)
+      for (int n = 0; n < N; ++n)
+         Dtgt(m,n) = hypot( targets[m].x-obs[n].x, targets[m].y-obs[n].y );
+
+   // Group the parameter sets that share a range.
+   std::vector<double> ranges;
+   std::vector<int> group(P);
+   std::vector<int> count;
+
+   for (int p = 0; p < P; ++p) {
+      unsigned g = std::find(ranges.begin(), ranges.end(), params[p].range) - ranges.begin();
+      if (g == ranges.size()) {
+         ranges.push_back(params[p].range);
+         count.push_back(0);
+      }
+      group[p] = g;
+      ++count[g];
+   }
+
+   // Compute one eigendecomposition for each range that is shared.
+   std::vector<Spectrum> spectra(ranges.size());
+
+   ParallelFor(0, ranges.size(), [&](int g) {
+      Spectrum& S = spectra[g];
+      S.valid = false;
+      if (count[g] < 2) return;
+
+      Matrix R(N, N, 1.0);
+      for (int i = 0; i < N; ++i)
+         for (int j = 0; j < i; ++j)
+            R(i,j) = exp(-3.0*Dobs(i,j)/ranges[g]);
+
+      if (!SymmetricEigen(R, S.lambda, S.Q)) return;
+
+      Matrix Ct;
+      ColumnSum(S.Q, Ct);
+      Transpose(Ct, S.a);
+      Multiply_MtM(S.Q, Z, S.c);
+
+      Matrix Rt(M, N);
+      for (int m = 0; m < M; ++m)
+         for (int n = 0; n < N; ++n)
+            Rt(m,n) = exp(-3.0*Dtgt(m,n)/ranges[g]);
+      Multiply_MM(Rt, S.Q, S.G);
+
+      S.valid = true;
+   });
+
+   // Evaluate the parameter sets in parallel.
+   std::vector<SweepRecord> sweep(P);
+   std::vector<int> failed(P, 0);
+
+   ParallelFor(0, P, [&](int p) {
+      const double nugget = params[p].nugget;
+      const double sill   = params[p].sill;
+      const double range  = params[p].range;
+
+      sweep[p].params = params[p];
+      sweep[p].results.resize(M);
+
+      const Spectrum& S = spectra[group[p]];
+
+      if (S.valid) {
+         // C = (sill-nugget) R + nugget I = Q diag(s~) Q', so every solve
+         // with C costs O(N^2), and every target costs O(N).
+         const double psill = sill - nugget;
+
+         Matrix s(N, 1);
+         for (int k = 0; k < N; ++k) {
+            double dk = psill*S.lambda(k,0) + nugget;
+            if (dk < MIN_EIGENVALUE) {
+               failed[p] = 1;
+               return;
+            }
+            s(k,0) = 1.0/dk;
+         }
+
+         // Score the parameter set using leave-one-out cross validation.
+         Matrix diag(N, 1), v(N, 1), Cz(N, 1);
+         for (int i = 0; i < N; ++i) {
+            const double* q = S.Q.Base(i,0);
+            double di = 0.0, vi = 0.0, ci = 0.0;
+            for (int k = 0; k < N; ++k) {
+               di += q[k]*q[k]*s(k,0);
+               vi += q[k]*S.a(k,0)*s(k,0);
+               ci += q[k]*S.c(k,0)*s(k,0);
+            }
+            diag(i,0) = di;
+            v(i,0)    = vi;
+            Cz(i,0)   = ci;
+         }
+
+         Matrix resid, kvar;
+         LeaveOneOut(diag, v, Cz, Z, resid, kvar);
+         Score(resid, kvar, sweep[p]);
+
+         // Krige the targets.
+         double sumv = 0.0, vz = 0.0;
+         for (int k = 0; k < N; ++k) {
+            sumv += S.a(k,0)*S.a(k,0)*s(k,0);
+            vz   += S.a(k,0)*S.c(k,0)*s(k,0);
+         }
+
+         for (int m = 0; m < M; ++m) {
+            const double* g = S.G.Base(m,0);
+            double onesu = 0.0, uz = 0.0, bu = 0.0;
+            for (int k = 0; k < N; ++k) {
+               onesu += g[k]*S.a(k,0)*s(k,0);
+               uz    += g[k]*S.c(k,0)*s(k,0);
+               bu    += g[k]*g[k]*s(k,0);
+            }
+            onesu *= psill;
+            uz    *= psill;
+            bu    *= psill*psill;
+
+            double lambda = (onesu - 1) / sumv;
+
+            ResultRecord& r = sweep[p].results[m];
+            r.id   = targets[m].id;
+            r.x    = targets[m].x;
+            r.y    = targets[m].y;
+            r.zhat = uz - lambda*vz;
+            r.kstd = sqrt( sill - (bu - lambda*onesu) - lambda );
+         }
+         return;
+      }
+
+      // Create and factor the covariance matrix for all of the
+      // observations.
+      PackedMatrix L(N);
+      for (int i = 0; i < N; ++i) {
+         for (int j = 0; j < i; ++j)
+            L(i,j) = (sill-nugget)*exp(-3.0*Dobs(i,j)/range);
+         L(i,i) = sill;
+      }
+
+      if (!CholeskyDecomposition(L,L)) {
+         failed[p] = 1;
+         return;
+      }
+
+      PackedMatrix Cinv;
+      CholeskyInverse(L, Cinv);
+
+      // Score the parameter set using leave-one-out cross validation.
+      Matrix resid, kvar;
+      LeaveOneOut(Cinv, Z, resid, kvar);
+      Score(resid, kvar, sweep[p]);
+
+      // Krige the targets.
+      Matrix ones(N, 1, 1.0);
+      Matrix v;
+      Multiply_SM(Cinv, ones, v);
+      double sumv = Sum(v);
+
+      for (int m = 0; m < M; ++m) {
+         Matrix b(N,1);
+         for (int n = 0; n < N; ++n)
+            b(n,0) = (sill - nugget) * exp(-3.0 * Dtgt(m,n) / range);
+
+         ResultRecord& r = sweep[p].results[m];
+         r.id = targets[m].id;
+         r.x  = targets[m].x;
+         r.y  = targets[m].y;
+         Matrix u;
+         CholeskySolve(L,b,u);
+         Predict(sill, u, v, sumv, Z, b, r.zhat, r.kstd);
+      }
+   });
+
+   for (int p = 0; p < P; ++p) {
+      if (failed[p]) {
+         std::stringstream message;
+         message << "Cholesky decomposition of the Kriging system failed for parameter set " << p+1 << ".";
+         throw CholeskyDecompositionFailed(message.str());
+      }
+   }
+
+   return sweep;
+}
 
 //=============================================================================
+// Estimate_Engine
+//
+//    Estimate the exponential semi-variogram parameters by maximizing the
+//    Gaussian likelihood, or restricted likelihood, of the observations.
+//
+// Arguments:
+//
+//    obs   the observations.
+//
+//    reml  if true, maximize the restricted (REML) likelihood; otherwise,
+//          maximize the full (ML) likelihood.
+//
+// Return:
+//
+//    The estimated nugget, sill, and range, with the maximized log
+//    likelihood and the number of iterations.
 //
+// Notes:
+//
+// o  The search is carried out over t = log(nugget), log(sill-nugget),
+//    log(range), which keeps the parameters positive and the sill above
+//    the nugget. The search starts from nugget = var(z)/10,
+//    sill = var(z), and range = 1/3 of the diagonal of the bounding box.
+//
+// o  The optimizer is a quasi-Newton (BFGS) method with the analytic
+//    gradient from NegativeLogLikelihood, and a backtracking line search
+//    satisfying the Armijo condition. See Nocedal and Wright (2006),
+//    Algorithm 6.1. The parameters are kept inside a wide box so that a
+//    vanishing nugget or an unbounded range cannot stall the search.
+//
+// o  Each iteration typically costs one Cholesky decomposition and one
+//    inverse; both are computed in parallel for large N.
+//
+// References:
+//
+// o  Nocedal, J., and Wright, S.J., 2006, Numerical Optimization, 2nd
+//    Edition, Springer, New York, 664 pp.
 //=============================================================================
-std::vector<ResultRecord> Engine(
+EstimateRecord Estimate_Engine(
+   std::vector<ObsRecord> obs,
+   bool reml )
+{
+   const int N = obs.size();
+   CheckObservationCount(N, MAXIMUM_ESTIMATE_COUNT);
+
+   // The sample variance and the size of the domain set the scales.
+   double mean = 0.0;
+   for (int n = 0; n < N; ++n)
+      mean += obs[n].z / N;
+
+   double var = 0.0;
+   for (int n = 0; n < N; ++n)
+      var += (obs[n].z - mean)*(obs[n].z - mean) / (N-1);
+
+   double xmin = obs[0].x, xmax = obs[0].x;
+   double ymin = obs[0].y, ymax = obs[0].y;
+   for (int n = 1; n < N; ++n) {
+      xmin = std::min(xmin, obs[n].x);
+      xmax = std::max(xmax, obs[n].x);
+      ymin = std::min(ymin, obs[n].y);
+      ymax = std::max(ymax, obs[n].y);
+   }
+   double diagonal = hypot(xmax-xmin, ymax-ymin);
+
+   if (var <= 0.0 || diagonal <= 0.0) {
+      throw EstimationFailed("The observations do not vary in value and location.");
+   }
+
+   // The search box, in the log parameters.
+   const double lower[3] = { log(1e-6*var), log(1e-6*var), log(1e-3*diagonal) };
+   const double upper[3] = { log(1e+3*var), log(1e+3*var), log(1e+2*diagonal) };
+
+   auto evaluate = [&](const Matrix& t, double& f, Matrix* g) {
+      double nugget = exp(t(0,0));
+      double sill   = nugget + exp(t(1,0));
+      double range  = exp(t(2,0));
+      if (g == nullptr)
+         return NegativeLogLikelihood(obs, nugget, sill, range, reml, f);
+      else
+         return NegativeLogLikelihood(obs, nugget, sill, range, reml, f, *g);
+   };
+
+   // The starting point.
+   Matrix t(3, 1);
+   t(0,0) = log(0.1*var);
+   t(1,0) = log(0.9*var);
+   t(2,0) = log(diagonal/3.0);
+
+   double f;
+   Matrix g;
+   if (!evaluate(t, f, &g)) {
+      throw EstimationFailed("The covariance matrix at the starting point is not positive definite.");
+   }
+
+   // BFGS iterations, with H approximating the inverse Hessian.
+   Matrix H;
+   Identity(H, 3);
+
+   int iter = 0;
+   while (iter < MAXIMUM_ITERATIONS) {
+      ++iter;
+
+      // The search direction, limited in length.
+      Matrix Hg;
+      Multiply_MM(H, g, Hg);
+      Matrix p = -Hg;
+
+      double slope = DotProduct(g, p);
+      if (slope >= 0.0) {
+         Identity(H, 3);
+         p = -g;
+         slope = DotProduct(g, p);
+      }
+
+      double pmax = MaxAbs(p);
+      if (pmax > MAXIMUM_STEP) {
+         p = (MAXIMUM_STEP/pmax) * p;
+         slope *= MAXIMUM_STEP/pmax;
+      }
+
+      // Backtracking line search; the full step is tried with the gradient.
+      Matrix tnew(3, 1), gnew;
+      double fnew = 0.0;
+      double step = 1.0;
+      bool accepted = false;
+      bool gradient = false;
+
+      while (step > 1e-10) {
+         for (int i = 0; i < 3; ++i)
+            tnew(i,0) = std::min(upper[i], std::max(lower[i], t(i,0) + step*p(i,0)));
+
+         gradient = (step >= 1.0);
+         bool ok = evaluate(tnew, fnew, gradient ? &gnew : nullptr);
+         if (ok && fnew <= f + 1e-4*step*slope) {
+            accepted = true;
+            break;
+         }
+         step /= 2;
+      }
+      if (!accepted) break;
+
+      if (!gradient) evaluate(tnew, fnew, &gnew);
+
+      // Update the inverse Hessian approximation.
+      Matrix s = tnew - t;
+      Matrix y = gnew - g;
+      double sy = DotProduct(s, y);
+
+      if (sy > 1e-12) {
+         Matrix Hy;
+         Multiply_MM(H, y, Hy);
+         double yHy = DotProduct(y, Hy);
+
+         for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+               H(i,j) += ( (sy + yHy)*s(i,0)*s(j,0)/sy - Hy(i,0)*s(j,0) - s(i,0)*Hy(j,0) ) / sy;
+      }
+
+      double fold = f;
+      t = tnew;
+      f = fnew;
+      g = gnew;
+
+      if (fabs(fold - f) < FUNCTION_TOLERANCE*(1.0 + fabs(f))) break;
+      if (MaxAbs(g) < GRADIENT_TOLERANCE*(1.0 + fabs(f))) break;
+   }
+
+   EstimateRecord estimate;
+   estimate.params.nugget = exp(t(0,0));
+   estimate.params.sill   = exp(t(0,0)) + exp(t(1,0));
+   estimate.params.range  = exp(t(2,0));
+   estimate.loglik        = -f;
+   estimate.iterations    = iter;
+
+   return estimate;
+}
+
+//=============================================================================
+// Hierarchical_Engine
+//
+//    Ordinary Kriging using all of the observations, with the covariance
+//    matrix held as a hierarchical (HODLR) matrix rather than a dense one.
+//    This allows global Kriging with far more observations than Engine.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observations.
+//
+//    targets
+//          the target locations.
+//
+//    tolerance
+//          the relative accuracy of the low-rank blocks, e.g. 1e-8. The
+//          results agree with Engine to roughly tolerance times the
+//          condition number of the covariance matrix.
+//
+// Return:
+//
+//    The estimate and standard deviation at each target, as in Engine.
+//
+// Notes:
+//
+// o  The HMatrix is factored once, and every target then costs one
+//    O(N k log N) solve for a typical block rank k. The targets are kriged
+//    in parallel.
+//=============================================================================
+std::vector<ResultRecord> Hierarchical_Engine(
    double nugget,
    double sill,
    double range,
    std::vector<ObsRecord> obs,
-   std::vector<TargetRecord> targets )
+   std::vector<TargetRecord> targets,
+   double tolerance )
 {
-   // Manifest constants.
-   const int MINIMUM_COUNT = 10;
-   const int MAXIMUM_COUNT = 500;
+   assert( tolerance > 0 && tolerance < 1 );
+
+   const int M = targets.size();
+   if (M < 1) {
+      throw NoTargetsSpecified("No targets were specified.");
+   }
+
+   const int N = obs.size();
+   CheckObservationCount(N, MAXIMUM_HMATRIX_COUNT);
+
+   // Create the matrix of observed values.
+   Matrix Z(N, 1);
+   for (int n = 0; n < N; ++n)
+      Z(n,0) = obs[n].z;
+
+   // Compress and factor the covariance matrix.
+   HMatrix C(nugget, sill, range, obs, tolerance);
+   if (!C.Factor()) {
+      throw CholeskyDecompositionFailed("Factorization of the hierarchical Kriging system failed.");
+   }
+
+   // Precompute the v matrix.
+   Matrix ones(N, 1, 1.0);
+   Matrix v;
+   C.Solve(ones, v);
+   double sumv = Sum(v);
+
+   // Krige the targets in parallel.
+   std::vector<ResultRecord> results(M);
+
+   ParallelFor(0, M, [&](int m) {
+      Matrix b(N,1);
+      for (int n = 0; n < N; ++n) {
+         double h = hypot(targets[m].x - obs[n].x, targets[m].y - obs[n].y);
+         b(n,0) = (sill - nugget) * exp(-3.0 * h / range);
+      }
+
+      Matrix u;
+      C.Solve(b, u);
+
+      results[m].id = targets[m].id;
+      results[m].x  = targets[m].x;
+      results[m].y  = targets[m].y;
+      Predict(sill, u, v, sumv, Z, b, results[m].zhat, results[m].kstd);
+   });
+
+   return results;
+}
+
+//=============================================================================
+// Tapered_Engine
+//
+//    Ordinary Kriging using all of the observations, with the covariance
+//    tapered to zero beyond a given distance so that the Kriging system is
+//    sparse.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observations.
+//
+//    targets
+//          the target locations.
+//
+//    taper the taper range; covariances between locations farther apart
+//          are set to zero.
+//
+// Return:
+//
+//    The estimate and standard deviation at each target, as in Engine.
+//
+// Notes:
+//
+// o  The tapered covariance is C(h) W(h/taper), where W is the Wendland
+//    taper. It is used both for the covariance matrix and for the
+//    covariance vectors of the targets ("one-taper" Kriging). The taper
+//    range should be several times the practical range of the variogram's
+//    short-range structure, but may be much less than the extent of the
+//    data; see Furrer et al. (2006).
+//
+// o  The observations are put in a nested dissection order, and the
+//    sparse covariance matrix is factored by a sparse Cholesky
+//    decomposition. Each target then costs one sparse solve, and the
+//    targets are kriged in parallel.
+//
+// References:
+//
+// o  Furrer, R., Genton, M.G., and Nychka, D., 2006, Covariance tapering
+//    for interpolation of large spatial datasets, Journal of Computational
+//    and Graphical Statistics, v. 15, n. 3, p. 502-523.
+//=============================================================================
+std::vector<ResultRecord> Tapered_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   double taper )
+{
+   assert( taper > 0 );
 
    const int M = targets.size();
    if (M < 1) {
@@ -42,77 +1930,376 @@ std::vector<ResultRecord> Engine(
    }
 
    const int N = obs.size();
+   CheckObservationCount(N, MAXIMUM_TAPER_COUNT);
+
+   auto covariance = [&](double h) {
+      return (sill - nugget) * exp(-3.0 * h / range) * Wendland(h / taper);
+   };
+
+   // Compute the fill-reducing order, and its inverse.
+   std::vector<int> perm, iperm(N);
+   NestedDissection(obs, taper, perm);
+   for (int k = 0; k < N; ++k)
+      iperm[perm[k]] = k;
+
+   // Assemble the lower triangle of the tapered covariance matrix.
+   Grid grid(obs, taper);
+   SparseMatrix C;
+   std::vector<int> near;
+   std::vector< std::pair<int,double> > row;
+
+   for (int k = 0; k < N; ++k) {
+      const ObsRecord& a = obs[perm[k]];
+      grid.Near(a.x, a.y, near);
+
+      row.clear();
+      for (unsigned q = 0; q < near.size(); ++q) {
+         int j = iperm[near[q]];
+         if (j > k) continue;
 
-   if (N < MINIMUM_COUNT) {
-      std::stringstream message;
-      message << "There must be at least " << MINIMUM_COUNT << " observations.";
-      throw TooFewObservations(message.str());
+         double h = hypot(a.x - obs[near[q]].x, a.y - obs[near[q]].y);
+         if (j == k)
+            row.push_back( std::make_pair(j, sill) );
+         else if (h < taper)
+            row.push_back( std::make_pair(j, covariance(h)) );
+      }
+
+      std::sort(row.begin(), row.end());
+      for (unsigned q = 0; q < row.size(); ++q)
+         C.Append(row[q].first, row[q].second);
+      C.EndRow();
+   }
+
+   // Factor the tapered covariance matrix.
+   SparseCholesky L;
+   if (!L.Factor(C)) {
+      throw CholeskyDecompositionFailed("Cholesky decomposition of the tapered Kriging system failed.");
    }
 
-   if (N > MAXIMUM_COUNT) {
-      std::stringstream message;
-      message << "There must be no more than " << MAXIMUM_COUNT << " observations.";
-      throw TooManyObservations(message.str());
+   // The observed values, and v = C~1, in the new order.
+   Matrix Z(N, 1);
+   for (int k = 0; k < N; ++k)
+      Z(k,0) = obs[perm[k]].z;
+
+   Matrix ones(N, 1, 1.0);
+   Matrix v;
+   L.Solve(ones, v);
+   double sumv = Sum(v);
+
+   // Krige the targets in parallel.
+   std::vector<ResultRecord> results(M);
+
+   ParallelFor(0, M, [&](int m) {
+      std::vector<int> near;
+      grid.Near(targets[m].x, targets[m].y, near);
+
+      Matrix b(N, 1, 0.0);
+      for (unsigned q = 0; q < near.size(); ++q) {
+         double h = hypot(targets[m].x - obs[near[q]].x, targets[m].y - obs[near[q]].y);
+         if (h < taper)
+            b(iperm[near[q]],0) = covariance(h);
+      }
+
+      Matrix u;
+      L.Solve(b, u);
+
+      results[m].id = targets[m].id;
+      results[m].x  = targets[m].x;
+      results[m].y  = targets[m].y;
+      Predict(sill, u, v, sumv, Z, b, results[m].zhat, results[m].kstd);
+   });
+
+   return results;
+}
+
+//=============================================================================
+// Mixed_Engine
+//
+//    Ordinary Kriging as in Engine, with the Kriging system factored and
+//    solved in single precision, and the solutions refined to double
+//    precision accuracy.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observations.
+//
+//    targets
+//          the target locations.
+//
+//    tolerance
+//          the relative residual required of every solution, e.g. 1e-10.
+//          The results agree with Engine to roughly tolerance times the
+//          condition number of the covariance matrix.
+//
+// Return:
+//
+//    The estimate and standard deviation at each target, as in Engine.
+//
+// Notes:
+//
+// o  The single precision factor takes half the memory of a double
+//    precision factor, and each triangular solve moves half the bytes.
+//    The residuals are computed against the double precision covariance
+//    matrix; see MixedCholesky::Refine.
+//
+// o  The single precision factorization is two to three times faster than
+//    the double precision one, but a refined solution costs about three
+//    double precision solutions. This pays off when the factorization
+//    dominates: roughly, fewer than N/10 targets.
+//
+// o  The targets are solved in batches of TARGET_BATCH right hand sides,
+//    so each pass through the factor and the covariance matrix serves
+//    many targets. The batches are solved in parallel.
+//
+// o  If the single precision decomposition fails, or the refinement does
+//    not converge, the covariance matrix is factored in double precision,
+//    in place, and the affected targets are solved exactly as in Engine.
+//=============================================================================
+std::vector<ResultRecord> Mixed_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   double tolerance )
+{
+   assert( tolerance > 0 && tolerance < 1 );
+
+   const int M = targets.size();
+   if (M < 1) {
+      throw NoTargetsSpecified("No targets were specified.");
    }
 
+   const int N = obs.size();
+   CheckObservationCount(N, MAXIMUM_MIXED_COUNT);
+
    // Create the matrix of observed values.
    Matrix Z(N, 1);
    for (int n = 0; n < N; ++n)
       Z(n,0) = obs[n].z;
 
-   // Create the covariance matrix for all of the observations.
-   Matrix C(N, N, sill);
-   for (int i = 0; i < N-1; ++i) {
-      for (int j = i+1; j < N; ++j) {
-         double h = hypot( obs[i].x-obs[j].x, obs[i].y-obs[j].y );
-         C(i,j) = (sill-nugget)*exp(-3.0*h/range);
-         C(j,i) = C(i,j);
+   // Create the covariance matrix, and factor it in single precision.
+   PackedMatrix C;
+   Covariance(nugget, sill, range, obs, C);
+
+   MixedCholesky F;
+   bool mixed = F.Factor(C);
+   bool exact = false;
+
+   // The double precision fallback: once it is taken, C holds its own
+   // Cholesky decomposition. It is needed whether the single precision
+   // decomposition failed or the refinement did not converge.
+   auto fallback = [&]() {
+      mixed = false;
+      if (exact) return;
+      if (!CholeskyDecomposition(C,C)) {
+         throw CholeskyDecompositionFailed("Cholesky decomposition of the Kriging system failed.");
       }
-   }
+      exact = true;
+   };
 
-   // Solve the Ordinary Kriging system.
-   Matrix L;
-   if (!CholeskyDecomposition(C,L)) {
-      throw CholeskyDecompositionFailed("Cholesky decomposition of the Kriging system failed.");
-   }
+   // Solve one set of right hand sides, refined or exact.
+   auto solve = [&](const Matrix& b, Matrix& x) {
+      int iterations;
+      if (mixed) return F.Refine(C, b, x, tolerance, iterations);
+      assert( exact );
+      CholeskySolve(C, b, x);
+      return true;
+   };
 
    // Precompute the v matrix.
    Matrix ones(N, 1, 1.0);
    Matrix v;
-   CholeskySolve(L,ones,v);
+   if (!mixed || !solve(ones, v)) {
+      fallback();
+      solve(ones, v);
+   }
    double sumv = Sum(v);
 
-   // Pass through the set of observations one at a time.
+   // Krige one batch of targets.
    std::vector<ResultRecord> results(M);
 
-   for (int m = 0; m < M; ++m) {
-      // Setup the Ordinary Kriging right-hand-side.
-      Matrix b(N,1);
+   auto krige = [&](int batch) {
+      const int m0 = batch*TARGET_BATCH;
+      const int R = std::min(TARGET_BATCH, M - m0);
+
+      Matrix B(N, R);
       for (int n = 0; n < N; ++n) {
-         double h = hypot(targets[m].x - obs[n].x, targets[m].y - obs[n].y);
-         b(n,0) = (sill - nugget) * exp(-3.0 * h / range);
+         for (int r = 0; r < R; ++r) {
+            double h = hypot(targets[m0+r].x - obs[n].x, targets[m0+r].y - obs[n].y);
+            B(n,r) = (sill - nugget) * exp(-3.0 * h / range);
+         }
       }
 
-      // Solve the Ordinary Kriging system.
-      Matrix u;
-      CholeskySolve(L,b,u);
+      Matrix U;
+      if (!solve(B, U)) return false;
 
-      double lambda = (Sum(u) - 1) / sumv;
+      for (int r = 0; r < R; ++r) {
+         Matrix b(N,1), u(N,1);
+         for (int n = 0; n < N; ++n) {
+            b(n,0) = B(n,r);
+            u(n,0) = U(n,r);
+         }
 
-      Matrix lv;
-      Multiply_aM(lambda, v, lv);
+         ResultRecord& result = results[m0+r];
+         result.id = targets[m0+r].id;
+         result.x  = targets[m0+r].x;
+         result.y  = targets[m0+r].y;
+         Predict(sill, u, v, sumv, Z, b, result.zhat, result.kstd);
+      }
+      return true;
+   };
 
-      Matrix w;
-      Subtract_MM(u, lv, w);
+   // Krige the batches in parallel, then redo any batch whose refinement
+   // failed in double precision.
+   const int nBatches = (M + TARGET_BATCH - 1) / TARGET_BATCH;
+   std::vector<int> done(nBatches, 0);
 
-      double zhat = DotProduct(w, Z);
-      double kstd = sqrt( sill - DotProduct(b, w) - lambda );
+   ParallelFor(0, nBatches, [&](int k) {
+      done[k] = krige(k);
+   });
 
-      results[m].id   = targets[m].id;
-      results[m].x    = targets[m].x;
-      results[m].y    = targets[m].y;
-      results[m].zhat = zhat;
-      results[m].kstd = kstd;
+   for (int k = 0; k < nBatches; ++k) {
+      if (done[k]) continue;
+      fallback();
+      krige(k);
    }
+
    return results;
 }
+
+//=============================================================================
+// Local_Engine
+//
+//    Ordinary Kriging of each target from its nearest observations only.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observations.
+//
+//    targets
+//          the target locations.
+//
+//    neighbors
+//          the number of nearest observations used for each target,
+//          1 <= neighbors <= MAXIMUM_NEIGHBORS.
+//
+//    cache the neighborhood cache statistics, on return; may be null.
+//
+// Return:
+//
+//    The estimate and standard deviation at each target, as in Engine.
+//
+// Notes:
+//
+// o  Each target has its own small Kriging system, so there is no global
+//    factorization at all, and the work is O(M k^3) for M targets and k
+//    neighbors, whatever the number of observations.
+//
+// o  The neighbors are found on a uniform grid whose cells hold about k
+//    observations on average.
+//
+// o  The observations and the targets are first put in Hilbert curve
+//    order, so that consecutive targets are near one another and their
+//    neighbors are near one another in memory. The blocks of targets are
+//    then compact regions, whose targets share neighborhoods in the
+//    cache below. The results are returned in the input order.
+//
+// o  The local systems are sized at compile time by FixedDispatch, so a
+//    target costs no heap allocation and no dynamic loop bounds: only the
+//    arithmetic.
+//
+// o  The targets are taken LOCAL_LANES at a time, and their systems are
+//    interleaved in a FixedBatch, one per SIMD lane, so that the Cholesky
+//    decompositions and solves of the batch run in lock step in vector
+//    registers. Blocks of consecutive targets are kriged in parallel.
+//
+// o  On a dense grid, neighboring targets often have exactly the same
+//    nearest observations. The factored neighborhoods are kept in a
+//    least-recently-used cache of LOCAL_CACHE_ENTRIES, keyed by the set
+//    of observations, so such a target pays only for its own right hand
+//    side. The cache lookups and hits are returned in cache, if it is
+//    not null.
+//
+// References:
+//
+// o  Deutsch, C.V., and Journel, A.G., 1998, GSLIB: Geostatistical
+//    Software Library and User's Guide, 2nd ed., Oxford University Press,
+//    p. 66-70.
+//=============================================================================
+std::vector<ResultRecord> Local_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   int neighbors,
+   CacheRecord* cache )
+{
+   assert( 1 <= neighbors && neighbors <= MAXIMUM_NEIGHBORS );
+   static_assert( MAXIMUM_NEIGHBORS <= MAXIMUM_FIXED_ORDER, "FixedDispatch does not reach MAXIMUM_NEIGHBORS." );
+
+   const int M = targets.size();
+   if (M < 1) {
+      throw NoTargetsSpecified("No targets were specified.");
+   }
+
+   const int N = obs.size();
+   CheckObservationCount(N, MAXIMUM_LOCAL_COUNT, std::max(MINIMUM_COUNT, neighbors));
+
+   // Put the observations and the targets in Hilbert curve order.
+   std::vector<int> perm;
+   HilbertOrder(obs, perm);
+   {
+      std::vector<ObsRecord> sorted(N);
+      for (int n = 0; n < N; ++n)
+         sorted[n] = std::move(obs[perm[n]]);
+      obs.swap(sorted);
+   }
+
+   std::vector<int> order;
+   HilbertOrder(targets, order);
+   {
+      std::vector<TargetRecord> sorted(M);
+      for (int m = 0; m < M; ++m)
+         sorted[m] = std::move(targets[order[m]]);
+      targets.swap(sorted);
+   }
+
+   // Size the grid cells to hold about k observations each.
+   double xmin = obs[0].x, xmax = obs[0].x, ymin = obs[0].y, ymax = obs[0].y;
+   for (int n = 1; n < N; ++n) {
+      xmin = std::min(xmin, obs[n].x);  xmax = std::max(xmax, obs[n].x);
+      ymin = std::min(ymin, obs[n].y);  ymax = std::max(ymax, obs[n].y);
+   }
+   double side = std::max(xmax - xmin, ymax - ymin);
+   double area = std::max((xmax - xmin)*(ymax - ymin), side*side/N);
+   if (area <= 0) area = 1.0;
+
+   Grid grid(obs, sqrt(area * neighbors / N));
+
+   // Krige the targets.
+   std::vector<ResultRecord> results(M);
+   LocalKriging kriging = { nugget, sill, range, obs, targets, grid, results, {0, 0}, true };
+   FixedDispatch<>::Call(neighbors, kriging);
+
+   if (cache != nullptr)
+      *cache = kriging.cache;
+
+   if (!kriging.ok) {
+      throw CholeskyDecompositionFailed("Cholesky decomposition of a local Kriging system failed.");
+   }
+
+   // Return the results in the input order.
+   std::vector<ResultRecord> unsorted(M);
+   for (int m = 0; m < M; ++m)
+      unsorted[order[m]] = std::move(results[m]);
+
+   return unsorted;
+}
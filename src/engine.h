@@ -7,7 +7,7 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #ifndef ENGINE_H
 #define ENGINE_H
@@ -15,7 +15,9 @@
 #include <stdexcept>
 #include <vector>
 
+#include "matrix.h"
 #include "read_obs.h"
+#include "read_params.h"
 #include "read_targets.h"
 
 //-----------------------------------------------------------------------------
@@ -25,6 +27,12 @@ class NoTargetsSpecified : public std::runtime_error {
       }
 };
 
+class NoParametersSpecified : public std::runtime_error {
+   public :
+      NoParametersSpecified( const std::string& message ) : std::runtime_error(message) {
+      }
+};
+
 class TooFewObservations : public std::runtime_error {
    public :
       TooFewObservations( const std::string& message ) : std::runtime_error(message) {
@@ -37,6 +45,18 @@ class TooManyObservations : public std::runtime_error {
       }
 };
 
+class EstimationFailed : public std::runtime_error {
+   public :
+      EstimationFailed( const std::string& message ) : std::runtime_error(message) {
+      }
+};
+
+class IterativeSolverFailed : public std::runtime_error {
+   public :
+      IterativeSolverFailed( const std::string& message ) : std::runtime_error(message) {
+      }
+};
+
 class CholeskyDecompositionFailed : public std::runtime_error {
    public :
       CholeskyDecompositionFailed( const std::string& message ) : std::runtime_error(message) {
@@ -44,6 +64,14 @@ class CholeskyDecompositionFailed : public std::runtime_error {
 };
 
 
+//-----------------------------------------------------------------------------
+// The largest neighborhood allowed by Local_Engine.
+//-----------------------------------------------------------------------------
+const int MAXIMUM_NEIGHBORS = 32;
+
+//-----------------------------------------------------------------------------
+class WeightOperator;
+
 //-----------------------------------------------------------------------------
 struct ResultRecord {
    std::string id;
@@ -54,14 +82,141 @@ struct ResultRecord {
 };
 
 //-----------------------------------------------------------------------------
+struct Outlier {
+   int    index;
+   double zhat;
+   double zscore;
+};
+
+//-----------------------------------------------------------------------------
+struct SweepRecord {
+   ParamsRecord params;
+   double me;                             // mean leave-one-out error
+   double rmse;                           // root mean squared leave-one-out error
+   double msse;                           // mean squared standardized leave-one-out error
+   std::vector<ResultRecord> results;
+};
+
+//-----------------------------------------------------------------------------
+struct EstimateRecord {
+   ParamsRecord params;
+   double loglik;                         // maximized log (restricted) likelihood
+   int iterations;                        // number of quasi-Newton iterations
+};
+
+//-----------------------------------------------------------------------------
+struct CacheRecord {
+   long lookups;                          // number of targets looked up
+   long hits;                             // targets whose neighborhood was already factored
+};
+
+//-----------------------------------------------------------------------------
+std::vector<ResultRecord> Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets
+);
+
 std::vector<ResultRecord> Engine(
    double nugget,
    double sill,
    double range,
    std::vector<ObsRecord> obs,
+   const Matrix& Z,
+   std::vector<TargetRecord> targets,
+   Matrix& Zhat
+);
+
+void Weight_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   int keep,
+   WeightOperator& W
+);
+
+std::vector<ResultRecord> Indicator_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   const std::vector<double>& thresholds,
+   std::vector<TargetRecord> targets,
+   Matrix& F
+);
+
+void Exceedance(
+   const std::vector<ResultRecord>& results,
+   const std::vector<double>& thresholds,
+   Matrix& P
+);
+
+void Quantiles(
+   const std::vector<ResultRecord>& results,
+   const std::vector<double>& probabilities,
+   Matrix& Q
+);
+
+std::vector<Outlier> Aakozi_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   double alpha
+);
+
+std::vector<SweepRecord> Sweep_Engine(
+   std::vector<ParamsRecord> params,
+   std::vector<ObsRecord> obs,
    std::vector<TargetRecord> targets
 );
 
+std::vector<ResultRecord> Hierarchical_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   double tolerance
+);
+
+std::vector<ResultRecord> Tapered_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   double taper
+);
+
+std::vector<ResultRecord> Mixed_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   double tolerance
+);
+
+std::vector<ResultRecord> Local_Engine(
+   double nugget,
+   double sill,
+   double range,
+   std::vector<ObsRecord> obs,
+   std::vector<TargetRecord> targets,
+   int neighbors,
+   CacheRecord* cache = nullptr
+);
+
+EstimateRecord Estimate_Engine(
+   std::vector<ObsRecord> obs,
+   bool reml
+);
+
 
 //=============================================================================
 #endif  // ENGINE_H
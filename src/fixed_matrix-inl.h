@@ -0,0 +1,269 @@
+//=============================================================================
+// fixed_matrix-inl.h
+//
+//    A matrix whose dimensions are compile-time constants, with its storage
+//    on the stack, for the many tiny systems of local-neighborhood Kriging.
+//
+// notes:
+// o  A FixedMatrix is a plain aggregate of R*C doubles in row-major order:
+//    it is never allocated, it is not initialized, and copying it is a
+//    memcpy. Every loop over it has a constant trip count, so the compiler
+//    unrolls and vectorizes the small ones completely.
+//
+// o  A FixedBatch holds several same-size matrices interleaved, one per
+//    SIMD lane, so that their Cholesky decompositions and solves proceed
+//    together, as in batched BLAS libraries.
+//
+// o  FixedDispatch turns a run-time order k into a call of the matching
+//    compile-time instantiation, for 1 <= k <= MAXIMUM_FIXED_ORDER.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef FIXED_MATRIX_INL_H
+#define FIXED_MATRIX_INL_H
+
+#include <cassert>
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+// The largest order instantiated by FixedDispatch.
+//-----------------------------------------------------------------------------
+const int MAXIMUM_FIXED_ORDER = 32;
+
+//-----------------------------------------------------------------------------
+// An (R x C) matrix with stack storage.
+//-----------------------------------------------------------------------------
+template <int R, int C>
+class FixedMatrix
+{
+public:
+   static constexpr int nRows() { return R; }
+   static constexpr int nCols() { return C; }
+
+   double& operator()( int i, int j )       { return m_Data[i*C + j]; }
+   double  operator()( int i, int j ) const { return m_Data[i*C + j]; }
+
+   double*       Base()       { return m_Data; }
+   const double* Base() const { return m_Data; }
+
+private:
+   double m_Data[R*C];
+};
+
+//-----------------------------------------------------------------------------
+// Cholesky decomposition in place: on entry the lower triangle of A holds
+// the lower triangle of a symmetric positive definite matrix; on exit it
+// holds L, where A = LL'. The strict upper triangle is neither read nor
+// written. Returns false if A is not positive definite.
+//-----------------------------------------------------------------------------
+template <int K>
+bool CholeskyDecomposition( FixedMatrix<K,K>& A )
+{
+   for (int j = 0; j < K; ++j) {
+      double d = A(j,j);
+      for (int p = 0; p < j; ++p)
+         d -= A(j,p) * A(j,p);
+      if (!(d > 0.0))
+         return false;
+
+      d = sqrt(d);
+      A(j,j) = d;
+
+      const double r = 1.0/d;
+      for (int i = j+1; i < K; ++i) {
+         double s = A(i,j);
+         for (int p = 0; p < j; ++p)
+            s -= A(i,p) * A(j,p);
+         A(i,j) = s * r;
+      }
+   }
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+// Solve LL'X = B in place, given the Cholesky factor L from
+// CholeskyDecomposition. All C right hand sides are carried through each
+// row together.
+//-----------------------------------------------------------------------------
+template <int K, int C>
+void CholeskySolve( const FixedMatrix<K,K>& L, FixedMatrix<K,C>& B )
+{
+   // Forward substitution: LY = B.
+   for (int i = 0; i < K; ++i) {
+      for (int p = 0; p < i; ++p)
+         for (int c = 0; c < C; ++c)
+            B(i,c) -= L(i,p) * B(p,c);
+
+      const double r = 1.0/L(i,i);
+      for (int c = 0; c < C; ++c)
+         B(i,c) *= r;
+   }
+
+   // Back substitution: L'X = Y.
+   for (int i = K-1; i >= 0; --i) {
+      for (int p = i+1; p < K; ++p)
+         for (int c = 0; c < C; ++c)
+            B(i,c) -= L(p,i) * B(p,c);
+
+      const double r = 1.0/L(i,i);
+      for (int c = 0; c < C; ++c)
+         B(i,c) *= r;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// L independent (R x C) matrices, interleaved element by element, so that
+// element (i,j) of all L matrices is one contiguous run of L doubles: one
+// matrix per SIMD lane. Operating on all L at once is then a loop over the
+// lanes, of constant length and unit stride, which the compiler turns into
+// vector instructions.
+//-----------------------------------------------------------------------------
+template <int R, int C, int L>
+class FixedBatch
+{
+public:
+   static constexpr int nRows()  { return R; }
+   static constexpr int nCols()  { return C; }
+   static constexpr int nLanes() { return L; }
+
+   double*       operator()( int i, int j )       { return m_Data + (i*C + j)*L; }
+   const double* operator()( int i, int j ) const { return m_Data + (i*C + j)*L; }
+
+private:
+   double m_Data[R*C*L];
+};
+
+//-----------------------------------------------------------------------------
+// L Cholesky decompositions in place, in lock step; see the single matrix
+// version above. Returns false if any one of the matrices is not positive
+// definite. The other lanes are still factored, so a failure in one lane
+// never produces a NaN in another.
+//-----------------------------------------------------------------------------
+template <int K, int L>
+bool CholeskyDecomposition( FixedBatch<K,K,L>& A )
+{
+   bool definite = true;
+
+   for (int j = 0; j < K; ++j) {
+      double d[L], r[L];
+      for (int l = 0; l < L; ++l)
+         d[l] = A(j,j)[l];
+      for (int p = 0; p < j; ++p) {
+         const double* a = A(j,p);
+         for (int l = 0; l < L; ++l)
+            d[l] -= a[l] * a[l];
+      }
+      for (int l = 0; l < L; ++l) {
+         if (!(d[l] > 0.0)) {
+            definite = false;
+            d[l] = 1.0;
+         }
+      }
+
+      double* ajj = A(j,j);
+      for (int l = 0; l < L; ++l) {
+         ajj[l] = sqrt(d[l]);
+         r[l] = 1.0/ajj[l];
+      }
+
+      for (int i = j+1; i < K; ++i) {
+         double t[L];
+         for (int l = 0; l < L; ++l)
+            t[l] = A(i,j)[l];
+         for (int p = 0; p < j; ++p) {
+            const double* aip = A(i,p);
+            const double* ajp = A(j,p);
+            for (int l = 0; l < L; ++l)
+               t[l] -= aip[l] * ajp[l];
+         }
+         double* aij = A(i,j);
+         for (int l = 0; l < L; ++l)
+            aij[l] = t[l] * r[l];
+      }
+   }
+   return definite;
+}
+
+//-----------------------------------------------------------------------------
+// L solves LL'X = B in place, in lock step, given the Cholesky factors
+// from the batched CholeskyDecomposition.
+//-----------------------------------------------------------------------------
+template <int K, int C, int L>
+void CholeskySolve( const FixedBatch<K,K,L>& F, FixedBatch<K,C,L>& B )
+{
+   // Forward substitution: LY = B.
+   for (int i = 0; i < K; ++i) {
+      for (int c = 0; c < C; ++c) {
+         double t[L];
+         for (int l = 0; l < L; ++l)
+            t[l] = B(i,c)[l];
+         for (int p = 0; p < i; ++p) {
+            const double* f  = F(i,p);
+            const double* bp = B(p,c);
+            for (int l = 0; l < L; ++l)
+               t[l] -= f[l] * bp[l];
+         }
+         const double* d = F(i,i);
+         double* bi = B(i,c);
+         for (int l = 0; l < L; ++l)
+            bi[l] = t[l] / d[l];
+      }
+   }
+
+   // Back substitution: L'X = Y.
+   for (int i = K-1; i >= 0; --i) {
+      for (int c = 0; c < C; ++c) {
+         double t[L];
+         for (int l = 0; l < L; ++l)
+            t[l] = B(i,c)[l];
+         for (int p = i+1; p < K; ++p) {
+            const double* f  = F(p,i);
+            const double* bp = B(p,c);
+            for (int l = 0; l < L; ++l)
+               t[l] -= f[l] * bp[l];
+         }
+         const double* d = F(i,i);
+         double* bi = B(i,c);
+         for (int l = 0; l < L; ++l)
+            bi[l] = t[l] / d[l];
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Call f.template Run<K>() for the compile-time K equal to the run-time k,
+// where 1 <= k <= MAXIMUM_FIXED_ORDER. Use as
+//
+//    FixedDispatch<>::Call( k, f );
+//-----------------------------------------------------------------------------
+template <int K = MAXIMUM_FIXED_ORDER>
+struct FixedDispatch
+{
+   template <typename F>
+   static void Call( int k, F& f )
+   {
+      if (k == K)
+         f.template Run<K>();
+      else
+         FixedDispatch<K-1>::Call( k, f );
+   }
+};
+
+template <>
+struct FixedDispatch<0>
+{
+   template <typename F>
+   static void Call( int, F& )
+   {
+      assert( false );
+   }
+};
+
+//=============================================================================
+#endif  // FIXED_MATRIX_INL_H
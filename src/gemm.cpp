@@ -0,0 +1,344 @@
+//=============================================================================
+// gemm.cpp
+//
+//    A cache-blocked, packed, general matrix-matrix multiply.
+//
+// references:
+// o  Goto, K., and van de Geijn, R.A., 2008, Anatomy of high-performance
+//    matrix multiplication, ACM Transactions on Mathematical Software,
+//    v. 34, n. 3, article 12.
+//
+// o  Van Zee, F.G., and van de Geijn, R.A., 2015, BLIS: A framework for
+//    rapidly instantiating BLAS functionality, ACM Transactions on
+//    Mathematical Software, v. 41, n. 3, article 14.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "gemm.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "parallel-inl.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GEMM_AVX2
+#include <immintrin.h>
+#endif
+
+namespace{
+   // The register block: each call of the micro-kernel computes an
+   // (MR x NR) block of C, held in registers.
+   const int MR = 6;
+   const int NR = 8;
+
+   // The cache blocks: a (KC x NR) sliver of B stays in the L1 cache, an
+   // (MC x KC) block of A in the L2 cache, and a (KC x NC) panel of B in
+   // the L3 cache.
+   const int KC = 256;
+   const int MC = 120;                        // a multiple of MR
+   const int NC = 4096;                       // a multiple of NR
+
+   // Products with fewer multiply-adds than this are computed directly;
+   // the packing is not worth it.
+   const long SMALL_PRODUCT = 32768;
+
+   // Products with more multiply-adds than this are computed in parallel.
+   const long PARALLEL_PRODUCT = 4000000;
+
+   //--------------------------------------------------------------------------
+   // The element (i,k) of op(A), and (k,j) of op(B).
+   //--------------------------------------------------------------------------
+   inline double OpA( bool trans, const double* A, int lda, int i, int k )
+   {
+      return trans ? A[static_cast<long>(k)*lda + i] : A[static_cast<long>(i)*lda + k];
+   }
+
+   inline double OpB( bool trans, const double* B, int ldb, int k, int j )
+   {
+      return trans ? B[static_cast<long>(j)*ldb + k] : B[static_cast<long>(k)*ldb + j];
+   }
+
+   //--------------------------------------------------------------------------
+   // Pack the (mc x kc) block of op(A) starting at (i0,k0) into slivers of
+   // MR rows, each stored column by column, so that the micro-kernel reads
+   // it with unit stride. The last sliver is padded with zeros.
+   //--------------------------------------------------------------------------
+   void PackA( bool trans, const double* A, int lda, int i0, int k0, int mc, int kc, double* Ap )
+   {
+      for (int ir = 0; ir < mc; ir += MR) {
+         const int mr = std::min(MR, mc - ir);
+         for (int k = 0; k < kc; ++k) {
+            for (int r = 0; r < mr; ++r)
+               Ap[r] = OpA(trans, A, lda, i0+ir+r, k0+k);
+            for (int r = mr; r < MR; ++r)
+               Ap[r] = 0.0;
+            Ap += MR;
+         }
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // Pack the (kc x nc) panel of op(B) starting at (k0,j0) into slivers of
+   // NR columns, each stored row by row. The last sliver is padded with
+   // zeros.
+   //--------------------------------------------------------------------------
+   void PackB( bool trans, const double* B, int ldb, int k0, int j0, int kc, int nc, double* Bp )
+   {
+      for (int jr = 0; jr < nc; jr += NR) {
+         const int nr = std::min(NR, nc - jr);
+         for (int k = 0; k < kc; ++k) {
+            for (int c = 0; c < nr; ++c)
+               Bp[c] = OpB(trans, B, ldb, k0+k, j0+jr+c);
+            for (int c = nr; c < NR; ++c)
+               Bp[c] = 0.0;
+            Bp += NR;
+         }
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // Write, or add, an (MR x NR) block held in AB to the (mr x nr) corner
+   // of C.
+   //--------------------------------------------------------------------------
+   inline void Update( const double* AB, int mr, int nr, bool first, double* C, int ldc )
+   {
+      for (int r = 0; r < mr; ++r) {
+         double* c = C + static_cast<long>(r)*ldc;
+         if (first) {
+            for (int j = 0; j < nr; ++j)
+               c[j] = AB[r*NR + j];
+         }
+         else {
+            for (int j = 0; j < nr; ++j)
+               c[j] += AB[r*NR + j];
+         }
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // The portable micro-kernel: AB = Ap Bp over kc, then update C.
+   //--------------------------------------------------------------------------
+   void Kernel( int kc, const double* Ap, const double* Bp, int mr, int nr, bool first, double* C, int ldc )
+   {
+      double AB[MR*NR] = { 0.0 };
+
+      for (int k = 0; k < kc; ++k) {
+         for (int r = 0; r < MR; ++r) {
+            const double a = Ap[r];
+            for (int j = 0; j < NR; ++j)
+               AB[r*NR + j] += a * Bp[j];
+         }
+         Ap += MR;
+         Bp += NR;
+      }
+
+      Update(AB, mr, nr, first, C, ldc);
+   }
+
+#ifdef GEMM_AVX2
+   //--------------------------------------------------------------------------
+   // The AVX2/FMA micro-kernel: the (6 x 8) block of C is held in twelve
+   // 256-bit registers, and each step of k costs two loads of B, six
+   // broadcasts of A, and twelve fused multiply-adds.
+   //--------------------------------------------------------------------------
+   __attribute__((target("avx2,fma")))
+   void KernelAVX2( int kc, const double* Ap, const double* Bp, int mr, int nr, bool first, double* C, int ldc )
+   {
+      __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+      __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+      __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+      __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+      __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+      __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+      for (int k = 0; k < kc; ++k) {
+         const __m256d b0 = _mm256_loadu_pd(Bp);
+         const __m256d b1 = _mm256_loadu_pd(Bp+4);
+         __m256d a;
+
+         a = _mm256_broadcast_sd(Ap+0);
+         c00 = _mm256_fmadd_pd(a, b0, c00);  c01 = _mm256_fmadd_pd(a, b1, c01);
+         a = _mm256_broadcast_sd(Ap+1);
+         c10 = _mm256_fmadd_pd(a, b0, c10);  c11 = _mm256_fmadd_pd(a, b1, c11);
+         a = _mm256_broadcast_sd(Ap+2);
+         c20 = _mm256_fmadd_pd(a, b0, c20);  c21 = _mm256_fmadd_pd(a, b1, c21);
+         a = _mm256_broadcast_sd(Ap+3);
+         c30 = _mm256_fmadd_pd(a, b0, c30);  c31 = _mm256_fmadd_pd(a, b1, c31);
+         a = _mm256_broadcast_sd(Ap+4);
+         c40 = _mm256_fmadd_pd(a, b0, c40);  c41 = _mm256_fmadd_pd(a, b1, c41);
+         a = _mm256_broadcast_sd(Ap+5);
+         c50 = _mm256_fmadd_pd(a, b0, c50);  c51 = _mm256_fmadd_pd(a, b1, c51);
+
+         Ap += MR;
+         Bp += NR;
+      }
+
+      if (mr == MR && nr == NR) {
+         __m256d* rows[MR][2] = { {&c00,&c01}, {&c10,&c11}, {&c20,&c21}, {&c30,&c31}, {&c40,&c41}, {&c50,&c51} };
+         for (int r = 0; r < MR; ++r) {
+            double* c = C + static_cast<long>(r)*ldc;
+            if (first) {
+               _mm256_storeu_pd(c,   *rows[r][0]);
+               _mm256_storeu_pd(c+4, *rows[r][1]);
+            }
+            else {
+               _mm256_storeu_pd(c,   _mm256_add_pd(_mm256_loadu_pd(c),   *rows[r][0]));
+               _mm256_storeu_pd(c+4, _mm256_add_pd(_mm256_loadu_pd(c+4), *rows[r][1]));
+            }
+         }
+      }
+      else {
+         double AB[MR*NR];
+         _mm256_storeu_pd(AB+ 0, c00);  _mm256_storeu_pd(AB+ 4, c01);
+         _mm256_storeu_pd(AB+ 8, c10);  _mm256_storeu_pd(AB+12, c11);
+         _mm256_storeu_pd(AB+16, c20);  _mm256_storeu_pd(AB+20, c21);
+         _mm256_storeu_pd(AB+24, c30);  _mm256_storeu_pd(AB+28, c31);
+         _mm256_storeu_pd(AB+32, c40);  _mm256_storeu_pd(AB+36, c41);
+         _mm256_storeu_pd(AB+40, c50);  _mm256_storeu_pd(AB+44, c51);
+         Update(AB, mr, nr, first, C, ldc);
+      }
+   }
+#endif
+
+   //--------------------------------------------------------------------------
+   // The micro-kernel for this processor, chosen once.
+   //--------------------------------------------------------------------------
+   typedef void (*MicroKernel)( int, const double*, const double*, int, int, bool, double*, int );
+
+   MicroKernel ChooseKernel()
+   {
+#ifdef GEMM_AVX2
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+         return KernelAVX2;
+#endif
+      return Kernel;
+   }
+
+   //--------------------------------------------------------------------------
+   // Multiply a packed (mc x kc) block of A by a packed (kc x nc) panel of
+   // B into the (mc x nc) block of C.
+   //--------------------------------------------------------------------------
+   void MacroKernel( MicroKernel kernel, int mc, int nc, int kc, const double* Ap, const double* Bp, bool first, double* C, int ldc )
+   {
+      for (int jr = 0; jr < nc; jr += NR) {
+         const int nr = std::min(NR, nc - jr);
+         const double* b = Bp + static_cast<long>(jr)*kc;
+
+         for (int ir = 0; ir < mc; ir += MR) {
+            const int mr = std::min(MR, mc - ir);
+            const double* a = Ap + static_cast<long>(ir)*kc;
+            kernel(kc, a, b, mr, nr, first, C + static_cast<long>(ir)*ldc + jr, ldc);
+         }
+      }
+   }
+}
+
+//=============================================================================
+// Gemm
+//
+//    C = op(A) op(B).
+//
+// Arguments:
+//
+//    transA   if true, op(A) = A', where A is (K x M); otherwise op(A) = A,
+//             where A is (M x K).
+//
+//    transB   if true, op(B) = B', where B is (N x K); otherwise op(B) = B,
+//             where B is (K x N).
+//
+//    M, N, K  the dimensions of the product.
+//
+//    A, lda   the first factor, row-major, with lda doubles per row.
+//
+//    B, ldb   the second factor, row-major, with ldb doubles per row.
+//
+//    C, ldc   on exit, the (M x N) product, row-major, with ldc doubles
+//             per row. C must not overlap A or B.
+//
+// Notes:
+//
+// o  This is the algorithm of Goto and van de Geijn (2008), as organized
+//    in BLIS (Van Zee and van de Geijn, 2015). The product is computed in
+//    (KC x NC) panels of op(B) and (MC x KC) blocks of op(A), each copied
+//    into a packed contiguous buffer so that the micro-kernel reads both
+//    factors with unit stride, whatever the transposition. The transposes
+//    are handled entirely by the packing.
+//
+// o  The micro-kernel keeps an (MR x NR) block of C in registers for a
+//    whole KC-long sliver. On x86 processors with AVX2 and FMA, detected
+//    at run time, a vectorized kernel is used; otherwise a portable one.
+//
+// o  For large products, the blocks of op(A) are shared among the
+//    available hardware threads; each thread packs its own block. The
+//    caller turns this off with threaded = false, so that a Gemm within
+//    a ParallelFor does not start a second set of threads.
+//
+// o  Small products, including K = 0, are computed directly.
+//=============================================================================
+void Gemm( bool transA, bool transB, int M, int N, int K,
+           const double* A, int lda,
+           const double* B, int ldb,
+           double* C, int ldc,
+           bool threaded )
+{
+   assert( M >= 0 && N >= 0 && K >= 0 );
+
+   if (M == 0 || N == 0) return;
+
+   // Small products.
+   if (static_cast<long>(M)*N*K < SMALL_PRODUCT) {
+      for (int i = 0; i < M; ++i) {
+         double* c = C + static_cast<long>(i)*ldc;
+         for (int j = 0; j < N; ++j)
+            c[j] = 0.0;
+         for (int k = 0; k < K; ++k) {
+            const double a = OpA(transA, A, lda, i, k);
+            for (int j = 0; j < N; ++j)
+               c[j] += a * OpB(transB, B, ldb, k, j);
+         }
+      }
+      return;
+   }
+
+   static const MicroKernel kernel = ChooseKernel();
+
+   const bool parallel = threaded && ( static_cast<double>(M)*N*K > PARALLEL_PRODUCT );
+   const int nBlocks = (M + MC - 1) / MC;
+
+   std::vector<double> Bp( static_cast<long>(KC) * (std::min(N, NC) + NR) );
+
+   for (int jc = 0; jc < N; jc += NC) {
+      const int nc = std::min(NC, N - jc);
+
+      for (int pc = 0; pc < K; pc += KC) {
+         const int kc = std::min(KC, K - pc);
+         const bool first = (pc == 0);
+
+         PackB(transB, B, ldb, pc, jc, kc, nc, Bp.data());
+
+         auto block = [&](int ib) {
+            const int ic = ib*MC;
+            const int mc = std::min(MC, M - ic);
+
+            std::vector<double> Ap( static_cast<long>(KC) * (MC + MR) );
+            PackA(transA, A, lda, ic, pc, mc, kc, Ap.data());
+            MacroKernel(kernel, mc, nc, kc, Ap.data(), Bp.data(), first, C + static_cast<long>(ic)*ldc + jc, ldc);
+         };
+
+         if (parallel)
+            ParallelFor(0, nBlocks, block);
+         else
+            for (int ib = 0; ib < nBlocks; ++ib)
+               block(ib);
+      }
+   }
+}
@@ -0,0 +1,30 @@
+//=============================================================================
+// gemm.h
+//
+//    A cache-blocked, packed, general matrix-matrix multiply.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef GEMM_H
+#define GEMM_H
+
+//-----------------------------------------------------------------------------
+// C = op(A) op(B), where op(X) is X or X', op(A) is (M x K), op(B) is
+// (K x N), and all of the arrays are row-major with the given leading
+// dimensions. Large products are shared among the threads unless threaded
+// is false, as it must be when Gemm is called from within a ParallelFor.
+//-----------------------------------------------------------------------------
+void Gemm( bool transA, bool transB, int M, int N, int K,
+           const double* A, int lda,
+           const double* B, int ldb,
+           double* C, int ldc,
+           bool threaded = true );
+
+//=============================================================================
+#endif  // GEMM_H
@@ -0,0 +1,534 @@
+//=============================================================================
+// hmatrix.cpp
+//
+//    A hierarchically off-diagonal low-rank (HODLR) approximation of the
+//    exponential covariance matrix of a set of observations.
+//
+// references:
+// o  Ambikasaran, S., and Darve, E., 2013, An O(N log N) fast direct solver
+//    for partial hierarchically semi-separable matrices, Journal of
+//    Scientific Computing, v. 57, n. 3, p. 477-501.
+//
+// o  Bebendorf, M., 2000, Approximation of boundary element matrices,
+//    Numerische Mathematik, v. 86, n. 4, p. 565-589.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "hmatrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+
+#include "linear_systems.h"
+#include "parallel-inl.h"
+
+namespace{
+   // Clusters with no more than this many observations are stored densely.
+   const int LEAF_SIZE = 64;
+
+   //--------------------------------------------------------------------------
+   // Copy rows [begin, end) of A into B.
+   //--------------------------------------------------------------------------
+   void GetRows( const Matrix& A, int begin, int end, Matrix& B )
+   {
+      B.Resize(end-begin, A.nCols());
+      std::copy( A.Base(begin,0), A.Base(begin,0) + (end-begin)*A.nCols(), B.Base() );
+   }
+
+   //--------------------------------------------------------------------------
+   // Copy B into rows [begin, begin + B.nRows()) of A.
+   //--------------------------------------------------------------------------
+   void SetRows( const Matrix& B, int begin, Matrix& A )
+   {
+      std::copy( B.begin(), B.end(), A.Base(begin,0) );
+   }
+
+   //--------------------------------------------------------------------------
+   // A += a B C, for conformable matrices. The products in this file involve
+   // tall, thin matrices, so the loops are ordered for unit stride.
+   //--------------------------------------------------------------------------
+   void AddProduct( double a, const Matrix& B, const Matrix& C, Matrix& A )
+   {
+      const int K = B.nCols();
+      const int R = C.nCols();
+
+      for (int i = 0; i < B.nRows(); ++i) {
+         double* p = A.Base(i,0);
+         for (int k = 0; k < K; ++k) {
+            const double b = a*B(i,k);
+            const double* q = C.Base(k,0);
+            for (int r = 0; r < R; ++r)
+               p[r] += b*q[r];
+         }
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // T = B'C, for conformable matrices.
+   //--------------------------------------------------------------------------
+   void TransposeProduct( const Matrix& B, const Matrix& C, Matrix& T )
+   {
+      const int K = B.nCols();
+      const int R = C.nCols();
+
+      T.Resize(K, R);
+      for (int i = 0; i < B.nRows(); ++i) {
+         const double* q = C.Base(i,0);
+         for (int k = 0; k < K; ++k) {
+            const double b = B(i,k);
+            double* p = T.Base(k,0);
+            for (int r = 0; r < R; ++r)
+               p[r] += b*q[r];
+         }
+      }
+   }
+}
+
+//=============================================================================
+// HMatrix
+//
+//    Build the cluster tree and compress the covariance matrix.
+//
+// Arguments:
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters.
+//
+//    obs   the observations.
+//
+//    tolerance
+//          the relative accuracy of each low-rank block, e.g. 1e-8.
+//
+// Notes:
+//
+// o  The observations are reordered by recursive coordinate bisection: each
+//    cluster is split at the median of its longer bounding-box side. In
+//    this order, the two off-diagonal blocks of every cluster couple two
+//    spatially compact halves, and are numerically low rank.
+//
+// o  Each off-diagonal block C(left,right) is approximated by U V' using
+//    adaptive cross approximation (ACA) with partial pivoting, which
+//    evaluates only O((m+n)k) entries of an (m x n) block of rank k. The
+//    nugget only affects the diagonal, so it never enters a compressed
+//    block.
+//
+// o  The storage is O(N k log N) for a typical rank k, and the dense
+//    covariance matrix is never formed.
+//=============================================================================
+HMatrix::HMatrix( double nugget, double sill, double range, const std::vector<ObsRecord>& obs, double tolerance )
+   : m_Nugget(nugget), m_Sill(sill), m_Range(range), m_Tolerance(tolerance), m_Depth(0)
+{
+   assert( obs.size() > 0 );
+   assert( tolerance > 0.0 );
+
+   const int N = obs.size();
+
+   m_Perm.resize(N);
+   for (int n = 0; n < N; ++n)
+      m_Perm[n] = n;
+
+   m_X.resize(N);
+   m_Y.resize(N);
+   for (int n = 0; n < N; ++n) {
+      m_X[n] = obs[n].x;
+      m_Y[n] = obs[n].y;
+   }
+
+   // Build the cluster tree, then put the coordinates in the tree order.
+   Build(0, N, 0);
+
+   std::vector<double> x(m_X), y(m_Y);
+   for (int n = 0; n < N; ++n) {
+      m_X[n] = x[m_Perm[n]];
+      m_Y[n] = y[m_Perm[n]];
+   }
+
+   // The blocks are independent, so they are compressed in parallel.
+   ParallelFor(0, m_Nodes.size(), [&](int k) { Compress(m_Nodes[k]); });
+}
+
+//-----------------------------------------------------------------------------
+// Recursively split the index range [begin, end) of m_Perm.
+//-----------------------------------------------------------------------------
+int HMatrix::Build( int begin, int end, int level )
+{
+   const int index = m_Nodes.size();
+   m_Nodes.push_back( Node() );
+   m_Nodes[index].begin = begin;
+   m_Nodes[index].end   = end;
+   m_Nodes[index].left  = -1;
+   m_Nodes[index].right = -1;
+   m_Nodes[index].level = level;
+   m_Depth = std::max(m_Depth, level);
+
+   if (end - begin <= LEAF_SIZE) return index;
+
+   // Split at the median of the longer side of the bounding box.
+   double xmin = m_X[m_Perm[begin]], xmax = xmin;
+   double ymin = m_Y[m_Perm[begin]], ymax = ymin;
+   for (int n = begin+1; n < end; ++n) {
+      xmin = std::min(xmin, m_X[m_Perm[n]]);
+      xmax = std::max(xmax, m_X[m_Perm[n]]);
+      ymin = std::min(ymin, m_Y[m_Perm[n]]);
+      ymax = std::max(ymax, m_Y[m_Perm[n]]);
+   }
+   const std::vector<double>& key = (xmax-xmin >= ymax-ymin) ? m_X : m_Y;
+
+   int middle = begin + (end-begin)/2;
+   std::nth_element( m_Perm.begin()+begin, m_Perm.begin()+middle, m_Perm.begin()+end,
+      [&](int a, int b) { return key[a] < key[b]; } );
+
+   int left  = Build(begin, middle, level+1);
+   int right = Build(middle, end, level+1);
+
+   m_Nodes[index].left  = left;
+   m_Nodes[index].right = right;
+   return index;
+}
+
+//-----------------------------------------------------------------------------
+// The covariance between the observations i and j, in the tree order.
+//-----------------------------------------------------------------------------
+double HMatrix::Entry( int i, int j ) const
+{
+   if (i == j) return m_Sill;
+
+   double h = hypot( m_X[i]-m_X[j], m_Y[i]-m_Y[j] );
+   return (m_Sill-m_Nugget)*exp(-3.0*h/m_Range);
+}
+
+//-----------------------------------------------------------------------------
+// Fill a leaf block, or compress the off-diagonal block of an internal node
+// by ACA with partial pivoting. See Bebendorf (2000).
+//-----------------------------------------------------------------------------
+void HMatrix::Compress( Node& node )
+{
+   if (node.left < 0) {
+      const int n = node.end - node.begin;
+      node.D.Resize(n);
+      for (int i = 0; i < n; ++i)
+         for (int j = 0; j <= i; ++j)
+            node.D(i,j) = Entry(node.begin+i, node.begin+j);
+      return;
+   }
+
+   const int r0 = m_Nodes[node.left].begin;
+   const int c0 = m_Nodes[node.right].begin;
+   const int m  = m_Nodes[node.left].end - r0;
+   const int n  = m_Nodes[node.right].end - c0;
+
+   std::vector< std::vector<double> > us, vs;
+   std::vector<int> used(m, 0);
+   double norm2 = 0.0;
+
+   int i = 0;
+   while ( static_cast<int>(us.size()) < std::min(m, n) ) {
+      used[i] = 1;
+
+      // The residual row i, and its largest entry.
+      std::vector<double> v(n);
+      for (int j = 0; j < n; ++j) {
+         v[j] = Entry(r0+i, c0+j);
+         for (unsigned k = 0; k < us.size(); ++k)
+            v[j] -= us[k][i] * vs[k][j];
+      }
+
+      int jmax = 0;
+      for (int j = 1; j < n; ++j)
+         if (fabs(v[j]) > fabs(v[jmax])) jmax = j;
+
+      const double pivot = v[jmax];
+      if (fabs(pivot) <= 0.0) break;
+
+      for (int j = 0; j < n; ++j)
+         v[j] /= pivot;
+
+      // The residual column jmax.
+      std::vector<double> u(m);
+      for (int k = 0; k < m; ++k) {
+         u[k] = Entry(r0+k, c0+jmax);
+         for (unsigned l = 0; l < us.size(); ++l)
+            u[k] -= us[l][k] * vs[l][jmax];
+      }
+
+      // Update the estimate of the squared Frobenius norm of the block.
+      double uu = 0.0, vv = 0.0;
+      for (int k = 0; k < m; ++k) uu += u[k]*u[k];
+      for (int j = 0; j < n; ++j) vv += v[j]*v[j];
+
+      for (unsigned l = 0; l < us.size(); ++l) {
+         double uul = 0.0, vvl = 0.0;
+         for (int k = 0; k < m; ++k) uul += us[l][k]*u[k];
+         for (int j = 0; j < n; ++j) vvl += vs[l][j]*v[j];
+         norm2 += 2.0*uul*vvl;
+      }
+      norm2 += uu*vv;
+
+      us.push_back(u);
+      vs.push_back(v);
+
+      if (sqrt(uu*vv) <= m_Tolerance*sqrt(fabs(norm2))) break;
+
+      // The next pivot row is the largest unused entry of u.
+      int inext = -1;
+      for (int k = 0; k < m; ++k)
+         if (!used[k] && (inext < 0 || fabs(u[k]) > fabs(u[inext]))) inext = k;
+      if (inext < 0) break;
+      i = inext;
+   }
+
+   const int K = us.size();
+   if (K == 0) return;
+
+   node.U.Resize(m, K);
+   node.V.Resize(n, K);
+   for (int k = 0; k < K; ++k) {
+      for (int r = 0; r < m; ++r) node.U(r,k) = us[k][r];
+      for (int c = 0; c < n; ++c) node.V(c,k) = vs[k][c];
+   }
+}
+
+//=============================================================================
+// Factor
+//
+//    Compute the approximate inverse operator of the HMatrix.
+//
+// Return:
+//
+//    true  if the factorization was completed successfully;
+//    false if not (a leaf block or a capacitance matrix was singular).
+//
+// Notes:
+//
+// o  Write an internal node as C = D + W K W', where D = diag(C(left),
+//    C(right)), W = diag(U, V), and K = [0,I; I,0]. By the Woodbury
+//    identity,
+//
+//       C~ = D~ - D~W (K + W'D~W)~ W'D~
+//
+//    where K~ = K. The factorization stores Y = C(left)~U, Z = C(right)~V,
+//    and the inverse of the (2k x 2k) capacitance matrix
+//
+//       M = [U'Y, I; I, V'Z]
+//
+//    See Ambikasaran and Darve (2013).
+//
+// o  The nodes are factored level by level from the leaves up; the nodes
+//    on one level are independent and are factored in parallel. The cost is
+//    O(N k^2 log^2 N) for a typical rank k.
+//=============================================================================
+bool HMatrix::Factor()
+{
+   std::atomic<bool> ok(true);
+
+   for (int level = m_Depth; level >= 0; --level) {
+      std::vector<int> nodes;
+      for (unsigned k = 0; k < m_Nodes.size(); ++k)
+         if (m_Nodes[k].level == level) nodes.push_back(k);
+
+      ParallelFor(0, nodes.size(), [&](int k) {
+         if (!FactorNode(m_Nodes[nodes[k]])) ok = false;
+      });
+
+      if (!ok) return false;
+   }
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+bool HMatrix::FactorNode( Node& node )
+{
+   if (node.left < 0)
+      return CholeskyDecomposition(node.D, node.L);
+
+   const int K = node.U.nCols();
+   if (K == 0) return true;
+
+   SolveNode(node.left,  node.U, node.Y);
+   SolveNode(node.right, node.V, node.Z);
+
+   Matrix P, Q;
+   TransposeProduct(node.U, node.Y, P);
+   TransposeProduct(node.V, node.Z, Q);
+
+   Matrix M(2*K, 2*K, 0.0);
+   for (int i = 0; i < K; ++i) {
+      for (int j = 0; j < K; ++j) {
+         M(i,j)     = P(i,j);
+         M(K+i,K+j) = Q(i,j);
+      }
+      M(i,K+i) = 1.0;
+      M(K+i,i) = 1.0;
+   }
+
+   Matrix I;
+   Identity(I, 2*K);
+   return LeastSquaresSolve(M, I, node.Minv);
+}
+
+//=============================================================================
+// Multiply
+//
+//    y = C x, for an (N x R) Matrix x in the original observation order.
+//=============================================================================
+void HMatrix::Multiply( const Matrix& x, Matrix& y ) const
+{
+   assert( x.nRows() == nRows() );
+
+   const int N = nRows();
+   const int R = x.nCols();
+
+   Matrix xp(N, R), yp;
+   for (int n = 0; n < N; ++n)
+      for (int r = 0; r < R; ++r)
+         xp(n,r) = x(m_Perm[n],r);
+
+   MultiplyNode(0, xp, yp);
+
+   y.Resize(N, R);
+   for (int n = 0; n < N; ++n)
+      for (int r = 0; r < R; ++r)
+         y(m_Perm[n],r) = yp(n,r);
+}
+
+//-----------------------------------------------------------------------------
+void HMatrix::MultiplyNode( int index, const Matrix& x, Matrix& y ) const
+{
+   const Node& node = m_Nodes[index];
+
+   if (node.left < 0) {
+      Multiply_SM(node.D, x, y);
+      return;
+   }
+
+   const int m = m_Nodes[node.left].end - node.begin;
+   const int n = node.end - node.begin;
+
+   Matrix x1, x2, y1, y2;
+   GetRows(x, 0, m, x1);
+   GetRows(x, m, n, x2);
+
+   MultiplyNode(node.left,  x1, y1);
+   MultiplyNode(node.right, x2, y2);
+
+   if (node.U.nCols() > 0) {
+      Matrix t;
+      TransposeProduct(node.V, x2, t);
+      AddProduct(1.0, node.U, t, y1);
+
+      TransposeProduct(node.U, x1, t);
+      AddProduct(1.0, node.V, t, y2);
+   }
+
+   y.Resize(n, x.nCols());
+   SetRows(y1, 0, y);
+   SetRows(y2, m, y);
+}
+
+//=============================================================================
+// Solve
+//
+//    x = C~b, for an (N x R) Matrix b in the original observation order.
+//    The HMatrix must have been factored. Solve may be called concurrently.
+//=============================================================================
+void HMatrix::Solve( const Matrix& b, Matrix& x ) const
+{
+   assert( b.nRows() == nRows() );
+
+   const int N = nRows();
+   const int R = b.nCols();
+
+   Matrix bp(N, R), xp;
+   for (int n = 0; n < N; ++n)
+      for (int r = 0; r < R; ++r)
+         bp(n,r) = b(m_Perm[n],r);
+
+   SolveNode(0, bp, xp);
+
+   x.Resize(N, R);
+   for (int n = 0; n < N; ++n)
+      for (int r = 0; r < R; ++r)
+         x(m_Perm[n],r) = xp(n,r);
+}
+
+//-----------------------------------------------------------------------------
+void HMatrix::SolveNode( int index, const Matrix& b, Matrix& x ) const
+{
+   const Node& node = m_Nodes[index];
+
+   if (node.left < 0) {
+      CholeskySolve(node.L, b, x);
+      return;
+   }
+
+   const int m = m_Nodes[node.left].end - node.begin;
+   const int n = node.end - node.begin;
+
+   Matrix b1, b2, x1, x2;
+   GetRows(b, 0, m, b1);
+   GetRows(b, m, n, b2);
+
+   SolveNode(node.left,  b1, x1);
+   SolveNode(node.right, b2, x2);
+
+   const int K = node.U.nCols();
+   if (K > 0) {
+      Matrix t1, t2;
+      TransposeProduct(node.U, x1, t1);
+      TransposeProduct(node.V, x2, t2);
+
+      Matrix t(2*K, b.nCols());
+      SetRows(t1, 0, t);
+      SetRows(t2, K, t);
+
+      Matrix s(2*K, b.nCols()), s1, s2;
+      AddProduct(1.0, node.Minv, t, s);
+      GetRows(s, 0, K, s1);
+      GetRows(s, K, 2*K, s2);
+
+      AddProduct(-1.0, node.Y, s1, x1);
+      AddProduct(-1.0, node.Z, s2, x2);
+   }
+
+   x.Resize(n, b.nCols());
+   SetRows(x1, 0, x);
+   SetRows(x2, m, x);
+}
+
+//-----------------------------------------------------------------------------
+int HMatrix::nRows() const
+{
+   return m_Perm.size();
+}
+
+//-----------------------------------------------------------------------------
+int HMatrix::MaxRank() const
+{
+   int rank = 0;
+   for (unsigned k = 0; k < m_Nodes.size(); ++k)
+      rank = std::max(rank, m_Nodes[k].U.nCols());
+   return rank;
+}
+
+//-----------------------------------------------------------------------------
+long HMatrix::Storage() const
+{
+   long count = 0;
+   for (unsigned k = 0; k < m_Nodes.size(); ++k) {
+      const Node& node = m_Nodes[k];
+      count += node.D.Size();
+      count += node.L.Size();
+      count += static_cast<long>(node.U.nRows() + node.V.nRows()) * node.U.nCols();
+      count += static_cast<long>(node.Y.nRows() + node.Z.nRows()) * node.Y.nCols();
+      count += static_cast<long>(node.Minv.nRows()) * node.Minv.nCols();
+   }
+   return count;
+}
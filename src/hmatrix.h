@@ -0,0 +1,79 @@
+//=============================================================================
+// hmatrix.h
+//
+//    A hierarchically off-diagonal low-rank (HODLR) approximation of the
+//    exponential covariance matrix of a set of observations.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef HMATRIX_H
+#define HMATRIX_H
+
+#include <vector>
+
+#include "matrix.h"
+#include "packed_matrix.h"
+#include "read_obs.h"
+
+//=============================================================================
+// HMatrix
+//=============================================================================
+class HMatrix
+{
+public:
+   // Life cycle
+   HMatrix( double nugget, double sill, double range, const std::vector<ObsRecord>& obs, double tolerance );
+
+   // Operations
+   bool Factor();                                     // approximate C = (C~)~
+   void Multiply( const Matrix& x, Matrix& y ) const; // y = C x
+   void Solve( const Matrix& b, Matrix& x ) const;    // x = C~b, after Factor
+
+   // Inquiry.
+   int nRows() const;                                 // number of observations
+   int MaxRank() const;                               // largest block rank
+   long Storage() const;                              // number of stored doubles
+
+private:
+   struct Node {
+      int    begin;                                   // first (permuted) index
+      int    end;                                     // one past the last index
+      int    left;                                    // left child, or -1
+      int    right;                                   // right child, or -1
+      int    level;                                   // depth in the tree
+      PackedMatrix D;                                 // leaf: dense block
+      PackedMatrix L;                                 // leaf: Cholesky of D
+      Matrix U;                                       // C(left,right) = U V'
+      Matrix V;
+      Matrix Y;                                       // C(left)~ U
+      Matrix Z;                                       // C(right)~ V
+      Matrix Minv;                                    // inverse capacitance
+   };
+
+   int  Build( int begin, int end, int level );
+   double Entry( int i, int j ) const;
+   void Compress( Node& node );
+   bool FactorNode( Node& node );
+   void MultiplyNode( int index, const Matrix& x, Matrix& y ) const;
+   void SolveNode( int index, const Matrix& b, Matrix& x ) const;
+
+   double m_Nugget;
+   double m_Sill;
+   double m_Range;
+   double m_Tolerance;
+
+   std::vector<int>    m_Perm;                        // tree order -> input order
+   std::vector<double> m_X;                           // coordinates in tree order
+   std::vector<double> m_Y;
+   std::vector<Node>   m_Nodes;                       // m_Nodes[0] is the root
+   int                 m_Depth;
+};
+
+//=============================================================================
+#endif  // HMATRIX_H
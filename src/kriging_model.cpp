@@ -0,0 +1,390 @@
+//=============================================================================
+// kriging_model.cpp
+//
+//    A persistent Ordinary Kriging model, whose observations may be added
+//    and removed without refactoring the Kriging system.
+//
+// references:
+// o  Gill, P.E., Golub, G.H., Murray, W., and Saunders, M.A., 1974, Methods
+//    for modifying matrix factorizations, Mathematics of Computation,
+//    v. 28, n. 126, p. 505-535.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "kriging_model.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <utility>
+
+#include "linear_systems.h"
+#include "parallel-inl.h"
+#include "sum_product-inl.h"
+
+namespace{
+   // Manifest constants.
+   const int MINIMUM_COUNT = 10;
+   const int MAXIMUM_COUNT = 10000;
+   const double MIN_DIVISOR = 1e-12;
+
+   //--------------------------------------------------------------------------
+   // Replace the trailing block of L, from row k0 on, by the Cholesky
+   // decomposition of L L' + x x', where x holds rows k0 through N-1.
+   //
+   // o  This is the standard rank-one update by plane rotations; see Gill
+   //    et al. (1974). Row i only needs the rotations of the earlier rows,
+   //    so L is updated one row at a time, with unit stride.
+   //--------------------------------------------------------------------------
+   void Update( PackedMatrix& L, int k0, std::vector<double>& x )
+   {
+      const int N = L.nRows();
+
+      std::vector<double> c(N), s(N);
+      for (int i = k0; i < N; ++i) {
+         double* l = L.Base(i);
+         double xi = x[i-k0];
+
+         for (int k = k0; k < i; ++k) {
+            l[k] = (l[k] + s[k]*xi) / c[k];
+            xi = c[k]*xi - s[k]*l[k];
+         }
+
+         double r = hypot(l[i], xi);
+         c[i] = r / l[i];
+         s[i] = xi / l[i];
+         l[i] = r;
+      }
+   }
+}
+
+//=============================================================================
+// KrigingModel
+//
+//    An empty model for the exponential semi-variogram with the given
+//    nugget, sill, and range. Fit must be called before Predict; without
+//    a variogram, the Fit must supply one.
+//=============================================================================
+KrigingModel::KrigingModel()
+:  m_Nugget( 0.0 ),
+   m_Sill( 0.0 ),
+   m_Range( 0.0 ),
+   m_SumV( 0.0 ),
+   m_VZ( 0.0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+KrigingModel::KrigingModel( double nugget, double sill, double range )
+:  m_Nugget( nugget ),
+   m_Sill( sill ),
+   m_Range( range ),
+   m_SumV( 0.0 ),
+   m_VZ( 0.0 )
+{
+   assert( nugget >= 0 && sill > nugget && range > 0 );
+}
+
+//-----------------------------------------------------------------------------
+// The covariance between an observation and a distinct location.
+//-----------------------------------------------------------------------------
+double KrigingModel::Covariance( const ObsRecord& obs, double x, double y ) const
+{
+   double h = hypot( obs.x - x, obs.y - y );
+   return (m_Sill - m_Nugget) * exp(-3.0*h/m_Range);
+}
+
+//-----------------------------------------------------------------------------
+// Recompute v = C~1 and a = C~z from the current decomposition.
+//-----------------------------------------------------------------------------
+void KrigingModel::Refresh()
+{
+   const int N = nObservations();
+
+   Matrix B(N, 2), X;
+   for (int n = 0; n < N; ++n) {
+      B(n,0) = 1.0;
+      B(n,1) = m_Obs[n].z;
+   }
+   CholeskySolve(m_L, B, X);
+
+   m_v.Resize(N, 1);
+   m_a.Resize(N, 1);
+   m_SumV = 0.0;
+   m_VZ = 0.0;
+   for (int n = 0; n < N; ++n) {
+      m_v(n,0) = X(n,0);
+      m_a(n,0) = X(n,1);
+      m_SumV += X(n,0);
+      m_VZ   += X(n,1);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Discard the observations and the decomposition, leaving the model
+// unfitted, with its variogram.
+//-----------------------------------------------------------------------------
+void KrigingModel::Clear()
+{
+   m_Obs.clear();
+   m_L.Resize(0);
+   m_v.Resize(0, 0);
+   m_a.Resize(0, 0);
+   m_SumV = 0.0;
+   m_VZ = 0.0;
+}
+
+//=============================================================================
+// Fit
+//
+//    Replace the observations, and factor the covariance matrix from
+//    scratch. The observations are taken by value, so a caller that has no
+//    further use for them may move them in without a copy.
+//
+// Notes:
+//
+// o  On any failure the model is left unfitted.
+//=============================================================================
+void KrigingModel::Fit( std::vector<ObsRecord> obs )
+{
+   assert( m_Range > 0 );
+
+   try {
+      const int N = obs.size();
+      if (N < MINIMUM_COUNT) {
+         std::stringstream message;
+         message << "There must be at least " << MINIMUM_COUNT << " observations.";
+         throw TooFewObservations(message.str());
+      }
+
+      if (N > MAXIMUM_COUNT) {
+         std::stringstream message;
+         message << "There must be no more than " << MAXIMUM_COUNT << " observations.";
+         throw TooManyObservations(message.str());
+      }
+
+      m_Obs = std::move(obs);
+
+      m_L.Resize(N);
+      for (int i = 0; i < N; ++i) {
+         for (int j = 0; j < i; ++j)
+            m_L(i,j) = Covariance(m_Obs[i], m_Obs[j].x, m_Obs[j].y);
+         m_L(i,i) = m_Sill;
+      }
+
+      if (!CholeskyDecomposition(m_L, m_L)) {
+         throw CholeskyDecompositionFailed("Cholesky decomposition of the Kriging system failed.");
+      }
+
+      Refresh();
+   }
+   catch (...) {
+      Clear();
+      throw;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Replace the semi-variogram as well as the observations. On any failure
+// the model is left unfitted, with its previous variogram.
+//-----------------------------------------------------------------------------
+void KrigingModel::Fit( std::vector<ObsRecord> obs, const ParamsRecord& variogram )
+{
+   assert( variogram.nugget >= 0 && variogram.sill > variogram.nugget && variogram.range > 0 );
+
+   const ParamsRecord previous = Variogram();
+
+   m_Nugget = variogram.nugget;
+   m_Sill   = variogram.sill;
+   m_Range  = variogram.range;
+
+   try {
+      Fit( std::move(obs) );
+   }
+   catch (...) {
+      m_Nugget = previous.nugget;
+      m_Sill   = previous.sill;
+      m_Range  = previous.range;
+      throw;
+   }
+}
+
+//=============================================================================
+// AddObservation
+//
+//    Append an observation, updating the decomposition in O(N^2).
+//
+// Notes:
+//
+// o  With the new observation last, the covariance matrix is bordered:
+//
+//       [ C   c ]   [ L   0 ] [ L'  l ]
+//       [ c'  s ] = [ l'  d ] [ 0   d ]
+//
+//    so L l = c is one forward substitution, and d = sqrt(s - l'l).
+//=============================================================================
+void KrigingModel::AddObservation( const ObsRecord& obs )
+{
+   const int N = nObservations();
+   assert( N > 0 );
+
+   if (N+1 > MAXIMUM_COUNT) {
+      std::stringstream message;
+      message << "There must be no more than " << MAXIMUM_COUNT << " observations.";
+      throw TooManyObservations(message.str());
+   }
+
+   std::vector<double> l(N);
+   for (int i = 0; i < N; ++i) {
+      double c = Covariance(m_Obs[i], obs.x, obs.y);
+      l[i] = (c - SumProduct(i, m_L.Base(i), l.data())) / m_L(i,i);
+   }
+
+   double d = m_Sill - SumProduct(N, l.data());
+   if (d < MIN_DIVISOR) {
+      throw CholeskyDecompositionFailed("The added observation makes the Kriging system singular.");
+   }
+
+   m_L.Extend(N+1);
+   std::copy( l.begin(), l.end(), m_L.Base(N) );
+   m_L(N,N) = sqrt(d);
+
+   m_Obs.push_back(obs);
+   Refresh();
+}
+
+//=============================================================================
+// RemoveObservation
+//
+//    Delete the observation at the given index, updating the decomposition
+//    in O(N^2). The later observations move up one place.
+//
+// Notes:
+//
+// o  Deleting row and column k of C deletes row k of L, which leaves the
+//    trailing block short by the outer product of the rest of column k:
+//
+//       C33 = L33 L33' + x x',   x = L(k+1:N, k)
+//
+//    so the trailing block gets a rank-one update. The earlier rows are
+//    unchanged.
+//=============================================================================
+void KrigingModel::RemoveObservation( int index )
+{
+   const int N = nObservations();
+   assert( 0 <= index && index < N );
+
+   if (N-1 < MINIMUM_COUNT) {
+      std::stringstream message;
+      message << "There must be at least " << MINIMUM_COUNT << " observations.";
+      throw TooFewObservations(message.str());
+   }
+
+   std::vector<double> x(N-1-index);
+   for (int i = index+1; i < N; ++i)
+      x[i-index-1] = m_L(i,index);
+
+   m_L.Erase(index);
+   Update(m_L, index, x);
+
+   m_Obs.erase(m_Obs.begin() + index);
+   Refresh();
+}
+
+//=============================================================================
+// Predict
+//
+//    Compute the Ordinary Kriging estimate and standard deviation at one
+//    target. Predict may be called concurrently.
+//
+// Notes:
+//
+// o  With b the target covariances, the estimate needs only the cached
+//    vectors: b'C~z - lambda 1'C~z, where lambda = (b'C~1 - 1)/(1'C~1).
+//    The variance also needs b'C~b = w'w, where L w = b, which is a single
+//    forward substitution: half the work of a full solve.
+//=============================================================================
+void KrigingModel::Predict( double x, double y, double& zhat, double& kstd ) const
+{
+   const int N = nObservations();
+   assert( N > 0 );
+
+   std::vector<double> b(N), w(N);
+   double vb = 0.0, ab = 0.0;
+   for (int i = 0; i < N; ++i) {
+      b[i] = Covariance(m_Obs[i], x, y);
+      vb += m_v(i,0) * b[i];
+      ab += m_a(i,0) * b[i];
+      w[i] = (b[i] - SumProduct(i, m_L.Base(i), w.data())) / m_L(i,i);
+   }
+   double bb = SumProduct(N, w.data());
+
+   double lambda = (vb - 1) / m_SumV;
+
+   zhat = ab - lambda*m_VZ;
+   kstd = sqrt( m_Sill - bb + lambda*vb - lambda );
+}
+
+//-----------------------------------------------------------------------------
+void KrigingModel::Predict( const TargetRecord& target, ResultRecord& result ) const
+{
+   result.id = target.id;
+   result.x  = target.x;
+   result.y  = target.y;
+   Predict( target.x, target.y, result.zhat, result.kstd );
+}
+
+//=============================================================================
+// Predict
+//
+//    Krige count targets, writing the results to caller-owned storage. The
+//    targets are spread over the available hardware threads.
+//=============================================================================
+void KrigingModel::Predict( const TargetRecord* targets, int count, ResultRecord* results ) const
+{
+   assert( count >= 0 );
+
+   ParallelFor(0, count, [&](int m) {
+      Predict( targets[m], results[m] );
+   });
+}
+
+//-----------------------------------------------------------------------------
+std::vector<ResultRecord> KrigingModel::Predict( const std::vector<TargetRecord>& targets ) const
+{
+   std::vector<ResultRecord> results( targets.size() );
+   Predict( targets.data(), targets.size(), results.data() );
+   return results;
+}
+
+//-----------------------------------------------------------------------------
+bool KrigingModel::IsFitted() const
+{
+   return !m_Obs.empty();
+}
+
+//-----------------------------------------------------------------------------
+ParamsRecord KrigingModel::Variogram() const
+{
+   ParamsRecord variogram = { m_Nugget, m_Sill, m_Range };
+   return variogram;
+}
+
+//-----------------------------------------------------------------------------
+int KrigingModel::nObservations() const
+{
+   return m_Obs.size();
+}
+
+//-----------------------------------------------------------------------------
+const ObsRecord& KrigingModel::Observation( int index ) const
+{
+   return m_Obs[index];
+}
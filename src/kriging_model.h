@@ -0,0 +1,80 @@
+//=============================================================================
+// kriging_model.h
+//
+//    A persistent Ordinary Kriging model, whose observations may be added
+//    and removed without refactoring the Kriging system.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef KRIGING_MODEL_H
+#define KRIGING_MODEL_H
+
+#include <vector>
+
+#include "engine.h"
+#include "matrix.h"
+#include "packed_matrix.h"
+#include "read_obs.h"
+#include "read_params.h"
+#include "read_targets.h"
+
+//=============================================================================
+// KrigingModel
+//
+//    The Cholesky decomposition of the covariance matrix of a set of
+//    observations, with v = C~1 and a = C~z, ready to krige any target.
+//
+//    This is the library interface to Mizhodan: fit once, then predict as
+//    often as needed. The Predict methods are const and keep no state, so
+//    any number of threads may call them at once; Fit, AddObservation, and
+//    RemoveObservation must not run concurrently with anything else.
+//=============================================================================
+class KrigingModel
+{
+public:
+   // Life cycle
+   KrigingModel();                                    // no variogram yet
+   KrigingModel( double nugget, double sill, double range );
+
+   // Operations
+   void Fit( std::vector<ObsRecord> obs );            // factor from scratch
+   void Fit( std::vector<ObsRecord> obs, const ParamsRecord& variogram );
+   void AddObservation( const ObsRecord& obs );       // O(N^2) update
+   void RemoveObservation( int index );               // O(N^2) update
+
+   void Predict( double x, double y, double& zhat, double& kstd ) const;
+   void Predict( const TargetRecord& target, ResultRecord& result ) const;
+   void Predict( const TargetRecord* targets, int count, ResultRecord* results ) const;
+   std::vector<ResultRecord> Predict( const std::vector<TargetRecord>& targets ) const;
+
+   // Inquiry.
+   bool IsFitted() const;                             // ready to predict
+   ParamsRecord Variogram() const;                    // nugget, sill, range
+   int nObservations() const;                         // current number
+   const ObsRecord& Observation( int index ) const;   // in the current order
+
+private:
+   double Covariance( const ObsRecord& obs, double x, double y ) const;
+   void Refresh();
+   void Clear();
+
+   double m_Nugget;
+   double m_Sill;
+   double m_Range;
+
+   std::vector<ObsRecord> m_Obs;
+   PackedMatrix m_L;                                  // C = LL'
+   Matrix m_v;                                        // C~1
+   Matrix m_a;                                        // C~z
+   double m_SumV;                                     // 1'C~1
+   double m_VZ;                                       // 1'C~z
+};
+
+//=============================================================================
+#endif  // KRIGING_MODEL_H
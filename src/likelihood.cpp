@@ -0,0 +1,200 @@
+//=============================================================================
+// likelihood.cpp
+//
+//    The Gaussian likelihood, and restricted likelihood, of the observations
+//    under the exponential covariance model with an unknown constant mean.
+//
+// references:
+// o  Mardia, K.V., and Marshall, R.J., 1984, Maximum likelihood estimation
+//    of models for residual covariance in spatial regression, Biometrika,
+//    v. 71, n. 1, p. 135-146.
+//
+// o  Patterson, H.D., and Thompson, R., 1971, Recovery of inter-block
+//    information when block sizes are unequal, Biometrika, v. 58, n. 3,
+//    p. 545-554.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cassert>
+#include <cmath>
+
+#include "likelihood.h"
+#include "linear_systems.h"
+#include "numerical_constants.h"
+#include "packed_matrix.h"
+
+namespace{
+   //--------------------------------------------------------------------------
+   // Evaluate the negative log likelihood, and optionally its gradient.
+   //--------------------------------------------------------------------------
+   bool Evaluate(
+      const std::vector<ObsRecord>& obs,
+      double nugget,
+      double sill,
+      double range,
+      bool reml,
+      double& f,
+      Matrix* grad )
+   {
+      assert( nugget > 0 && sill > nugget && range > 0 );
+
+      const int N = obs.size();
+      const double psill = sill - nugget;
+
+      // Create the matrix of observed values.
+      Matrix Z(N, 1);
+      for (int n = 0; n < N; ++n)
+         Z(n,0) = obs[n].z;
+
+      // Create and factor the covariance matrix, in place.
+      PackedMatrix L(N);
+      for (int i = 0; i < N; ++i) {
+         for (int j = 0; j < i; ++j) {
+            double h = hypot( obs[i].x-obs[j].x, obs[i].y-obs[j].y );
+            L(i,j) = psill*exp(-3.0*h/range);
+         }
+         L(i,i) = sill;
+      }
+      if (!CholeskyDecomposition(L,L)) return false;
+
+      double logdet = 0.0;
+      for (int n = 0; n < N; ++n)
+         logdet += 2.0*log(L(n,n));
+
+      // v = C~1, the generalized least squares mean, and alpha = Pz.
+      Matrix ones(N, 1, 1.0);
+      Matrix v;
+      CholeskySolve(L, ones, v);
+      double sumv = Sum(v);
+
+      Matrix Cz;
+      CholeskySolve(L, Z, Cz);
+      double mu = Sum(Cz) / sumv;
+
+      Matrix alpha(N, 1);
+      for (int n = 0; n < N; ++n)
+         alpha(n,0) = Cz(n,0) - mu*v(n,0);
+
+      double zPz = DotProduct(Z, alpha);
+
+      if (reml)
+         f = 0.5*(logdet + log(sumv) + zPz) + 0.5*(N-1)*log(TWO_PI);
+      else
+         f = 0.5*(logdet + zPz) + 0.5*N*log(TWO_PI);
+
+      if (grad == nullptr) return true;
+
+      // The gradient requires the full inverse, which overwrites L.
+      PackedMatrix& Cinv = L;
+      CholeskyInverse(L, Cinv);
+
+      // The trace and the quadratic forms for the range derivative, which
+      // is the only one that is not a multiple of I or C.
+      double trCinv = Trace(Cinv);
+      double trR = 0.0, vRv = 0.0, aRa = 0.0;
+
+      for (int i = 1; i < N; ++i) {
+         for (int j = 0; j < i; ++j) {
+            double h = hypot( obs[i].x-obs[j].x, obs[i].y-obs[j].y );
+            double d = 3.0*h/range * psill*exp(-3.0*h/range);
+
+            trR += 2.0 * Cinv(i,j) * d;
+            vRv += 2.0 * v(i,0) * v(j,0) * d;
+            aRa += 2.0 * alpha(i,0) * alpha(j,0) * d;
+         }
+      }
+
+      double vv = DotProduct(v, v);
+      double aa = DotProduct(alpha, alpha);
+
+      // tr(C~ dC), v' dC v, and alpha' dC alpha for each of the parameters.
+      double tr[3]  = { nugget*trCinv, N - nugget*trCinv, trR };
+      double vdv[3] = { nugget*vv,     sumv - nugget*vv,  vRv };
+      double ada[3] = { nugget*aa,     zPz - nugget*aa,   aRa };
+
+      grad->Resize(3, 1);
+      for (int k = 0; k < 3; ++k) {
+         double t = tr[k];
+         if (reml) t -= vdv[k] / sumv;
+         (*grad)(k,0) = 0.5*(t - ada[k]);
+      }
+
+      return true;
+   }
+}
+
+//=============================================================================
+// NegativeLogLikelihood
+//
+//    Compute the negative log likelihood (or restricted likelihood) of the
+//    observations under the exponential semi-variogram model.
+//
+// Arguments:
+//
+//    obs   the observations.
+//
+//    nugget, sill, range
+//          the exponential semi-variogram model parameters, with
+//          0 < nugget < sill and 0 < range.
+//
+//    reml  if true, the restricted (REML) likelihood is used; otherwise,
+//          the full (ML) likelihood with the mean profiled out.
+//
+//    f     on exit, the negative log likelihood.
+//
+//    grad  on exit, the (3 x 1) gradient of f with respect to
+//          log(nugget), log(sill-nugget), and log(range).
+//
+// Return:
+//
+//    true  if the covariance matrix was successfully factored;
+//    false if not.
+//
+// Notes:
+//
+// o  With C the covariance matrix, v = C~1, and P = C~ - vv'/(1'v),
+//
+//       ML:   f = 1/2 [ log|C| + z'Pz ] + N/2 log(2 pi)
+//       REML: f = 1/2 [ log|C| + log(1'v) + z'Pz ] + (N-1)/2 log(2 pi)
+//
+//    and, for each parameter t,
+//
+//       ML:   df/dt = 1/2 [ tr(C~ dC) - z'P dC Pz ]
+//       REML: df/dt = 1/2 [ tr(P dC) - z'P dC Pz ]
+//
+//    The log|C| comes from the Cholesky decomposition.
+//
+// o  Under the log parameterization dC/dlog(nugget) = nugget I and
+//    dC/dlog(sill-nugget) = C - nugget I, so their traces follow from
+//    tr(C~). Only the range derivative requires a full O(N^2) pass over
+//    C~. The Cholesky decomposition and the inverse are computed in
+//    parallel for large N.
+//=============================================================================
+bool NegativeLogLikelihood(
+   const std::vector<ObsRecord>& obs,
+   double nugget,
+   double sill,
+   double range,
+   bool reml,
+   double& f )
+{
+   return Evaluate(obs, nugget, sill, range, reml, f, nullptr);
+}
+
+bool NegativeLogLikelihood(
+   const std::vector<ObsRecord>& obs,
+   double nugget,
+   double sill,
+   double range,
+   bool reml,
+   double& f,
+   Matrix& grad )
+{
+   return Evaluate(obs, nugget, sill, range, reml, f, &grad);
+}
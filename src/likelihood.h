@@ -0,0 +1,42 @@
+//=============================================================================
+// likelihood.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef LIKELIHOOD_H
+#define LIKELIHOOD_H
+
+#include <vector>
+
+#include "matrix.h"
+#include "read_obs.h"
+
+//-----------------------------------------------------------------------------
+bool NegativeLogLikelihood(
+   const std::vector<ObsRecord>& obs,
+   double nugget,
+   double sill,
+   double range,
+   bool reml,
+   double& f
+);
+
+bool NegativeLogLikelihood(
+   const std::vector<ObsRecord>& obs,
+   double nugget,
+   double sill,
+   double range,
+   bool reml,
+   double& f,
+   Matrix& grad
+);
+
+
+//=============================================================================
+#endif  // LIKELIHOOD_H
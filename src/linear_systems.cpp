@@ -14,17 +14,27 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #include "linear_systems.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <vector>
 
+#include "parallel-inl.h"
 #include "sum_product-inl.h"
 
 namespace{
    double MIN_DIVISOR = 1e-12;
+
+   // The column block width for CholeskyDecomposition.
+   const int BLOCK_SIZE = 64;
+
+   // Systems of at least this order are factored and inverted in parallel.
+   const int PARALLEL_COUNT = 1000;
 }
 
 //=============================================================================
@@ -35,9 +45,9 @@ namespace{
 //
 // Arguments:
 //
-//    A     on entrance, a symmetric positive definite Matrix.
+//    A     on entrance, a symmetric positive definite PackedMatrix.
 //
-//    L     on exit, the lower triangular Matrix L where A = LL'.
+//    L     on exit, the lower triangular PackedMatrix L where A = LL'.
 //
 // Return:
 //
@@ -49,43 +59,77 @@ namespace{
 // o  This routine is based upon Golub and Van Loan, 1996, Algorithm 4.2-1,
 //    page 144.
 //
-// o  Only the lower triangular portion of A is accessed, so only the lower
-//    triangular portion needs to be filled.
+// o  The matrices A and L may be the same space in memory, in which case
+//    the decomposition is computed in place and no additional storage is
+//    needed.
 //
 // o  The routine CholeskySolve is this routine's complementary pair.
 //
+// o  The columns are processed in blocks of BLOCK_SIZE. Once the diagonal
+//    block is factored, each remaining row of the block column depends only
+//    on itself and the diagonal block, so the rows are computed in parallel
+//    for large systems. The arithmetic is identical to the unblocked
+//    algorithm.
+//
 // References:
 //
 // o  Golub, G.H., and Van Loan, C.F., 1996, MATRIX COMPUTATIONS, 3rd Edition,
 //    Johns Hopkins University Press, Baltimore, Maryland, 694 pp.
 //=============================================================================
-bool CholeskyDecomposition( const Matrix& A, Matrix& L )
+bool CholeskyDecomposition( const PackedMatrix& A, PackedMatrix& L )
 {
-   // Validate the arguments.
-   assert(isSquare(A));
-
    // Define local constants.
    const int N = A.nRows();
 
-   // Carry out the Cholesky decomposition on Matrix "A".
-   L = A;
-   for (int j = 0; j < N; ++j) {
-      if (j > 0) {
-         for (int k = j; k < N; ++k)
-            L(k,j) -= SumProduct(j, L.Base(j,0), L.Base(k,0));
+   // Carry out the Cholesky decomposition on Matrix "A", one block of
+   // columns at a time.
+   if (&L != &A) L = A;
+
+   for (int j0 = 0; j0 < N; j0 += BLOCK_SIZE) {
+      const int j1 = std::min(j0 + BLOCK_SIZE, N);
+
+      // Factor the diagonal block.
+      for (int k = j0; k < j1; ++k) {
+         for (int j = j0; j < k; ++j)
+            L(k,j) = (L(k,j) - SumProduct(j, L.Base(j), L.Base(k))) / L(j,j);
+
+         L(k,k) -= SumProduct(k, L.Base(k));
+         if (L(k,k) < MIN_DIVISOR) return false;
+         L(k,k) = sqrt(L(k,k));
       }
 
-      if (L(j,j) < MIN_DIVISOR) return false;
-      L(j,j) = sqrt(L(j,j));
+      // Compute the rest of the block column. The rows are independent.
+      auto row = [&](int k) {
+         for (int j = j0; j < j1; ++j)
+            L(k,j) = (L(k,j) - SumProduct(j, L.Base(j), L.Base(k))) / L(j,j);
+      };
 
-      for (int k = j+1; k < N; ++k) {
-         L(k,j) /= L(j,j);
-         L(j,k) = 0.0;
+      if (N < PARALLEL_COUNT) {
+         for (int k = j1; k < N; ++k)
+            row(k);
+      }
+      else {
+         ParallelFor(j1, N, row);
       }
    }
    return true;
 }
 
+//-----------------------------------------------------------------------------
+// The same, for a full Matrix A. Only the lower triangular portion of A is
+// accessed, and the upper triangle of L is zeroed.
+//-----------------------------------------------------------------------------
+bool CholeskyDecomposition( const Matrix& A, Matrix& L )
+{
+   assert(isSquare(A));
+
+   PackedMatrix P(A);
+   if (!CholeskyDecomposition(P, P)) return false;
+
+   UnpackLower(P, L);
+   return true;
+}
+
 //=============================================================================
 // CholeskySolve
 //
@@ -97,8 +141,10 @@ bool CholeskyDecomposition( const Matrix& A, Matrix& L )
 //
 //    L     the Cholesky decomposition of a symmetric positive definite
 //          matrix A = LL'.
-//    b     on entrance, the right hand side of the system of equations;
-//          on exit, the solution.
+//    b     the right hand side of the system of equations; each column is
+//          a separate right hand side.
+//
+//    x     on exit, the solution.
 //
 // Notes:
 //
@@ -115,44 +161,67 @@ bool CholeskyDecomposition( const Matrix& A, Matrix& L )
 //    however, in both sub-systems the soultion overwrites the right hand
 //    side vector b.
 //
+// o  The back substitution is column oriented, so that it reads the rows of
+//    the packed L with unit stride.
+//
 // References:
 //
 //    Golub, G.H., and Van Loan, C.F., 1983, MATRIX COMPUTATIONS, Johns
 //    Hopkins University Press, Baltimore, Maryland, 476 pp.
 //
 //=============================================================================
-void CholeskySolve( const Matrix& L, const Matrix& b, Matrix& x )
+void CholeskySolve( const PackedMatrix& L, const Matrix& b, Matrix& x )
 {
    // Validate the arguments.
-   assert( L.nRows() == L.nCols() );
    assert( b.nRows() == L.nRows() );
 
    // Define local constants.
    const int N = L.nRows();
+   const int R = b.nCols();
 
    // Solve L y = b using forward elimination.
    x = b;
 
-   double Sum;
    for (int i = 0; i < N; i++) {
-      Sum = x(i,0);
-      for (int j = 0; j < i; ++j)
-         Sum -= L(i,j) * x(j,0);
+      const double* l = L.Base(i);
+      double* xi = x.Base(i,0);
 
-      x(i,0) = Sum / L(i,i);
+      for (int j = 0; j < i; ++j) {
+         const double* xj = x.Base(j,0);
+         for (int r = 0; r < R; ++r)
+            xi[r] -= l[j] * xj[r];
+      }
+
+      for (int r = 0; r < R; ++r)
+         xi[r] /= l[i];
    }
 
-   // Solve L' x = y using back substitution.
+   // Solve L' x = y using back substitution, one column of L' at a time.
    // See Golub and Van Loan, 1983, Algorithm 4.1-2, page 53.
    for (int i = N-1; i >= 0; --i) {
-      Sum = x(i,0);
-      for (int j=i+1; j<N; ++j)
-         Sum -= L(j,i) * x(j,0);
+      const double* l = L.Base(i);
+      double* xi = x.Base(i,0);
+
+      for (int r = 0; r < R; ++r)
+         xi[r] /= l[i];
 
-      x(i,0) = Sum / L(i,i);
+      for (int j = 0; j < i; ++j) {
+         double* xj = x.Base(j,0);
+         for (int r = 0; r < R; ++r)
+            xj[r] -= l[j] * xi[r];
+      }
    }
 }
 
+//-----------------------------------------------------------------------------
+// The same, for a full lower triangular Matrix L.
+//-----------------------------------------------------------------------------
+void CholeskySolve( const Matrix& L, const Matrix& b, Matrix& x )
+{
+   assert( L.nRows() == L.nCols() );
+   CholeskySolve( PackedMatrix(L), b, x );
+}
+
 //=============================================================================
 // CholeskyInverse
 //
@@ -169,28 +238,74 @@ void CholeskySolve( const Matrix& L, const Matrix& b, Matrix& x )
 // o  The computation of the inverse is based upon the standard Cholesky
 //    decompostion.
 //
+// o  The transpose of the inverse of L is formed row by row, in packed
+//    upper triangular storage, so that both the inversion and the product
+//    U U' use unit-stride dot products. Both steps are computed in parallel
+//    for large systems.
+//
+// o  The matrices L and Ainv may be the same space in memory.
+//
 // References:
 // o  Stewart, G., 1998, "Matrix Algorithms - Volume I: Basic Decompositions",
 //    SIAM, Philadelphia, 458pp., ISBN 0-89871-414-1.
 //=============================================================================
-void CholeskyInverse( const Matrix& L, Matrix& Ainv ) 
+void CholeskyInverse( const PackedMatrix& L, PackedMatrix& Ainv )
 {
    assert( L.nRows() > 0 );
-   assert( L.nRows() == L.nCols() );
    const int N = L.nRows();
 
-   Matrix LL(L);
+   // Compute U = (L~)', one row at a time; row i of U is the solution of
+   // L x = e(i) by forward elimination, so the rows are independent. Row i
+   // holds columns i through N-1.
+   std::vector<double> U( static_cast<long>(N)*(N+1)/2 );
+   auto row = [&](int i) {
+      return U.data() + static_cast<long>(i)*N - static_cast<long>(i)*(i-1)/2;
+   };
+
+   auto invert = [&](int i) {
+      double* u = row(i);
+      u[0] = 1.0/L(i,i);
+      for (int k = i+1; k < N; ++k)
+         u[k-i] = -SumProduct(k-i, L.Base(k)+i, u) / L(k,k);
+   };
+
+   if (N < PARALLEL_COUNT) {
+      for (int i = 0; i < N; ++i)
+         invert(i);
+   }
+   else {
+      ParallelFor(0, N, invert);
+   }
+
+   // A = L L' --> Ainv = (L')~ L~ = U U'. Only the lower triangle is
+   // computed.
+   Ainv.Resize(N);
 
-   // Invert L in place; remember that L is lower triangular.
-   for (int k = 0; k < N; ++k) {
-      LL(k,k) = 1.0/LL(k,k);
+   auto multiply = [&](int i) {
+      for (int j = 0; j <= i; ++j)
+         Ainv(i,j) = SumProduct(N-i, row(i), row(j)+(i-j));
+   };
 
-      for (int i = 0; i < k; ++i)
-         LL(k,i) = -LL(k,k) * SumProduct( k-i, LL.Base(i,i), N, LL.Base(k,i) );
+   if (N < PARALLEL_COUNT) {
+      for (int i = 0; i < N; ++i)
+         multiply(i);
    }
+   else {
+      ParallelFor(0, N, multiply);
+   }
+}
 
-   // A = L L' --> Ainv = (L')~ L~ = (L~)' L~
-   Multiply_MtM( LL, LL, Ainv );
+//-----------------------------------------------------------------------------
+// The same, for a full lower triangular Matrix L. The full, symmetric
+// inverse is returned.
+//-----------------------------------------------------------------------------
+void CholeskyInverse( const Matrix& L, Matrix& Ainv )
+{
+   assert( L.nRows() == L.nCols() );
+
+   PackedMatrix P(L);
+   CholeskyInverse(P, P);
+   Unpack(P, Ainv);
 }
 
 //=============================================================================
@@ -207,11 +322,7 @@ void CholeskyInverse( const Matrix& L, Matrix& Ainv )
 // o  The computation of the inverse is based upon the standard Cholesky
 //    decompostion.
 //
-// o  Only the lower triangular portion of A is accessed, so only the lower
-//    triangular portion needs to be filled.
-//
-// o  The inversion in place for an lower triangular Matrix is based upon
-//    the pseudo-code given in Stewart (1998, p. 179).
+// o  The inverse is computed by CholeskyInverse.
 //
 // o  The matrices A and Ainv may be the same space in memory.
 //
@@ -219,26 +330,30 @@ void CholeskyInverse( const Matrix& L, Matrix& Ainv )
 // o  Stewart, G., 1998, "Matrix Algorithms - Volume I: Basic Decompositions",
 //    SIAM, Philadelphia, 458pp., ISBN 0-89871-414-1.
 //=============================================================================
-bool RSPDInv( const Matrix& A, Matrix& Ainv )
+bool RSPDInv( const PackedMatrix& A, PackedMatrix& Ainv )
 {
-   assert(isSquare(A));
-   const int N = A.nRows();
-
    // Compute the Cholesky decomposition of "A", putting the result in "L".
-   Matrix L;
-   CholeskyDecomposition(A,L);
+   PackedMatrix L;
+   if (!CholeskyDecomposition(A,L)) return false;
 
-   // Invert L in place; remember that L is lower triangular.
-   for (int k = 0; k < N; ++k) {
-      L(k,k) = 1.0/L(k,k);
+   // A = L L' --> Ainv = (L')~ L~
+   CholeskyInverse(L, Ainv);
 
-      for (int i = 0; i < k; ++i)
-         L(k,i) = -L(k,k) * SumProduct( k-i, L.Base(i,i), N, L.Base(k,i) );
-   }
+   return true;
+}
 
-   // A = L L' --> Ainv = (L')~ L~ = (L~)' L~
-   Multiply_MtM( L, L, Ainv );
+//-----------------------------------------------------------------------------
+// The same, for a full Matrix A. Only the lower triangular portion of A is
+// accessed, and the full, symmetric inverse is returned.
+//-----------------------------------------------------------------------------
+bool RSPDInv( const Matrix& A, Matrix& Ainv )
+{
+   assert(isSquare(A));
 
+   PackedMatrix P(A);
+   if (!RSPDInv(P, P)) return false;
+
+   Unpack(P, Ainv);
    return true;
 }
 
@@ -380,6 +495,256 @@ bool LeastSquaresSolve( const Matrix& A, const Matrix& B, Matrix& X )
 }
 
 
+//=============================================================================
+// SymmetricEigen
+//
+//    Compute the eigenvalues and eigenvectors of the real, symmetric Matrix
+//    "A".
+//
+// Arguments:
+//
+//    A     on entrance, a real symmetric (N x N) Matrix.
+//
+//    d     on exit, the (N x 1) Matrix of eigenvalues in ascending order.
+//
+//    Q     on exit, the (N x N) orthogonal Matrix whose columns are the
+//          corresponding eigenvectors, so that A = Q diag(d) Q'.
+//
+// Return:
+//
+//    true  if the decomposition was completed successfully;
+//    false if the QL iterations failed to converge.
+//
+// Notes:
+//
+// o  The Matrix is first reduced to tridiagonal form using Householder
+//    reflections, with the reflections accumulated in Q (Martin et al.,
+//    1968). The tridiagonal Matrix is then diagonalized using the implicit
+//    QL algorithm with Wilkinson shifts (Bowdler et al., 1968), applying
+//    the plane rotations to Q. See Golub and Van Loan (1996), Section 8.3.
+//
+// o  This is the classic tred2/tql2 pair from EISPACK. The total cost is
+//    roughly 9N^3 flops, about 27 times the cost of CholeskyDecomposition.
+//    It pays off when many shifted systems (A + cI) must be solved, since
+//    each shift then costs only O(N^2).
+//
+// o  Only the lower triangular portion of A is accessed.
+//
+// References:
+//
+// o  Bowdler, H., Martin, R.S., Reinsch, C., and Wilkinson, J.H., 1968,
+//    The QR and QL algorithms for symmetric matrices, Numerische
+//    Mathematik, v. 11, p. 293-306.
+//
+// o  Golub, G.H., and Van Loan, C.F., 1996, MATRIX COMPUTATIONS, 3rd Edition,
+//    Johns Hopkins University Press, Baltimore, Maryland, 694 pp.
+//
+// o  Martin, R.S., Reinsch, C., and Wilkinson, J.H., 1968, Householder's
+//    tridiagonalization of a symmetric matrix, Numerische Mathematik,
+//    v. 11, p. 181-195.
+//=============================================================================
+bool SymmetricEigen( const Matrix& A, Matrix& d, Matrix& Q )
+{
+   // Validate the arguments.
+   assert(isSquare(A));
+
+   // Define local constants.
+   const int N = A.nRows();
+   const int MAXIMUM_ITERATIONS = 60;
+   const double EPSILON = std::numeric_limits<double>::epsilon();
+
+   d.Resize(N, 1);
+   Q.Resize(N, N);
+   Matrix e(N, 1);
+
+   for (int i = 0; i < N; ++i)
+      for (int j = 0; j <= i; ++j)
+         Q(i,j) = A(i,j);
+
+   // Householder reduction to tridiagonal form.
+   for (int j = 0; j < N; ++j)
+      d(j,0) = Q(N-1,j);
+
+   for (int i = N-1; i > 0; --i) {
+      double scale = 0.0;
+      double h = 0.0;
+      for (int k = 0; k < i; ++k)
+         scale += fabs(d(k,0));
+
+      if (scale <= 0.0) {
+         e(i,0) = d(i-1,0);
+         for (int j = 0; j < i; ++j) {
+            d(j,0) = Q(i-1,j);
+            Q(i,j) = 0.0;
+            Q(j,i) = 0.0;
+         }
+      }
+      else {
+         // Generate the Householder vector.
+         for (int k = 0; k < i; ++k) {
+            d(k,0) /= scale;
+            h += d(k,0) * d(k,0);
+         }
+
+         double f = d(i-1,0);
+         double g = (f > 0 ? -sqrt(h) : sqrt(h));
+         e(i,0) = scale * g;
+         h -= f * g;
+         d(i-1,0) = f - g;
+
+         for (int j = 0; j < i; ++j)
+            e(j,0) = 0.0;
+
+         // Apply the similarity transformation to the remaining columns.
+         for (int j = 0; j < i; ++j) {
+            f = d(j,0);
+            Q(j,i) = f;
+            g = e(j,0) + Q(j,j) * f;
+            for (int k = j+1; k <= i-1; ++k) {
+               g += Q(k,j) * d(k,0);
+               e(k,0) += Q(k,j) * f;
+            }
+            e(j,0) = g;
+         }
+
+         f = 0.0;
+         for (int j = 0; j < i; ++j) {
+            e(j,0) /= h;
+            f += e(j,0) * d(j,0);
+         }
+
+         double hh = f / (h + h);
+         for (int j = 0; j < i; ++j)
+            e(j,0) -= hh * d(j,0);
+
+         for (int j = 0; j < i; ++j) {
+            f = d(j,0);
+            g = e(j,0);
+            for (int k = j; k <= i-1; ++k)
+               Q(k,j) -= (f * e(k,0) + g * d(k,0));
+            d(j,0) = Q(i-1,j);
+            Q(i,j) = 0.0;
+         }
+      }
+      d(i,0) = h;
+   }
+
+   // Accumulate the transformations.
+   for (int i = 0; i < N-1; ++i) {
+      Q(N-1,i) = Q(i,i);
+      Q(i,i) = 1.0;
+
+      double h = d(i+1,0);
+      if (fabs(h) > 0.0) {
+         for (int k = 0; k <= i; ++k)
+            d(k,0) = Q(k,i+1) / h;
+
+         for (int j = 0; j <= i; ++j) {
+            double g = 0.0;
+            for (int k = 0; k <= i; ++k)
+               g += Q(k,i+1) * Q(k,j);
+            for (int k = 0; k <= i; ++k)
+               Q(k,j) -= g * d(k,0);
+         }
+      }
+      for (int k = 0; k <= i; ++k)
+         Q(k,i+1) = 0.0;
+   }
+
+   for (int j = 0; j < N; ++j) {
+      d(j,0) = Q(N-1,j);
+      Q(N-1,j) = 0.0;
+   }
+   Q(N-1,N-1) = 1.0;
+   e(0,0) = 0.0;
+
+   // Implicit QL iterations on the tridiagonal Matrix.
+   for (int i = 1; i < N; ++i)
+      e(i-1,0) = e(i,0);
+   e(N-1,0) = 0.0;
+
+   double f = 0.0;
+   double tst1 = 0.0;
+
+   for (int l = 0; l < N; ++l) {
+      // Find a small subdiagonal element.
+      tst1 = std::max( tst1, fabs(d(l,0)) + fabs(e(l,0)) );
+
+      int m = l;
+      while (m < N-1 && fabs(e(m,0)) > EPSILON*tst1)
+         ++m;
+
+      // If m == l, d(l) is already an eigenvalue; otherwise, iterate.
+      if (m > l) {
+         int iter = 0;
+         do {
+            if (++iter > MAXIMUM_ITERATIONS) return false;
+
+            // Compute the implicit shift.
+            double g = d(l,0);
+            double p = (d(l+1,0) - g) / (2.0 * e(l,0));
+            double r = hypot(p, 1.0);
+            if (p < 0) r = -r;
+
+            d(l,0) = e(l,0) / (p + r);
+            d(l+1,0) = e(l,0) * (p + r);
+            double dl1 = d(l+1,0);
+            double h = g - d(l,0);
+            for (int i = l+2; i < N; ++i)
+               d(i,0) -= h;
+            f += h;
+
+            // Implicit QL transformation.
+            p = d(m,0);
+            double c = 1.0, c2 = 1.0, c3 = 1.0;
+            double el1 = e(l+1,0);
+            double s = 0.0, s2 = 0.0;
+
+            for (int i = m-1; i >= l; --i) {
+               c3 = c2;
+               c2 = c;
+               s2 = s;
+               g = c * e(i,0);
+               h = c * p;
+               r = hypot(p, e(i,0));
+               e(i+1,0) = s * r;
+               s = e(i,0) / r;
+               c = p / r;
+               p = c * d(i,0) - s * g;
+               d(i+1,0) = h + s * (c * g + s * d(i,0));
+
+               // Accumulate the rotation.
+               for (int k = 0; k < N; ++k) {
+                  h = Q(k,i+1);
+                  Q(k,i+1) = s * Q(k,i) + c * h;
+                  Q(k,i) = c * Q(k,i) - s * h;
+               }
+            }
+            p = -s * s2 * c3 * el1 * e(l,0) / dl1;
+            e(l,0) = s * p;
+            d(l,0) = c * p;
+
+         } while (fabs(e(l,0)) > EPSILON*tst1);
+      }
+      d(l,0) += f;
+      e(l,0) = 0.0;
+   }
+
+   // Sort the eigenvalues and the corresponding eigenvectors.
+   for (int i = 0; i < N-1; ++i) {
+      int k = i;
+      for (int j = i+1; j < N; ++j)
+         if (d(j,0) < d(k,0)) k = j;
+
+      if (k != i) {
+         std::swap( d(k,0), d(i,0) );
+         for (int j = 0; j < N; ++j)
+            std::swap( Q(j,i), Q(j,k) );
+      }
+   }
+   return true;
+}
+
 //=============================================================================
 // AffineTransformation
 //
@@ -7,24 +7,32 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #ifndef LINEAR_SYSTEMS_H
 #define LINEAR_SYSTEMS_H
 
 #include "matrix.h"
+#include "packed_matrix.h"
 
 
 //=============================================================================
 //
 //=============================================================================
+bool CholeskyDecomposition( const PackedMatrix& A, PackedMatrix& L );
+void CholeskySolve( const PackedMatrix& L, const Matrix& b, Matrix& x );
+void CholeskyInverse( const PackedMatrix& L, PackedMatrix& Ainv );
+bool RSPDInv( const PackedMatrix& A, PackedMatrix& Ainv );
+
 bool CholeskyDecomposition( const Matrix& A, Matrix& L );
 void CholeskySolve( const Matrix& L, const Matrix& b, Matrix& x );
 void CholeskyInverse( const Matrix& L, Matrix& Ainv );
-
 bool RSPDInv( const Matrix& A, Matrix& Ainv );
+
 bool LeastSquaresSolve( const Matrix& A, const Matrix& B, Matrix& X );
 
+bool SymmetricEigen( const Matrix& A, Matrix& d, Matrix& Q );
+
 void AffineTransformation( const Matrix& A, const Matrix& B, const Matrix& C, Matrix& D );
 
 
@@ -9,21 +9,792 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <iostream>
+#include <sstream>
 
 #include "engine.h"
 #include "now.h"
 #include "numerical_constants.h"
 #include "read_obs.h"
+#include "read_params.h"
 #include "read_targets.h"
+#include "server.h"
 #include "version.h"
+#include "weight_operator.h"
 #include "write_results.h"
 
 
+namespace{
+   //--------------------------------------------------------------------------
+   // Get and check a strictly positive command line argument.
+   //--------------------------------------------------------------------------
+   bool GetPositive( const char* arg, const char* name, double& value )
+   {
+      value = atof( arg );
+      if ( value <= EPS ) {
+         std::cerr << "ERROR: " << name << " = " << arg << " is not valid;  0 < " << name << "." << std::endl;
+         std::cerr << std::endl;
+         Usage();
+         return false;
+      }
+      return true;
+   }
+
+   //--------------------------------------------------------------------------
+   // Get and check the semi-variogram nugget effect, sill, and range.
+   //--------------------------------------------------------------------------
+   bool GetVariogram( char* argv[], double& nugget, double& sill, double& range )
+   {
+      return GetPositive( argv[0], "nugget", nugget ) &&
+             GetPositive( argv[1], "sill", sill ) &&
+             GetPositive( argv[2], "range", range );
+   }
+
+   //--------------------------------------------------------------------------
+   // Get and check a list of increasing numbers separated by commas, as in
+   // 90,95,100.
+   //--------------------------------------------------------------------------
+   bool GetList( const char* arg, const char* name, std::vector<double>& values )
+   {
+      values.clear();
+      const char* p = arg;
+      for (;;) {
+         char* end;
+         const double t = strtod( p, &end );
+         if ( end == p || (*end != ',' && *end != '\0') || (!values.empty() && t <= values.back()) ) {
+            std::cerr << "ERROR: " << name << " = " << arg << " is not valid;  increasing numbers separated by commas." << std::endl;
+            std::cerr << std::endl;
+            Usage();
+            return false;
+         }
+         values.push_back( t );
+         if ( *end == '\0' ) break;
+         p = end + 1;
+      }
+      return true;
+   }
+
+   //--------------------------------------------------------------------------
+   // Read in the observation data from the specified file.
+   //--------------------------------------------------------------------------
+   bool GetObs( const char* filename, std::vector<ObsRecord>& obs, std::ostream& ost = std::cout )
+   {
+      try {
+         obs = read_obs( filename );
+         ost << obs.size() << " data records read from <" << filename << ">." << std::endl;
+      }
+      catch (InvalidObsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return false;
+      }
+      catch (InvalidObsRecord& e) {
+         std::cerr << e.what() << std::endl;
+         return false;
+      }
+      return true;
+   }
+
+   //--------------------------------------------------------------------------
+   // Read in the observation data, with any number of value columns, from
+   // the specified file.
+   //--------------------------------------------------------------------------
+   bool GetObs( const char* filename, std::vector<ObsRecord>& obs, std::vector< std::vector<double> >& values )
+   {
+      try {
+         obs = read_obs( filename, values );
+         std::cout << obs.size() << " data records read from <" << filename << ">." << std::endl;
+      }
+      catch (InvalidObsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return false;
+      }
+      catch (InvalidObsRecord& e) {
+         std::cerr << e.what() << std::endl;
+         return false;
+      }
+      return true;
+   }
+
+   //--------------------------------------------------------------------------
+   // Read in the target data from the specified input data file.
+   //--------------------------------------------------------------------------
+   bool GetTargets( const char* filename, std::vector<TargetRecord>& targets )
+   {
+      try {
+         targets = read_targets( filename );
+         std::cout << targets.size() << " target locations read from <" << filename << ">." << std::endl;
+      }
+      catch (InvalidTargetsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return false;
+      }
+      catch (InvalidTargetRecord& e) {
+         std::cerr << e.what() << std::endl;
+         return false;
+      }
+      return true;
+   }
+
+   //--------------------------------------------------------------------------
+   // Read in the semi-variogram parameter sets from the specified file.
+   //--------------------------------------------------------------------------
+   bool GetParams( const char* filename, std::vector<ParamsRecord>& params )
+   {
+      try {
+         params = read_params( filename );
+         std::cout << params.size() << " parameter sets read from <" << filename << ">." << std::endl;
+      }
+      catch (InvalidParamsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return false;
+      }
+      catch (InvalidParamsRecord& e) {
+         std::cerr << e.what() << std::endl;
+         return false;
+      }
+      return true;
+   }
+
+   //--------------------------------------------------------------------------
+   // Report the elapsed time.
+   //--------------------------------------------------------------------------
+   void Elapsed()
+   {
+      double elapsed = static_cast<double>(clock())/CLOCKS_PER_SEC;
+      std::cout << "elapsed time: " << std::fixed << elapsed << " seconds." << std::endl;
+      std::cout << std::endl;
+   }
+
+   //--------------------------------------------------------------------------
+   // Outlier detection:
+   //
+   //    Mizhodan --outliers <nugget> <sill> <range> <alpha> <obs file> <outliers file>
+   //--------------------------------------------------------------------------
+   int Outliers( char* argv[] )
+   {
+      // Get and check the semi-variogram parameters.
+      double nugget, sill, range;
+      if ( !GetVariogram( argv+2, nugget, sill, range ) ) return 2;
+
+      // Get and check the significance level.
+      double alpha = atof( argv[5] );
+      if ( alpha <= EPS || alpha >= 1.0 ) {
+         std::cerr << "ERROR: alpha = " << argv[5] << " is not valid;  0 < alpha < 1." << std::endl;
+         std::cerr << std::endl;
+         Usage();
+         return 2;
+      }
+
+      // Read in the observation data from the specified file.
+      std::vector<ObsRecord> obs;
+      if ( !GetObs( argv[6], obs ) ) return 3;
+
+      // Execute all of the computations.
+      std::vector<Outlier> outliers;
+      try {
+         outliers = Aakozi_Engine(nugget, sill, range, obs, alpha);
+         std::cout << outliers.size() << " outliers identified." << std::endl;
+      }
+      catch (TooFewObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooManyObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (CholeskyDecompositionFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (...) {
+         std::cerr << "The Mizhodan Engine failed for an unknown reason." << std::endl;
+         throw;
+      }
+
+      // Write out the outliers to the specified output data file.
+      try {
+         write_outliers( argv[7], obs, outliers );
+         std::cout << "Outliers file <" << argv[7] << "> created. " << std::endl;
+      }
+      catch (InvalidResultsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 5;
+      }
+
+      Elapsed();
+      return 0;
+   }
+
+   //--------------------------------------------------------------------------
+   // Parameter sweep:
+   //
+   //    Mizhodan --sweep <params file> <obs file> <targets file> <results file> <scores file>
+   //--------------------------------------------------------------------------
+   int Sweep( char* argv[] )
+   {
+      // Read in the input data from the specified files.
+      std::vector<ParamsRecord> params;
+      if ( !GetParams( argv[2], params ) ) return 3;
+
+      std::vector<ObsRecord> obs;
+      if ( !GetObs( argv[3], obs ) ) return 3;
+
+      std::vector<TargetRecord> targets;
+      if ( !GetTargets( argv[4], targets ) ) return 3;
+
+      // Execute all of the computations.
+      std::vector<SweepRecord> sweep;
+      try {
+         sweep = Sweep_Engine(params, obs, targets);
+      }
+      catch (NoParametersSpecified& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (NoTargetsSpecified& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooFewObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooManyObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (CholeskyDecompositionFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (...) {
+         std::cerr << "The Mizhodan Engine failed for an unknown reason." << std::endl;
+         throw;
+      }
+
+      // Report the parameter set with the smallest cross validation RMSE.
+      unsigned best = 0;
+      for (unsigned p = 1; p < sweep.size(); ++p)
+         if (sweep[p].rmse < sweep[best].rmse) best = p;
+
+      std::cout << "best parameter set: " << best+1
+                << " (nugget = " << sweep[best].params.nugget
+                << ", sill = " << sweep[best].params.sill
+                << ", range = " << sweep[best].params.range
+                << ", rmse = " << sweep[best].rmse << ")." << std::endl;
+
+      // Write out the results and the scores to the specified files.
+      try {
+         write_sweep( argv[5], sweep );
+         std::cout << "Results file <" << argv[5] << "> created. " << std::endl;
+
+         write_scores( argv[6], sweep );
+         std::cout << "Scores file <" << argv[6] << "> created. " << std::endl;
+      }
+      catch (InvalidResultsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 5;
+      }
+
+      Elapsed();
+      return 0;
+   }
+
+   //--------------------------------------------------------------------------
+   // Global Kriging for large data sets:
+   //
+   //    Mizhodan --hmatrix <tolerance> <nugget> <sill> <range> <obs file> <targets file> <results file>
+   //    Mizhodan --taper <taper> <nugget> <sill> <range> <obs file> <targets file> <results file>
+   //    Mizhodan --mixed <tolerance> <nugget> <sill> <range> <obs file> <targets file> <results file>
+   //    Mizhodan --local <neighbors> <nugget> <sill> <range> <obs file> <targets file> <results file>
+   //--------------------------------------------------------------------------
+   int Global( char* argv[] )
+   {
+      const bool taper = ( strcmp(argv[1], "--taper") == 0 );
+      const bool mixed = ( strcmp(argv[1], "--mixed") == 0 );
+      const bool local = ( strcmp(argv[1], "--local") == 0 );
+
+      // Get and check the accuracy tolerance, the taper range, or the
+      // number of neighbors.
+      double tolerance = atof( argv[2] );
+      int neighbors = atoi( argv[2] );
+      if ( taper ) {
+         if ( !GetPositive( argv[2], "taper", tolerance ) ) return 2;
+      }
+      else if ( local ) {
+         if ( neighbors < 1 || neighbors > MAXIMUM_NEIGHBORS ) {
+            std::cerr << "ERROR: neighbors = " << argv[2] << " is not valid;  1 <= neighbors <= " << MAXIMUM_NEIGHBORS << "." << std::endl;
+            std::cerr << std::endl;
+            Usage();
+            return 2;
+         }
+      }
+      else if ( tolerance <= 0.0 || tolerance >= 1.0 ) {
+         std::cerr << "ERROR: tolerance = " << argv[2] << " is not valid;  0 < tolerance < 1." << std::endl;
+         std::cerr << std::endl;
+         Usage();
+         return 2;
+      }
+
+      // Get and check the semi-variogram parameters.
+      double nugget, sill, range;
+      if ( !GetVariogram( argv+3, nugget, sill, range ) ) return 2;
+
+      // Read in the input data from the specified files.
+      std::vector<ObsRecord> obs;
+      if ( !GetObs( argv[6], obs ) ) return 3;
+
+      std::vector<TargetRecord> targets;
+      if ( !GetTargets( argv[7], targets ) ) return 3;
+
+      // Execute all of the computations.
+      std::vector<ResultRecord> results;
+      CacheRecord cache = { 0, 0 };
+      try {
+         if ( taper )
+            results = Tapered_Engine(nugget, sill, range, obs, targets, tolerance);
+         else if ( mixed )
+            results = Mixed_Engine(nugget, sill, range, obs, targets, tolerance);
+         else if ( local )
+            results = Local_Engine(nugget, sill, range, obs, targets, neighbors, &cache);
+         else
+            results = Hierarchical_Engine(nugget, sill, range, obs, targets, tolerance);
+      }
+      catch (NoTargetsSpecified& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooFewObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooManyObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (CholeskyDecompositionFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (...) {
+         std::cerr << "The Mizhodan Engine failed for an unknown reason." << std::endl;
+         throw;
+      }
+
+      // Write out the results to the specified output data file.
+      try {
+         write_results( argv[8], results );
+         std::cout << "Results file <" << argv[8] << "> created. " << std::endl;
+      }
+      catch (InvalidResultsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 5;
+      }
+
+      if ( local && cache.lookups > 0 ) {
+         std::cout << "Neighborhood cache: " << cache.hits << " hits in " << cache.lookups << " lookups ("
+                   << static_cast<int>( 100.0*cache.hits/cache.lookups + 0.5 ) << "%)." << std::endl;
+      }
+
+      Elapsed();
+      return 0;
+   }
+
+   //--------------------------------------------------------------------------
+   // Persisted weights:
+   //
+   //    Mizhodan --weights <keep> <nugget> <sill> <range> <obs file> <targets file> <weights file>
+   //--------------------------------------------------------------------------
+   int Weights( char* argv[] )
+   {
+      // Get and check the number of weights kept for each target.
+      char* end;
+      const long keep = strtol( argv[2], &end, 10 );
+      if ( *end != '\0' || keep < 0 ) {
+         std::cerr << "ERROR: keep = " << argv[2] << " is not valid;  0 <= keep." << std::endl;
+         std::cerr << std::endl;
+         Usage();
+         return 2;
+      }
+
+      // Get and check the semi-variogram parameters.
+      double nugget, sill, range;
+      if ( !GetVariogram( argv+3, nugget, sill, range ) ) return 2;
+
+      // Read in the input data from the specified files. The locations are
+      // read exactly as --apply will read them; the values are not needed.
+      std::vector<ObsRecord> obs;
+      std::vector< std::vector<double> > values;
+      if ( !GetObs( argv[6], obs, values ) ) return 3;
+
+      std::vector<TargetRecord> targets;
+      if ( !GetTargets( argv[7], targets ) ) return 3;
+
+      // Compute the weights.
+      WeightOperator W;
+      try {
+         Weight_Engine(nugget, sill, range, obs, targets, keep, W);
+      }
+      catch (NoTargetsSpecified& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooFewObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooManyObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (CholeskyDecompositionFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (...) {
+         std::cerr << "The Mizhodan Engine failed for an unknown reason." << std::endl;
+         throw;
+      }
+
+      // Write out the weights.
+      try {
+         W.Save( argv[8] );
+         std::cout << "Weights file <" << argv[8] << "> created with " << W.nWeights() << " weights per target. " << std::endl;
+      }
+      catch (InvalidWeightsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 5;
+      }
+
+      Elapsed();
+      return 0;
+   }
+
+   //--------------------------------------------------------------------------
+   // Apply persisted weights to new values:
+   //
+   //    Mizhodan --apply <weights file> <obs file> <results file>
+   //--------------------------------------------------------------------------
+   int Apply( char* argv[] )
+   {
+      // Read in the weights.
+      WeightOperator W;
+      try {
+         W.Load( argv[2] );
+         std::cout << W.nTargets() << " targets read from <" << argv[2] << ">." << std::endl;
+      }
+      catch (InvalidWeightsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 3;
+      }
+
+      // Read in the observation data. Every value column is a separate
+      // variable.
+      std::vector<ObsRecord> obs;
+      std::vector< std::vector<double> > values;
+      if ( !GetObs( argv[3], obs, values ) ) return 3;
+
+      const int P = values.empty() ? 1 : values[0].size();
+      Matrix Z( obs.size(), P );
+      for ( unsigned n = 0; n < obs.size(); ++n )
+         for ( int p = 0; p < P; ++p )
+            Z(n,p) = values[n][p];
+
+      // Apply the weights.
+      std::vector<ResultRecord> results;
+      Matrix Zhat;
+      try {
+         results = W.Apply( obs, Z, Zhat );
+      }
+      catch (ObservationMismatch& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+
+      // Write out the results to the specified output data file.
+      try {
+         if ( P > 1 )
+            write_results( argv[4], results, Zhat );
+         else
+            write_results( argv[4], results );
+         std::cout << "Results file <" << argv[4] << "> created. " << std::endl;
+      }
+      catch (InvalidResultsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 5;
+      }
+
+      Elapsed();
+      return 0;
+   }
+
+   //--------------------------------------------------------------------------
+   // Median indicator Kriging:
+   //
+   //    Mizhodan --indicator-thresholds <thresholds> <nugget> <sill> <range> <obs file> <targets file> <results file>
+   //
+   // The <thresholds> are one argument: increasing numbers separated by
+   // commas, as in 90,95,100.
+   //--------------------------------------------------------------------------
+   int Indicator( char* argv[] )
+   {
+      // Get and check the thresholds.
+      std::vector<double> thresholds;
+      if ( !GetList( argv[2], "thresholds", thresholds ) ) return 2;
+
+      // Get and check the semi-variogram parameters.
+      double nugget, sill, range;
+      if ( !GetVariogram( argv+3, nugget, sill, range ) ) return 2;
+
+      // Read in the input data from the specified files.
+      std::vector<ObsRecord> obs;
+      if ( !GetObs( argv[6], obs ) ) return 3;
+
+      std::vector<TargetRecord> targets;
+      if ( !GetTargets( argv[7], targets ) ) return 3;
+
+      // Execute all of the computations.
+      std::vector<ResultRecord> results;
+      Matrix F;
+      try {
+         results = Indicator_Engine(nugget, sill, range, obs, thresholds, targets, F);
+      }
+      catch (NoTargetsSpecified& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooFewObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooManyObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (CholeskyDecompositionFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (...) {
+         std::cerr << "The Mizhodan Engine failed for an unknown reason." << std::endl;
+         throw;
+      }
+
+      // Write out the ccdfs to the specified output data file.
+      try {
+         write_ccdf( argv[8], results, thresholds, F );
+         std::cout << "Results file <" << argv[8] << "> created. " << std::endl;
+      }
+      catch (InvalidResultsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 5;
+      }
+
+      Elapsed();
+      return 0;
+   }
+
+   //--------------------------------------------------------------------------
+   // Exceedance probabilities and quantiles:
+   //
+   //    Mizhodan --exceedance <thresholds> <nugget> <sill> <range> <obs file> <targets file> <results file>
+   //    Mizhodan --quantiles <probabilities> <nugget> <sill> <range> <obs file> <targets file> <results file>
+   //--------------------------------------------------------------------------
+   int Probability( char* argv[] )
+   {
+      const bool quantiles = ( strcmp(argv[1], "--quantiles") == 0 );
+
+      // Get and check the thresholds or the probabilities.
+      std::vector<double> levels;
+      if ( !GetList( argv[2], quantiles ? "probabilities" : "thresholds", levels ) ) return 2;
+      if ( quantiles && (levels.front() <= 0.0 || levels.back() >= 1.0) ) {
+         std::cerr << "ERROR: probabilities = " << argv[2] << " is not valid;  0 < probability < 1." << std::endl;
+         std::cerr << std::endl;
+         Usage();
+         return 2;
+      }
+
+      // Get and check the semi-variogram parameters.
+      double nugget, sill, range;
+      if ( !GetVariogram( argv+3, nugget, sill, range ) ) return 2;
+
+      // Read in the input data from the specified files.
+      std::vector<ObsRecord> obs;
+      if ( !GetObs( argv[6], obs ) ) return 3;
+
+      std::vector<TargetRecord> targets;
+      if ( !GetTargets( argv[7], targets ) ) return 3;
+
+      // Execute all of the computations.
+      std::vector<ResultRecord> results;
+      try {
+         results = Engine(nugget, sill, range, obs, targets);
+      }
+      catch (NoTargetsSpecified& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooFewObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooManyObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (IterativeSolverFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (CholeskyDecompositionFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (...) {
+         std::cerr << "The Mizhodan Engine failed for an unknown reason." << std::endl;
+         throw;
+      }
+
+      Matrix columns;
+      std::vector<std::string> titles;
+      for ( unsigned k = 0; k < levels.size(); ++k ) {
+         std::stringstream title;
+         title << (quantiles ? "Q(" : "P(Z>") << levels[k] << ')';
+         titles.push_back( title.str() );
+      }
+      if ( quantiles )
+         Quantiles( results, levels, columns );
+      else
+         Exceedance( results, levels, columns );
+
+      // Write out the results to the specified output data file.
+      try {
+         write_results( argv[8], results, titles, columns );
+         std::cout << "Results file <" << argv[8] << "> created. " << std::endl;
+      }
+      catch (InvalidResultsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 5;
+      }
+
+      Elapsed();
+      return 0;
+   }
+
+   //--------------------------------------------------------------------------
+   // Resident prediction server:
+   //
+   //    Mizhodan --serve <nugget> <sill> <range> <obs file>
+   //
+   // The queries are read from the standard input and answered on the
+   // standard output, so all of the messages go to the standard error.
+   //--------------------------------------------------------------------------
+   int Server( char* argv[] )
+   {
+      // Get and check the semi-variogram parameters.
+      double nugget, sill, range;
+      if ( !GetVariogram( argv+2, nugget, sill, range ) ) return 2;
+
+      // Read in the observation data from the specified file.
+      std::vector<ObsRecord> obs;
+      if ( !GetObs( argv[5], obs, std::cerr ) ) return 3;
+
+      // Factor the Kriging system once.
+      KrigingModel model( nugget, sill, range );
+      try {
+         model.Fit( obs );
+      }
+      catch (TooFewObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooManyObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (CholeskyDecompositionFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (...) {
+         std::cerr << "The Mizhodan Engine failed for an unknown reason." << std::endl;
+         throw;
+      }
+      std::cerr << "Ready for queries." << std::endl;
+
+      // Answer queries until the input ends.
+      LatencyCounter latency;
+      Serve( model, std::cin, std::cout, latency );
+
+      std::cerr << latency.Count() << " queries answered"
+                << " (p50 = " << latency.Percentile(50) << " us"
+                << ", p99 = " << latency.Percentile(99) << " us)." << std::endl;
+      return 0;
+   }
+
+   //--------------------------------------------------------------------------
+   // Parameter estimation:
+   //
+   //    Mizhodan --estimate <obs file> <params file>
+   //    Mizhodan --estimate-ml <obs file> <params file>
+   //--------------------------------------------------------------------------
+   int Estimate( char* argv[], bool reml )
+   {
+      // Read in the observation data from the specified file.
+      std::vector<ObsRecord> obs;
+      if ( !GetObs( argv[2], obs ) ) return 3;
+
+      // Execute all of the computations.
+      EstimateRecord estimate;
+      try {
+         estimate = Estimate_Engine(obs, reml);
+      }
+      catch (TooFewObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (TooManyObservations& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (EstimationFailed& e) {
+         std::cerr << e.what() << std::endl;
+         return 4;
+      }
+      catch (...) {
+         std::cerr << "The Mizhodan Engine failed for an unknown reason." << std::endl;
+         throw;
+      }
+
+      std::cout << (reml ? "REML" : "ML") << " estimate"
+                << " (nugget = " << estimate.params.nugget
+                << ", sill = " << estimate.params.sill
+                << ", range = " << estimate.params.range
+                << ", log likelihood = " << estimate.loglik
+                << ", iterations = " << estimate.iterations << ")." << std::endl;
+
+      // Write out the estimate to the specified params file.
+      try {
+         write_estimate( argv[3], estimate, reml );
+         std::cout << "Params file <" << argv[3] << "> created. " << std::endl;
+      }
+      catch (InvalidResultsFile& e) {
+         std::cerr << e.what() << std::endl;
+         return 5;
+      }
+
+      Elapsed();
+      return 0;
+   }
+}
+
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[]) {
    // Check the command line.
@@ -41,81 +812,119 @@ int main(int argc, char* argv[]) {
             Usage();
          return 0;
       }
+      case 4: {
+         if ( strcmp(argv[1], "--estimate") == 0 ) {
+            Banner( std::cout );
+            return Estimate( argv, true );
+         }
+         if ( strcmp(argv[1], "--estimate-ml") == 0 ) {
+            Banner( std::cout );
+            return Estimate( argv, false );
+         }
+         Usage();
+         return 1;
+      }
+      case 5: {
+         if ( strcmp(argv[1], "--apply") == 0 ) {
+            Banner( std::cout );
+            return Apply( argv );
+         }
+         Usage();
+         return 1;
+      }
+      case 6: {
+         if ( strcmp(argv[1], "--serve") == 0 ) {
+            Banner( std::cerr );
+            return Server( argv );
+         }
+         Usage();
+         return 1;
+      }
       case 7: {
          Banner( std::cout );
+         if ( strcmp(argv[1], "--sweep") == 0 )
+            return Sweep( argv );
          break;
       }
+      case 8: {
+         if ( strcmp(argv[1], "--outliers") == 0 ) {
+            Banner( std::cout );
+            return Outliers( argv );
+         }
+         Usage();
+         return 1;
+      }
+      case 9: {
+         if ( strcmp(argv[1], "--hmatrix") == 0 || strcmp(argv[1], "--taper") == 0 || strcmp(argv[1], "--mixed") == 0 || strcmp(argv[1], "--local") == 0 ) {
+            Banner( std::cout );
+            return Global( argv );
+         }
+         if ( strcmp(argv[1], "--indicator-thresholds") == 0 ) {
+            Banner( std::cout );
+            return Indicator( argv );
+         }
+         if ( strcmp(argv[1], "--exceedance") == 0 || strcmp(argv[1], "--quantiles") == 0 ) {
+            Banner( std::cout );
+            return Probability( argv );
+         }
+         if ( strcmp(argv[1], "--weights") == 0 ) {
+            Banner( std::cout );
+            return Weights( argv );
+         }
+         Usage();
+         return 1;
+      }
       default: {
          Usage();
          return 1;
       }
    }
 
-   // Get and check the semi-variogram nugget effect.
-   double nugget = atof( argv[1] );
-   if ( nugget <= EPS ) {
-      std::cerr << "ERROR: nugget = " << argv[1] << " is not valid;  0 < nugget." << std::endl;
-      std::cerr << std::endl;
-      Usage();
-      return 2;
-   }
-
-   // Get and check the semi-variogram sill.
-   double sill = atof( argv[2] );
-   if ( sill <= EPS ) {
-      std::cerr << "ERROR: sill = " << argv[2] << " is not valid;  0 < sill." << std::endl;
-      std::cerr << std::endl;
-      Usage();
-      return 2;
-   }
-
-   // Get and check the semi-variogram range.
-   double range = atof( argv[3] );
-   if ( range <= EPS ) {
-      std::cerr << "ERROR: range = " << argv[3] << " is not valid;  0 < range." << std::endl;
-      std::cerr << std::endl;
-      Usage();
-      return 2;
-   }
+   // Get and check the semi-variogram nugget effect, sill, and range.
+   double nugget, sill, range;
+   if ( !GetVariogram( argv+1, nugget, sill, range ) ) return 2;
 
-   // Read in the observation data from the specified file.
+   // Read in the observation data from the specified file. Every value
+   // column is a separate variable.
    std::vector<ObsRecord> obs;
+   std::vector< std::vector<double> > values;
+   if ( !GetObs( argv[4], obs, values ) ) return 3;
 
-   try {
-      obs = read_obs( argv[4] );
-      std::cout << obs.size() << " data records read from <" << argv[4] << ">." << std::endl;
-   }
-   catch (InvalidObsFile& e) {
-      std::cerr << e.what() << std::endl;
-      return 3;
-   }
-   catch (InvalidObsRecord& e) {
-      std::cerr << e.what() << std::endl;
-      return 3;
-   }
+   const int P = values.empty() ? 1 : values[0].size();
+   if ( P > 1 )
+      std::cout << P << " variables to be kriged together." << std::endl;
 
    // Read in the target data from the specified input data file.
    std::vector<TargetRecord> targets;
+   if ( !GetTargets( argv[5], targets ) ) return 3;
 
+   // Execute all of the computations.
+   std::vector<ResultRecord> results;
+   Matrix Zhat;
    try {
-      targets = read_targets( argv[5] );
-      std::cout << targets.size() << " target locations read from <" << argv[5] << ">." << std::endl;
+      if ( P > 1 ) {
+         Matrix Z( obs.size(), P );
+         for ( unsigned n = 0; n < obs.size(); ++n )
+            for ( int p = 0; p < P; ++p )
+               Z(n,p) = values[n][p];
+         results = Engine(nugget, sill, range, obs, Z, targets, Zhat);
+      }
+      else
+         results = Engine(nugget, sill, range, obs, targets);
    }
-   catch (InvalidTargetsFile& e) {
+   catch (NoTargetsSpecified& e) {
       std::cerr << e.what() << std::endl;
-      return 3;
+      return 4;
    }
-   catch (InvalidTargetRecord& e) {
+   catch (TooFewObservations& e) {
       std::cerr << e.what() << std::endl;
-      return 3;
+      return 4;
    }
-
-   // Execute all of the computations.
-   std::vector<ResultRecord> results;
-   try {
-       results = Engine(nugget, sill, range, obs, targets);
+   catch (TooManyObservations& e) {
+      std::cerr << e.what() << std::endl;
+      return 4;
    }
-   catch (NoTargetsSpecified& e) {
+   catch (IterativeSolverFailed& e) {
       std::cerr << e.what() << std::endl;
       return 4;
    }
@@ -130,7 +939,10 @@ int main(int argc, char* argv[]) {
 
    // Write out the results to the specified output data file.
    try {
-      write_results( argv[6], results );
+      if ( P > 1 )
+         write_results( argv[6], results, Zhat );
+      else
+         write_results( argv[6], results );
       std::cout << "Results file <" << argv[6] << "> created. " << std::endl;
    }
    catch (InvalidResultsFile& e) {
@@ -139,9 +951,7 @@ int main(int argc, char* argv[]) {
    }
 
    // Successful termination.
-   double elapsed = static_cast<double>(clock())/CLOCKS_PER_SEC;
-   std::cout << "elapsed time: " << std::fixed << elapsed << " seconds." << std::endl;
-   std::cout << std::endl;
+   Elapsed();
 
    // Terminate execution.
 	return 0;
@@ -11,21 +11,123 @@
 //    University of Minnesota
 //
 // version:
-//    2 July 2017
+//    18 October 2026
 //=============================================================================
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <new>
 #include <numeric>
 #include <sstream>
+#include <utility>
 #include <vector>
 
+#include "gemm.h"
 #include "matrix.h"
 #include "sum_product-inl.h"
 
+namespace{
+   // The number of arrays allocated by all Matrices.
+   std::atomic<long> AllocationCount( 0 );
+
+   // Manifest constants for the storage pool.
+   const int ALIGNMENT = 64;                  // bytes; one cache line
+   const int SMALLEST_CLASS = 3;              // 2^3 doubles = 64 bytes
+   const int LARGEST_CLASS = 17;              // 2^17 doubles = 1 MiB
+   const int POOL_DEPTH = 8;                  // cached arrays per size class
+
+   //--------------------------------------------------------------------------
+   // Allocate, and free, an array of n doubles aligned on an ALIGNMENT byte
+   // boundary. The address returned by malloc is kept just before the
+   // aligned array.
+   //--------------------------------------------------------------------------
+   double* AlignedAllocate( std::size_t n )
+   {
+      void* raw = malloc( n*sizeof(double) + ALIGNMENT + sizeof(void*) );
+      if (raw == nullptr) throw std::bad_alloc();
+
+      std::uintptr_t p = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+      p = (p + ALIGNMENT-1) & ~static_cast<std::uintptr_t>(ALIGNMENT-1);
+
+      reinterpret_cast<void**>(p)[-1] = raw;
+      return reinterpret_cast<double*>(p);
+   }
+
+   void AlignedFree( double* p )
+   {
+      if (p != nullptr) free( reinterpret_cast<void**>(p)[-1] );
+   }
+
+   //--------------------------------------------------------------------------
+   // The size class of an array of n doubles: the smallest c such that
+   // 2^c >= n, or -1 if the array is too large to pool.
+   //--------------------------------------------------------------------------
+   int SizeClass( int n )
+   {
+      int c = SMALLEST_CLASS;
+      while ((1 << c) < n) {
+         if (++c > LARGEST_CLASS) return -1;
+      }
+      return c;
+   }
+
+   //--------------------------------------------------------------------------
+   // A per-thread cache of freed arrays, by size class.
+   //
+   // o  Each thread has its own pool, so no locking is needed. An array may
+   //    be freed by a different thread than allocated it; it simply joins
+   //    the freeing thread's pool.
+   //
+   // o  At most POOL_DEPTH arrays are kept in each class, so a thread never
+   //    holds more than about 2*POOL_DEPTH MiB of idle storage.
+   //--------------------------------------------------------------------------
+   class StoragePool
+   {
+   public:
+      StoragePool()
+      {
+         for (int c = 0; c <= LARGEST_CLASS; ++c)
+            m_Count[c] = 0;
+      }
+
+      ~StoragePool()
+      {
+         for (int c = 0; c <= LARGEST_CLASS; ++c)
+            while (m_Count[c] > 0)
+               AlignedFree( m_Free[c][--m_Count[c]] );
+      }
+
+      double* Get( int n )
+      {
+         int c = SizeClass(n);
+         if (c < 0) return AlignedAllocate(n);
+         if (m_Count[c] > 0) return m_Free[c][--m_Count[c]];
+         return AlignedAllocate( std::size_t(1) << c );
+      }
+
+      void Put( double* p, int n )
+      {
+         int c = SizeClass(n);
+         if (c >= 0 && m_Count[c] < POOL_DEPTH)
+            m_Free[c][m_Count[c]++] = p;
+         else
+            AlignedFree(p);
+      }
+
+   private:
+      double* m_Free[LARGEST_CLASS+1][POOL_DEPTH];
+      int m_Count[LARGEST_CLASS+1];
+   };
+
+   thread_local StoragePool Pool;
+}
+
 //=============================================================================
 // Matrix
 //=============================================================================
@@ -51,11 +153,24 @@ Matrix::Matrix( const Matrix& A )
    if ( A.nRows() > 0 && A.nCols() > 0 ) {
       m_nRows = A.nRows();
       m_nCols = A.nCols();
-      m_Data  = new double[ m_nRows*m_nCols ];
+      m_Data  = Allocate( m_nRows*m_nCols );
       memcpy( m_Data, A.Base(), sizeof(double)*m_nRows*m_nCols );
    }
 }
 
+//-----------------------------------------------------------------------------
+// Move constructor. The storage of A is taken over, and A is left null.
+//-----------------------------------------------------------------------------
+Matrix::Matrix( Matrix&& A ) noexcept
+:  m_nRows( A.m_nRows ),
+   m_nCols( A.m_nCols ),
+   m_Data( A.m_Data )
+{
+   A.m_nRows = 0;
+   A.m_nCols = 0;
+   A.m_Data  = nullptr;
+}
+
 //-----------------------------------------------------------------------------
 // constructor from an std:vector
 //-----------------------------------------------------------------------------
@@ -67,7 +182,7 @@ Matrix::Matrix( const std::vector<double>v )
    if ( v.size() > 0 ) {
       m_nRows = v.size();
       m_nCols = 1;
-      m_Data  = new double[ m_nRows ];
+      m_Data  = Allocate( m_nRows );
 
       for (int k = 0; k < m_nRows; ++k)
          m_Data[k] = v[k];
@@ -86,8 +201,9 @@ Matrix::Matrix( int nrows, int ncols )
 
    m_nRows = nrows;
    m_nCols = ncols;
-   m_Data  = new double[ m_nRows*m_nCols ];
-   memset( m_Data, 0, sizeof(double)*m_nRows*m_nCols );
+   m_Data  = Allocate( m_nRows*m_nCols );
+   if ( m_nRows*m_nCols > 0 )
+      memset( m_Data, 0, sizeof(double)*m_nRows*m_nCols );
 }
 
 //-----------------------------------------------------------------------------
@@ -102,7 +218,7 @@ Matrix::Matrix( int nrows, int ncols, double a )
 
    m_nRows = nrows;
    m_nCols = ncols;
-   m_Data  = new double[ m_nRows*m_nCols ];
+   m_Data  = Allocate( m_nRows*m_nCols );
 
    for (int i = 0; i < nrows; ++i)
       for (int j = 0; j < ncols; ++j)
@@ -121,8 +237,9 @@ Matrix::Matrix( int nrows, int ncols, const double* data )
 
    m_nRows = nrows;
    m_nCols = ncols;
-   m_Data  = new double[ m_nRows*m_nCols ];
-   memcpy( m_Data, data, sizeof(double)*m_nRows*m_nCols );
+   m_Data  = Allocate( m_nRows*m_nCols );
+   if ( m_nRows*m_nCols > 0 )
+      memcpy( m_Data, data, sizeof(double)*m_nRows*m_nCols );
 }
 
 //-----------------------------------------------------------------------------
@@ -189,8 +306,9 @@ Matrix::Matrix( const std::string& str )
       if ( static_cast<int>(i->size()) > m_nCols) m_nCols = i->size();
    }
 
-   m_Data  = new double[ m_nRows*m_nCols ];
-   memset( m_Data, 0, sizeof(double)*m_nRows*m_nCols );
+   m_Data  = Allocate( m_nRows*m_nCols );
+   if ( m_nRows*m_nCols > 0 )
+      memset( m_Data, 0, sizeof(double)*m_nRows*m_nCols );
 
    for (std::vector<std::vector<double>>::const_iterator i = rows.begin(); i != rows.end(); ++i)
       for (std::vector<double>::const_iterator j = i->begin(); j != i->end(); ++j) {
@@ -204,7 +322,7 @@ Matrix::Matrix( const std::string& str )
 //-----------------------------------------------------------------------------
 Matrix::~Matrix()
 {
-   delete [] m_Data;
+   Release( m_Data, m_nRows*m_nCols );
 
    m_nRows = 0;
    m_nCols = 0;
@@ -217,18 +335,31 @@ Matrix::~Matrix()
 //    The resized Matrix is filled with zeros.
 //-----------------------------------------------------------------------------
 void Matrix::Resize( int nrows, int ncols )
+{
+   ResizeUninitialized( nrows, ncols );
+   if ( m_nRows*m_nCols > 0 )
+      memset( m_Data, 0, sizeof(double)*m_nRows*m_nCols );
+}
+
+//-----------------------------------------------------------------------------
+// Destructive resize, without the fill.
+//
+//    The contents of the resized Matrix are unspecified, so this is only
+//    for callers that immediately overwrite every element.
+//-----------------------------------------------------------------------------
+void Matrix::ResizeUninitialized( int nrows, int ncols )
 {
    // Check the arguments.
    assert( nrows >= 0 && ncols >= 0 );
 
    // Reallocate memory if necessary.
    if (m_nRows != nrows || m_nCols != ncols) {
-      delete [] m_Data;
+      Release( m_Data, m_nRows*m_nCols );
 
       if ( nrows > 0 && ncols > 0 ) {
          m_nRows = nrows;
          m_nCols = ncols;
-         m_Data  = new double[ m_nRows*m_nCols ];
+         m_Data  = Allocate( m_nRows*m_nCols );
       }
       else {
          m_nRows = 0;
@@ -236,8 +367,6 @@ void Matrix::Resize( int nrows, int ncols )
          m_Data  = nullptr;
       }
    }
-
-   memset( m_Data, 0, sizeof(double)*m_nRows*m_nCols );
 }
 
 //-----------------------------------------------------------------------------
@@ -249,7 +378,7 @@ Matrix& Matrix::operator=( const Matrix& A )
    if ( this == &A ) return *this;
 
    // Commensurate memory allocation.
-   Resize( A.nRows(), A.nCols() );
+   ResizeUninitialized( A.nRows(), A.nCols() );
 
    // Copy the data.
    if ( m_nRows*m_nCols > 0 )
@@ -258,6 +387,18 @@ Matrix& Matrix::operator=( const Matrix& A )
    return *this;
 }
 
+//-----------------------------------------------------------------------------
+// Move assignment operator. The storages are exchanged, so the old storage
+// of this Matrix is released when A is destroyed.
+//-----------------------------------------------------------------------------
+Matrix& Matrix::operator=( Matrix&& A ) noexcept
+{
+   std::swap( m_nRows, A.m_nRows );
+   std::swap( m_nCols, A.m_nCols );
+   std::swap( m_Data,  A.m_Data );
+   return *this;
+}
+
 //-----------------------------------------------------------------------------
 // Scalar assignment operator.
 //-----------------------------------------------------------------------------
@@ -345,6 +486,41 @@ double* Matrix::Base( int row, int col )
    return m_Data + row*m_nCols + col;
 }
 
+//-----------------------------------------------------------------------------
+// The number of arrays allocated by all Matrices since the program started.
+// Comparing counts before and after a computation shows how many temporary
+// Matrices it created.
+//-----------------------------------------------------------------------------
+long Matrix::Allocations()
+{
+   return AllocationCount;
+}
+
+//-----------------------------------------------------------------------------
+// Allocate an array of n doubles, counting the allocation.
+//
+//    The array is aligned on a 64 byte boundary, so that vector loads never
+//    straddle a cache line, and it comes from a per-thread pool of recently
+//    freed arrays of the same size class when possible, which saves the
+//    cost of the general purpose allocator for the many short-lived
+//    Matrices of the Kriging computations.
+//-----------------------------------------------------------------------------
+double* Matrix::Allocate( int n )
+{
+   if (n <= 0) return nullptr;
+
+   ++AllocationCount;
+   return Pool.Get(n);
+}
+
+//-----------------------------------------------------------------------------
+// Return an array of n doubles from Allocate.
+//-----------------------------------------------------------------------------
+void Matrix::Release( double* p, int n )
+{
+   if (p != nullptr) Pool.Put(p, n);
+}
+
 //-----------------------------------------------------------------------------
 // Read only STL-conforming begin() iterators.
 //-----------------------------------------------------------------------------
@@ -575,14 +751,15 @@ void Transpose( const Matrix& A, Matrix& C )
    assert( A.nCols() > 0 && A.nRows() > 0 );
 
    // Commensurate memory allocation.
-   Matrix At( A.nCols(), A.nRows() );
+   Matrix At;
+   At.ResizeUninitialized( A.nCols(), A.nRows() );
 
    // Set the transpose.
    for (int i = 0; i < A.nRows(); ++i)
       for (int j = 0; j < A.nCols(); ++j)
          At(j,i) = A(i,j);
 
-   C = At;
+   C = std::move(At);
 }
 
 //-----------------------------------------------------------------------------
@@ -593,7 +770,7 @@ void Negative( const Matrix& A, Matrix& C )
    // Check the arguments.
    assert( A.nCols() > 0 && A.nRows() > 0 );
 
-   C.Resize( A.nRows(), A.nCols() );
+   C.ResizeUninitialized( A.nRows(), A.nCols() );
    std::transform( A.begin(), A.end(), C.begin(), [](double a){return -(a);});
 }
 
@@ -677,15 +854,17 @@ void Add_aM( double a, const Matrix& A, Matrix& C )
    // Check the arguments.
    assert( A.nRows() > 0 && A.nCols() > 0 );
 
-   // Do the update:  C = aA
-   C = A;
-   double* p = C.Base();
+   // Commensurate memory allocation. C may be A itself.
+   if ( C.nRows() != A.nRows() || C.nCols() != A.nCols() )
+      C.ResizeUninitialized( A.nRows(), A.nCols() );
 
-   for (int i = 0; i < C.nRows(); ++i)
-      for (int j = 0; j < C.nCols(); ++j) {
-         (*p) = a+(*p);
-         ++p;
-      }
+   // Do the update:  C = a+A, in a single pass.
+   const double* p = A.Base();
+   double*       r = C.Base();
+
+   for (int i = 0; i < A.nRows(); ++i)
+      for (int j = 0; j < A.nCols(); ++j)
+         (*r++) = a + (*p++);
 }
 
 //-----------------------------------------------------------------------------
@@ -696,15 +875,17 @@ void Subtract_aM( double a, const Matrix& A, Matrix& C )
    // Check the arguments.
    assert( A.nRows() > 0 && A.nCols() > 0 );
 
-   // Do the update:  C = aA
-   C = A;
-   double* p = C.Base();
+   // Commensurate memory allocation. C may be A itself.
+   if ( C.nRows() != A.nRows() || C.nCols() != A.nCols() )
+      C.ResizeUninitialized( A.nRows(), A.nCols() );
 
-   for (int i = 0; i < C.nRows(); ++i)
-      for (int j = 0; j < C.nCols(); ++j) {
-         (*p) = a-(*p);
-         ++p;
-      }
+   // Do the update:  C = a-A, in a single pass.
+   const double* p = A.Base();
+   double*       r = C.Base();
+
+   for (int i = 0; i < A.nRows(); ++i)
+      for (int j = 0; j < A.nCols(); ++j)
+         (*r++) = a - (*p++);
 }
 
 //-----------------------------------------------------------------------------
@@ -715,15 +896,17 @@ void Multiply_aM( double a, const Matrix& A, Matrix& C )
    // Check the arguments.
    assert( A.nRows() > 0 && A.nCols() > 0 );
 
-   // Do the update:  C = aA
-   C = A;
-   double* p = C.Base();
+   // Commensurate memory allocation. C may be A itself.
+   if ( C.nRows() != A.nRows() || C.nCols() != A.nCols() )
+      C.ResizeUninitialized( A.nRows(), A.nCols() );
 
-   for (int i = 0; i < C.nRows(); ++i)
-      for (int j = 0; j < C.nCols(); ++j) {
-         (*p) = a*(*p);
-         ++p;
-      }
+   // Do the update:  C = a*A, in a single pass.
+   const double* p = A.Base();
+   double*       r = C.Base();
+
+   for (int i = 0; i < A.nRows(); ++i)
+      for (int j = 0; j < A.nCols(); ++j)
+         (*r++) = a * (*p++);
 }
 
 
@@ -741,8 +924,9 @@ void Add_MM( const Matrix& A, const Matrix& B, Matrix& C )
    assert( B.nRows() > 0 && B.nCols() > 0 );
    assert( A.nRows() == B.nRows() && A.nCols() == B.nCols() );
 
-   // Commensurate memory allocation.
-   C.Resize( A.nRows(), A.nCols() );
+   // Commensurate memory allocation. C may be A or B itself.
+   if ( C.nRows() != A.nRows() || C.nCols() != A.nCols() )
+      C.ResizeUninitialized( A.nRows(), A.nCols() );
 
    // Compute the Matrix addition:  C = A + B
    const double* p = A.Base();
@@ -764,8 +948,9 @@ void Subtract_MM( const Matrix& A, const Matrix& B, Matrix& C )
    assert( B.nRows() > 0 && B.nCols() > 0 );
    assert( A.nRows() == B.nRows() && A.nCols() == B.nCols() );
 
-   // Commensurate memory allocation.
-   C.Resize( A.nRows(), A.nCols() );
+   // Commensurate memory allocation. C may be A or B itself.
+   if ( C.nRows() != A.nRows() || C.nCols() != A.nCols() )
+      C.ResizeUninitialized( A.nRows(), A.nCols() );
 
    // Compute the Matrix subtraction:  C = A - B
    const double* p = A.Base();
@@ -780,6 +965,11 @@ void Subtract_MM( const Matrix& A, const Matrix& B, Matrix& C )
 
 //=============================================================================
 // Matrix/Matrix multiplication routines.
+//
+// All four are computed by the packed, cache-blocked Gemm, which handles
+// the transposes while packing, so the four variants run at the same
+// speed. The product is formed in a temporary and moved into C, so C may
+// be A or B itself.
 //=============================================================================
 
 //-----------------------------------------------------------------------------
@@ -793,14 +983,14 @@ void Multiply_MM( const Matrix& A, const Matrix& B, Matrix& C )
    assert( A.nCols() == B.nRows() );
 
    // Commensurate memory allocation.
-   Matrix AB( A.nRows(), B.nCols() );
+   Matrix AB;
+   AB.ResizeUninitialized( A.nRows(), B.nCols() );
 
    // Compute the Matrix product.
-   for (int i = 0; i < A.nRows(); ++i)
-      for (int j = 0; j < B.nCols(); ++j)
-         AB(i,j) = SumProduct( A.nCols(), A.Base(i,0), B.Base(0,j), B.nCols() );
+   Gemm( false, false, A.nRows(), B.nCols(), A.nCols(),
+         A.Base(), A.nCols(), B.Base(), B.nCols(), AB.Base(), AB.nCols() );
 
-   C = AB;
+   C = std::move(AB);
 }
 
 //-----------------------------------------------------------------------------
@@ -814,14 +1004,14 @@ void Multiply_MtM( const Matrix& A, const Matrix& B, Matrix& C )
    assert( A.nRows() == B.nRows() );
 
    // Commensurate memory allocation.
-   Matrix AtB( A.nCols(), B.nCols() );
+   Matrix AtB;
+   AtB.ResizeUninitialized( A.nCols(), B.nCols() );
 
    // Compute the Matrix product.
-   for (int i = 0; i < A.nCols(); ++i)
-      for (int j = 0; j < B.nCols(); ++j)
-         AtB(i,j) = SumProduct( A.nRows(), A.Base(0,i), A.nCols(), B.Base(0,j), B.nCols() );
+   Gemm( true, false, A.nCols(), B.nCols(), A.nRows(),
+         A.Base(), A.nCols(), B.Base(), B.nCols(), AtB.Base(), AtB.nCols() );
 
-   C = AtB;
+   C = std::move(AtB);
 }
 
 //-----------------------------------------------------------------------------
@@ -835,14 +1025,14 @@ void Multiply_MMt( const Matrix& A, const Matrix& B, Matrix& C )
    assert( A.nCols() == B.nCols() );
 
    // Commensurate memory allocation.
-   Matrix ABt( A.nRows(), B.nRows() );
+   Matrix ABt;
+   ABt.ResizeUninitialized( A.nRows(), B.nRows() );
 
    // Compute the Matrix product.
-   for (int i = 0; i < A.nRows(); ++i)
-      for (int j = 0; j < B.nRows(); ++j)
-         ABt(i,j) = SumProduct( A.nCols(), A.Base(i,0), B.Base(j,0) );
+   Gemm( false, true, A.nRows(), B.nRows(), A.nCols(),
+         A.Base(), A.nCols(), B.Base(), B.nCols(), ABt.Base(), ABt.nCols() );
 
-   C = ABt;
+   C = std::move(ABt);
 }
 
 //-----------------------------------------------------------------------------
@@ -856,14 +1046,14 @@ void Multiply_MtMt( const Matrix& A, const Matrix& B, Matrix& C )
    assert( A.nRows() == B.nCols() );
 
    // Commensurate memory allocation.
-   Matrix AtBt( A.nCols(), B.nRows() );
+   Matrix AtBt;
+   AtBt.ResizeUninitialized( A.nCols(), B.nRows() );
 
    // Compute the Matrix product.
-   for (int i = 0; i < A.nCols(); ++i)
-      for (int j=0; j < B.nRows(); ++j)
-         AtBt(i,j) = SumProduct( A.nRows(), A.Base(0,i), A.nCols(), B.Base(j,0) );
+   Gemm( true, true, A.nCols(), B.nRows(), A.nRows(),
+         A.Base(), A.nCols(), B.Base(), B.nCols(), AtBt.Base(), AtBt.nCols() );
 
-   C = AtBt;
+   C = std::move(AtBt);
 }
 
 //-----------------------------------------------------------------------------
@@ -7,7 +7,7 @@
 //    University of Minnesota
 //
 // version:
-//    2 July 2017
+//    18 October 2026
 //=============================================================================
 #ifndef MATRIX_H
 #define MATRIX_H
@@ -15,6 +15,8 @@
 #include <iostream>
 #include <vector>
 
+template <typename E> class MatrixExpression;
+
 //=============================================================================
 // Matrix
 //=============================================================================
@@ -24,6 +26,9 @@ public:
    // Life cycle
    Matrix();                                          // null constructor
    Matrix( const Matrix& A );                         // copy constructor
+   Matrix( Matrix&& A ) noexcept;                     // move constructor
+   template <typename E>
+   Matrix( const MatrixExpression<E>& e );            // evaluate an expression
    Matrix( const std::vector<double>v );              // constructor w/ std:vector
 
    Matrix( int nrows, int ncols );                    // dimensioned constructor
@@ -33,10 +38,14 @@ public:
 
    ~Matrix();                                         // destructor
    void Resize( int nrows, int ncols );               // destructive resize.
+   void ResizeUninitialized( int nrows, int ncols );  // destructive, no fill
 
    // Operators
    Matrix& operator=( const Matrix& A );              // assignment operator
+   Matrix& operator=( Matrix&& A ) noexcept;          // move assignment
    Matrix& operator=( double a );                     // scalar assignment
+   template <typename E>
+   Matrix& operator=( const MatrixExpression<E>& e ); // evaluate an expression
 
    double& operator()( int row, int col );            // mutable access
    double  operator()( int row, int col ) const;      // const access
@@ -59,7 +68,13 @@ public:
    double* begin();                                   // r/w access
    double* end();                                     // r/w access
 
+   // Instrumentation.
+   static long Allocations();                         // arrays allocated so far
+
 private:
+   static double* Allocate( int n );                  // aligned, pooled, counted
+   static void Release( double* p, int n );           // return to the pool
+
    int     m_nRows;                                   // allocated # of rows
    int     m_nCols;                                   // allocated # of columns
    double* m_Data;                                    // allocated memory
@@ -149,5 +164,10 @@ bool isRow( const Matrix& A );
 bool isCol( const Matrix& A );
 bool isVector( const Matrix& A );
 
+//=============================================================================
+// Element-wise arithmetic evaluated in a single pass.
+//=============================================================================
+#include "matrix_expression-inl.h"
+
 //=============================================================================
 #endif  // MATRIX_H
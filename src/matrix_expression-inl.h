@@ -0,0 +1,220 @@
+//=============================================================================
+// matrix_expression-inl.h
+//
+//    Element-wise Matrix arithmetic by expression templates, so that a chain
+//    such as
+//
+//       w = u - lambda*v;
+//
+//    is evaluated in a single pass, directly into w, with no temporary
+//    Matrices.
+//
+// notes:
+// o  This file is included at the end of matrix.h, and should not be
+//    included on its own.
+//
+// o  The operators +, -, unary -, and scalar * build a lightweight
+//    expression object holding references to the Matrix operands; nothing
+//    is computed until the expression is assigned to, or used to construct,
+//    a Matrix. The operands must all have the same dimensions.
+//
+// o  An expression object refers to its Matrix operands, so it must not
+//    outlive them. Keep expressions as temporaries, rather than storing
+//    them with auto.
+//
+// o  The target of an assignment may also be an operand, as in
+//    u = u - lambda*v, since each element is read before it is written.
+//
+// references:
+// o  Veldhuizen, T., 1995, Expression templates, C++ Report, v. 7, n. 5,
+//    p. 26-31.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef MATRIX_EXPRESSION_INL_H
+#define MATRIX_EXPRESSION_INL_H
+
+#include <cassert>
+#include <type_traits>
+
+//-----------------------------------------------------------------------------
+// The base of every expression: E is the derived expression type, which
+// provides nRows(), nCols(), and operator[](k), the k'th element in the
+// row-major order of Matrix storage.
+//-----------------------------------------------------------------------------
+template <typename E>
+class MatrixExpression
+{
+public:
+   const E& Self() const { return static_cast<const E&>(*this); }
+};
+
+//-----------------------------------------------------------------------------
+// A Matrix operand.
+//-----------------------------------------------------------------------------
+class MatrixLeaf : public MatrixExpression<MatrixLeaf>
+{
+public:
+   explicit MatrixLeaf( const Matrix& A ) : m_nRows( A.nRows() ), m_nCols( A.nCols() ), m_Data( A.Base() ) {}
+
+   double operator[]( int k ) const { return m_Data[k]; }
+   int nRows() const { return m_nRows; }
+   int nCols() const { return m_nCols; }
+
+private:
+   int m_nRows;
+   int m_nCols;
+   const double* m_Data;
+};
+
+//-----------------------------------------------------------------------------
+// The element-wise sum or difference of two expressions.
+//-----------------------------------------------------------------------------
+struct PlusOp  { static double Apply( double a, double b ) { return a + b; } };
+struct MinusOp { static double Apply( double a, double b ) { return a - b; } };
+
+template <typename L, typename R, typename Op>
+class MatrixBinary : public MatrixExpression< MatrixBinary<L,R,Op> >
+{
+public:
+   MatrixBinary( const L& l, const R& r ) : m_L( l ), m_R( r )
+   {
+      assert( l.nRows() == r.nRows() && l.nCols() == r.nCols() );
+   }
+
+   double operator[]( int k ) const { return Op::Apply( m_L[k], m_R[k] ); }
+   int nRows() const { return m_L.nRows(); }
+   int nCols() const { return m_L.nCols(); }
+
+private:
+   L m_L;
+   R m_R;
+};
+
+//-----------------------------------------------------------------------------
+// A scalar multiple of an expression.
+//-----------------------------------------------------------------------------
+template <typename E>
+class MatrixScaled : public MatrixExpression< MatrixScaled<E> >
+{
+public:
+   MatrixScaled( double a, const E& e ) : m_a( a ), m_E( e ) {}
+
+   double operator[]( int k ) const { return m_a * m_E[k]; }
+   int nRows() const { return m_E.nRows(); }
+   int nCols() const { return m_E.nCols(); }
+
+private:
+   double m_a;
+   E m_E;
+};
+
+//-----------------------------------------------------------------------------
+// The operand type for a Matrix or an expression: Matrices are held by
+// reference through a MatrixLeaf, and expressions by value.
+//-----------------------------------------------------------------------------
+template <typename T>
+struct MatrixOperand
+{
+   static const bool value = std::is_base_of< MatrixExpression<T>, T >::value;
+   typedef T Type;
+};
+
+template <>
+struct MatrixOperand<Matrix>
+{
+   static const bool value = true;
+   typedef MatrixLeaf Type;
+};
+
+//-----------------------------------------------------------------------------
+// The operators. They only match Matrices and expressions.
+//-----------------------------------------------------------------------------
+template <typename L, typename R>
+typename std::enable_if< MatrixOperand<L>::value && MatrixOperand<R>::value,
+   MatrixBinary< typename MatrixOperand<L>::Type, typename MatrixOperand<R>::Type, PlusOp > >::type
+operator+( const L& l, const R& r )
+{
+   typedef typename MatrixOperand<L>::Type LT;
+   typedef typename MatrixOperand<R>::Type RT;
+   return MatrixBinary<LT,RT,PlusOp>( LT(l), RT(r) );
+}
+
+template <typename L, typename R>
+typename std::enable_if< MatrixOperand<L>::value && MatrixOperand<R>::value,
+   MatrixBinary< typename MatrixOperand<L>::Type, typename MatrixOperand<R>::Type, MinusOp > >::type
+operator-( const L& l, const R& r )
+{
+   typedef typename MatrixOperand<L>::Type LT;
+   typedef typename MatrixOperand<R>::Type RT;
+   return MatrixBinary<LT,RT,MinusOp>( LT(l), RT(r) );
+}
+
+template <typename E>
+typename std::enable_if< MatrixOperand<E>::value, MatrixScaled< typename MatrixOperand<E>::Type > >::type
+operator*( double a, const E& e )
+{
+   typedef typename MatrixOperand<E>::Type ET;
+   return MatrixScaled<ET>( a, ET(e) );
+}
+
+template <typename E>
+typename std::enable_if< MatrixOperand<E>::value, MatrixScaled< typename MatrixOperand<E>::Type > >::type
+operator*( const E& e, double a )
+{
+   typedef typename MatrixOperand<E>::Type ET;
+   return MatrixScaled<ET>( a, ET(e) );
+}
+
+template <typename E>
+typename std::enable_if< MatrixOperand<E>::value, MatrixScaled< typename MatrixOperand<E>::Type > >::type
+operator-( const E& e )
+{
+   typedef typename MatrixOperand<E>::Type ET;
+   return MatrixScaled<ET>( -1.0, ET(e) );
+}
+
+//=============================================================================
+// Evaluation.
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Construct a Matrix from an expression: one allocation, one pass.
+//-----------------------------------------------------------------------------
+template <typename E>
+Matrix::Matrix( const MatrixExpression<E>& e )
+:  m_nRows( 0 ),
+   m_nCols( 0 ),
+   m_Data( nullptr )
+{
+   *this = e;
+}
+
+//-----------------------------------------------------------------------------
+// Assign an expression to a Matrix. The storage is reused when the
+// dimensions already agree.
+//-----------------------------------------------------------------------------
+template <typename E>
+Matrix& Matrix::operator=( const MatrixExpression<E>& e )
+{
+   const E& x = e.Self();
+
+   if ( m_nRows != x.nRows() || m_nCols != x.nCols() )
+      ResizeUninitialized( x.nRows(), x.nCols() );
+
+   const int n = m_nRows*m_nCols;
+   double* p = m_Data;
+   for (int k = 0; k < n; ++k)
+      p[k] = x[k];
+
+   return *this;
+}
+
+//=============================================================================
+#endif  // MATRIX_EXPRESSION_INL_H
@@ -0,0 +1,271 @@
+//=============================================================================
+// mixed_cholesky.cpp
+//
+//    A single precision Cholesky decomposition, with solutions refined to
+//    double precision accuracy.
+//
+// references:
+// o  Golub, G.H., and Van Loan, C.F., 1996, MATRIX COMPUTATIONS, 3rd Edition,
+//    Johns Hopkins University Press, Baltimore, Maryland, 694 pp.
+//
+// o  Higham, N.J., 2002, Accuracy and Stability of Numerical Algorithms,
+//    2nd Edition, SIAM, Philadelphia, 680 pp.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "mixed_cholesky.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "parallel-inl.h"
+#include "sum_product-inl.h"
+
+namespace{
+   // The column block width for the decomposition.
+   const int BLOCK_SIZE = 64;
+
+   // Systems of at least this order are factored in parallel.
+   const int PARALLEL_COUNT = 1000;
+
+   // The maximum number of refinement steps. Each step gains roughly
+   // -log10(cond(A) * 6e-8) digits, so more steps than this means the
+   // single precision factor is too inaccurate to be useful.
+   const int MAXIMUM_REFINEMENTS = 10;
+
+   // Refinement is abandoned when a step fails to reduce the residual by at
+   // least this factor.
+   const double STAGNATION = 0.5;
+
+   //--------------------------------------------------------------------------
+   // The offset of the start of a row in the packed storage.
+   //--------------------------------------------------------------------------
+   inline long Offset( int row )
+   {
+      return static_cast<long>(row) * (row+1) / 2;
+   }
+}
+
+//=============================================================================
+// MixedCholesky
+//=============================================================================
+MixedCholesky::MixedCholesky()
+:  m_nRows( 0 )
+{
+}
+
+//=============================================================================
+// Factor
+//
+//    Compute the Cholesky decomposition A = LL' in single precision.
+//
+// Arguments:
+//
+//    A     a symmetric positive definite PackedMatrix.
+//
+// Return:
+//
+//    true  if the decomposition was completed successfully;
+//    false if not.
+//
+// Notes:
+//
+// o  A is rounded to single precision, and then factored by the same
+//    blocked algorithm as CholeskyDecomposition. The factor takes half of
+//    the memory of a double precision factor, and every pass through it
+//    moves half as many bytes.
+//
+// o  A matrix that is positive definite in double precision may fail to
+//    be in single precision, when its condition number approaches 1e7.
+//=============================================================================
+bool MixedCholesky::Factor( const PackedMatrix& A )
+{
+   const int N = A.nRows();
+
+   m_nRows = N;
+   m_L.resize( Offset(N) );
+   std::copy( A.Base(0), A.Base(N), m_L.begin() );
+
+   auto L = [&](int i) { return m_L.data() + Offset(i); };
+
+   for (int j0 = 0; j0 < N; j0 += BLOCK_SIZE) {
+      const int j1 = std::min(j0 + BLOCK_SIZE, N);
+
+      // Factor the diagonal block.
+      for (int k = j0; k < j1; ++k) {
+         float* lk = L(k);
+         for (int j = j0; j < k; ++j)
+            lk[j] = (lk[j] - SumProduct(j, L(j), lk)) / L(j)[j];
+
+         lk[k] -= SumProduct(k, lk, lk);
+         if (!(lk[k] > 0.0f)) return false;
+         lk[k] = std::sqrt(lk[k]);
+      }
+
+      // Compute the rest of the block column. The rows are independent.
+      auto row = [&](int k) {
+         float* lk = L(k);
+         for (int j = j0; j < j1; ++j)
+            lk[j] = (lk[j] - SumProduct(j, L(j), lk)) / L(j)[j];
+      };
+
+      if (N < PARALLEL_COUNT) {
+         for (int k = j1; k < N; ++k)
+            row(k);
+      }
+      else {
+         ParallelFor(j1, N, row);
+      }
+   }
+   return true;
+}
+
+//=============================================================================
+// Solve
+//
+//    x = (LL')~b, for an (N x R) Matrix b, by forward elimination and back
+//    substitution in single precision.
+//=============================================================================
+void MixedCholesky::Solve( const Matrix& b, Matrix& x ) const
+{
+   assert( b.nRows() == nRows() );
+
+   const int N = nRows();
+   const int R = b.nCols();
+
+   std::vector<float> y( b.begin(), b.end() );
+
+   // Solve L y = b using forward elimination.
+   for (int i = 0; i < N; ++i) {
+      const float* l = m_L.data() + Offset(i);
+      float* yi = y.data() + static_cast<long>(i)*R;
+
+      for (int j = 0; j < i; ++j) {
+         const float* yj = y.data() + static_cast<long>(j)*R;
+         for (int r = 0; r < R; ++r)
+            yi[r] -= l[j] * yj[r];
+      }
+
+      for (int r = 0; r < R; ++r)
+         yi[r] /= l[i];
+   }
+
+   // Solve L' x = y using back substitution, one column of L' at a time.
+   for (int i = N-1; i >= 0; --i) {
+      const float* l = m_L.data() + Offset(i);
+      float* yi = y.data() + static_cast<long>(i)*R;
+
+      for (int r = 0; r < R; ++r)
+         yi[r] /= l[i];
+
+      for (int j = 0; j < i; ++j) {
+         float* yj = y.data() + static_cast<long>(j)*R;
+         for (int r = 0; r < R; ++r)
+            yj[r] -= l[j] * yi[r];
+      }
+   }
+
+   x.Resize(N, R);
+   std::copy( y.begin(), y.end(), x.begin() );
+}
+
+//=============================================================================
+// Refine
+//
+//    Solve A x = b to double precision accuracy by iterative refinement.
+//
+// Arguments:
+//
+//    A     the symmetric positive definite PackedMatrix that was factored.
+//
+//    b     the (N x R) right hand sides.
+//
+//    x     on exit, the (N x R) solutions.
+//
+//    tolerance
+//          the convergence criterion: ||b - Ax|| <= tolerance ||b|| for
+//          every column.
+//
+//    iterations
+//          on exit, the number of refinement steps taken.
+//
+// Return:
+//
+//    true  if every column converged;
+//    false if the refinement stagnated, or did not converge within
+//          MAXIMUM_REFINEMENTS steps.
+//
+// Notes:
+//
+// o  The initial solution comes from the single precision factor. Each
+//    step computes the residual r = b - Ax in double precision, solves
+//    A d = r with the single precision factor, and updates x += d. See
+//    Golub and Van Loan (1996), Section 3.5.3, and Higham (2002),
+//    Chapter 12.
+//
+// o  The refinement converges when cond(A) is well below 1e7. When it
+//    does not, the caller should fall back to a double precision
+//    decomposition.
+//
+// o  Refine may be called concurrently.
+//=============================================================================
+bool MixedCholesky::Refine( const PackedMatrix& A, const Matrix& b, Matrix& x, double tolerance, int& iterations ) const
+{
+   assert( A.nRows() == nRows() );
+   assert( b.nRows() == nRows() );
+
+   const int N = nRows();
+   const int R = b.nCols();
+
+   std::vector<double> bb(R, 0.0);
+   for (int n = 0; n < N; ++n)
+      for (int c = 0; c < R; ++c)
+         bb[c] += b(n,c)*b(n,c);
+
+   Solve(b, x);
+
+   double previous = HUGE_VAL;
+   for (iterations = 0; ; ++iterations) {
+      // The residual, in double precision.
+      Matrix r;
+      Multiply_SM(A, x, r);
+
+      std::vector<double> rr(R, 0.0);
+      for (int n = 0; n < N; ++n) {
+         for (int c = 0; c < R; ++c) {
+            r(n,c) = b(n,c) - r(n,c);
+            rr[c] += r(n,c)*r(n,c);
+         }
+      }
+
+      double worst = 0.0;
+      for (int c = 0; c < R; ++c) {
+         if (rr[c] > 0.0)
+            worst = std::max( worst, (bb[c] > 0.0) ? sqrt(rr[c]/bb[c]) : HUGE_VAL );
+      }
+
+      if (worst <= tolerance) return true;
+      if (iterations == MAXIMUM_REFINEMENTS || worst > STAGNATION*previous) return false;
+      previous = worst;
+
+      // The correction, in single precision.
+      Matrix d;
+      Solve(r, d);
+      for (int n = 0; n < N; ++n)
+         for (int c = 0; c < R; ++c)
+            x(n,c) += d(n,c);
+   }
+}
+
+//-----------------------------------------------------------------------------
+int MixedCholesky::nRows() const
+{
+   return m_nRows;
+}
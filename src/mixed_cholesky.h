@@ -0,0 +1,49 @@
+//=============================================================================
+// mixed_cholesky.h
+//
+//    A single precision Cholesky decomposition, with solutions refined to
+//    double precision accuracy.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef MIXED_CHOLESKY_H
+#define MIXED_CHOLESKY_H
+
+#include <vector>
+
+#include "matrix.h"
+#include "packed_matrix.h"
+
+//=============================================================================
+// MixedCholesky
+//
+//    The Cholesky decomposition A = LL' of a symmetric positive definite
+//    PackedMatrix, with L stored and applied in single precision.
+//=============================================================================
+class MixedCholesky
+{
+public:
+   // Life cycle
+   MixedCholesky();                                   // null constructor
+
+   // Operations
+   bool Factor( const PackedMatrix& A );              // A = LL', in float
+   void Solve( const Matrix& b, Matrix& x ) const;    // x = (LL')~b, in float
+   bool Refine( const PackedMatrix& A, const Matrix& b, Matrix& x, double tolerance, int& iterations ) const;
+
+   // Inquiry.
+   int nRows() const;                                 // the order of A
+
+private:
+   int m_nRows;
+   std::vector<float> m_L;                            // packed by rows
+};
+
+//=============================================================================
+#endif  // MIXED_CHOLESKY_H
@@ -0,0 +1,188 @@
+//=============================================================================
+// mizhodan_c.cpp
+//
+//    The C interface to a KrigingModel, for embedding Mizhodan in programs
+//    that are not written in C++.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "mizhodan_c.h"
+
+#include <atomic>
+#include <exception>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "engine.h"
+#include "kriging_model.h"
+#include "parallel-inl.h"
+
+//-----------------------------------------------------------------------------
+// The opaque handle is simply a KrigingModel.
+//-----------------------------------------------------------------------------
+struct mizhodan_model {
+   KrigingModel model;
+};
+
+namespace{
+   // The most recent failure on each thread.
+   thread_local std::string LastError;
+
+   //--------------------------------------------------------------------------
+   // Record a failure, and return its status code.
+   //--------------------------------------------------------------------------
+   int Fail( int status, const char* message )
+   {
+      LastError = message;
+      return status;
+   }
+
+   //--------------------------------------------------------------------------
+   // Translate the exception in flight into a status code. This must be
+   // called from within a catch block.
+   //--------------------------------------------------------------------------
+   int Translate()
+   {
+      try {
+         throw;
+      }
+      catch (TooFewObservations& e) {
+         return Fail( MIZHODAN_TOO_FEW, e.what() );
+      }
+      catch (TooManyObservations& e) {
+         return Fail( MIZHODAN_TOO_MANY, e.what() );
+      }
+      catch (CholeskyDecompositionFailed& e) {
+         return Fail( MIZHODAN_SINGULAR, e.what() );
+      }
+      catch (std::exception& e) {
+         return Fail( MIZHODAN_FAILED, e.what() );
+      }
+      catch (...) {
+         return Fail( MIZHODAN_FAILED, "The Mizhodan Engine failed for an unknown reason." );
+      }
+   }
+}
+
+//=============================================================================
+// mizhodan_create
+//=============================================================================
+mizhodan_model* mizhodan_create( void )
+{
+   return new (std::nothrow) mizhodan_model;
+}
+
+//=============================================================================
+// mizhodan_destroy
+//=============================================================================
+void mizhodan_destroy( mizhodan_model* model )
+{
+   delete model;
+}
+
+//=============================================================================
+// mizhodan_fit
+//
+// Notes:
+//
+// o  The observations are moved straight into the model, which must keep
+//    its own copy of the locations and values, since the caller may free
+//    the arrays as soon as the call returns. This is O(N) memory beside
+//    the O(N^2) decomposition.
+//
+// o  On failure the model is left unfitted.
+//=============================================================================
+int mizhodan_fit( mizhodan_model* model,
+                  double nugget, double sill, double range,
+                  const double* x, const double* y, const double* z, int n )
+{
+   if (model == nullptr || x == nullptr || y == nullptr || z == nullptr || n < 0)
+      return Fail( MIZHODAN_INVALID_ARGUMENT, "A null pointer, or a negative count, was passed to mizhodan_fit." );
+
+   if (!(nugget >= 0 && sill > nugget && range > 0))
+      return Fail( MIZHODAN_INVALID_ARGUMENT, "The variogram must satisfy 0 <= nugget < sill, and 0 < range." );
+
+   try {
+      std::vector<ObsRecord> obs(n);
+      for (int k = 0; k < n; ++k) {
+         obs[k].x = x[k];
+         obs[k].y = y[k];
+         obs[k].z = z[k];
+      }
+
+      ParamsRecord variogram = { nugget, sill, range };
+      model->model.Fit( std::move(obs), variogram );
+   }
+   catch (...) {
+      return Translate();
+   }
+   return MIZHODAN_OK;
+}
+
+//=============================================================================
+// mizhodan_predict
+//
+// Notes:
+//
+// o  The results are written directly into the caller's arrays, and the
+//    targets are spread over the available hardware threads.
+//=============================================================================
+int mizhodan_predict( const mizhodan_model* model,
+                      const double* x, const double* y, int m,
+                      double* zhat, double* kstd )
+{
+   if (model == nullptr || x == nullptr || y == nullptr || zhat == nullptr || kstd == nullptr || m < 0)
+      return Fail( MIZHODAN_INVALID_ARGUMENT, "A null pointer, or a negative count, was passed to mizhodan_predict." );
+
+   if (!model->model.IsFitted())
+      return Fail( MIZHODAN_NOT_FITTED, "The model must be fitted before it can predict." );
+
+   try {
+      // ParallelFor bodies must not throw, so the first failure on any
+      // thread is kept, and rethrown here on the calling thread.
+      const KrigingModel& kriging = model->model;
+      std::atomic<bool> failed(false);
+      std::exception_ptr error;
+
+      ParallelFor(0, m, [&](int k) {
+         try {
+            kriging.Predict( x[k], y[k], zhat[k], kstd[k] );
+         }
+         catch (...) {
+            if (!failed.exchange(true))
+               error = std::current_exception();
+         }
+      });
+
+      if (failed)
+         std::rethrow_exception(error);
+   }
+   catch (...) {
+      return Translate();
+   }
+   return MIZHODAN_OK;
+}
+
+//=============================================================================
+// mizhodan_observations
+//=============================================================================
+int mizhodan_observations( const mizhodan_model* model )
+{
+   return (model != nullptr) ? model->model.nObservations() : 0;
+}
+
+//=============================================================================
+// mizhodan_last_error
+//=============================================================================
+const char* mizhodan_last_error( void )
+{
+   return LastError.c_str();
+}
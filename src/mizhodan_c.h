@@ -0,0 +1,83 @@
+/*=============================================================================
+// mizhodan_c.h
+//
+//    The C interface to a KrigingModel, for embedding Mizhodan in programs
+//    that are not written in C++.
+//
+// notes:
+// o  This header is valid C and C++. The model is an opaque handle, and all
+//    of the data are passed in caller-owned arrays, so the interface may be
+//    called through any foreign function interface.
+//
+// o  No C++ exception crosses this interface. Every function that can fail
+//    returns a status code, and mizhodan_last_error describes the most
+//    recent failure on the calling thread.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//===========================================================================*/
+#ifndef MIZHODAN_C_H
+#define MIZHODAN_C_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------------------------
+// The status codes.
+//---------------------------------------------------------------------------*/
+enum {
+   MIZHODAN_OK = 0,                 /* success                                */
+   MIZHODAN_INVALID_ARGUMENT = 1,   /* a null pointer, or a bad variogram     */
+   MIZHODAN_TOO_FEW = 2,            /* too few observations                   */
+   MIZHODAN_TOO_MANY = 3,           /* too many observations                  */
+   MIZHODAN_SINGULAR = 4,           /* the Kriging system is not definite     */
+   MIZHODAN_NOT_FITTED = 5,         /* predict before a successful fit        */
+   MIZHODAN_FAILED = 6              /* any other failure, e.g. out of memory  */
+};
+
+/*-----------------------------------------------------------------------------
+// The opaque model handle.
+//---------------------------------------------------------------------------*/
+typedef struct mizhodan_model mizhodan_model;
+
+/*-----------------------------------------------------------------------------
+// Life cycle. mizhodan_create returns a null pointer if it fails.
+//---------------------------------------------------------------------------*/
+mizhodan_model* mizhodan_create( void );
+void mizhodan_destroy( mizhodan_model* model );
+
+/*-----------------------------------------------------------------------------
+// Fit the exponential semi-variogram model to the n observations
+// (x[k], y[k], z[k]). The arrays are only read during the call.
+//---------------------------------------------------------------------------*/
+int mizhodan_fit( mizhodan_model* model,
+                  double nugget, double sill, double range,
+                  const double* x, const double* y, const double* z, int n );
+
+/*-----------------------------------------------------------------------------
+// Krige the m targets (x[k], y[k]), writing the estimates and the Kriging
+// standard deviations to zhat[k] and kstd[k]. Any number of threads may
+// predict from the same model at once.
+//---------------------------------------------------------------------------*/
+int mizhodan_predict( const mizhodan_model* model,
+                      const double* x, const double* y, int m,
+                      double* zhat, double* kstd );
+
+/*-----------------------------------------------------------------------------
+// Inquiry.
+//---------------------------------------------------------------------------*/
+int mizhodan_observations( const mizhodan_model* model );   /* 0 if not fitted */
+const char* mizhodan_last_error( void );                     /* never null      */
+
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+#endif  /* MIZHODAN_C_H */
@@ -0,0 +1,254 @@
+//=============================================================================
+// packed_matrix.cpp
+//
+//    A symmetric, or lower triangular, matrix that stores only its lower
+//    triangle.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "packed_matrix.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace{
+   //--------------------------------------------------------------------------
+   // The offset of the start of a row in the packed storage.
+   //--------------------------------------------------------------------------
+   inline long Offset( int row )
+   {
+      return static_cast<long>(row) * (row+1) / 2;
+   }
+}
+
+//=============================================================================
+// PackedMatrix
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Null constructor.
+//-----------------------------------------------------------------------------
+PackedMatrix::PackedMatrix()
+:  m_nRows( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+// Dimensioned constructor, with zero fill.
+//-----------------------------------------------------------------------------
+PackedMatrix::PackedMatrix( int n )
+:  m_nRows( 0 )
+{
+   Resize(n);
+}
+
+//-----------------------------------------------------------------------------
+// Constructor with scalar fill.
+//-----------------------------------------------------------------------------
+PackedMatrix::PackedMatrix( int n, double a )
+:  m_nRows( 0 )
+{
+   Resize(n);
+   *this = a;
+}
+
+//-----------------------------------------------------------------------------
+// Constructor from the lower triangle of a square Matrix.
+//-----------------------------------------------------------------------------
+PackedMatrix::PackedMatrix( const Matrix& A )
+:  m_nRows( 0 )
+{
+   assert( A.nRows() == A.nCols() );
+
+   Resize( A.nRows() );
+   for (int i = 0; i < m_nRows; ++i)
+      std::copy( A.Base(i,0), A.Base(i,0)+i+1, Base(i) );
+}
+
+//-----------------------------------------------------------------------------
+// Destructive resize, with zero fill.
+//-----------------------------------------------------------------------------
+void PackedMatrix::Resize( int n )
+{
+   assert( n >= 0 );
+
+   m_nRows = n;
+   m_Data.assign( Offset(n), 0.0 );
+}
+
+//-----------------------------------------------------------------------------
+// Non-destructive resize to a larger order. The existing rows are kept, and
+// the new rows are zero filled; since the rows are packed in order, this is
+// a simple extension of the storage.
+//-----------------------------------------------------------------------------
+void PackedMatrix::Extend( int n )
+{
+   assert( n >= m_nRows );
+
+   m_nRows = n;
+   m_Data.resize( Offset(n), 0.0 );
+}
+
+//-----------------------------------------------------------------------------
+// Delete row k and column k, reducing the order by one. The later rows are
+// moved forward in place.
+//-----------------------------------------------------------------------------
+void PackedMatrix::Erase( int k )
+{
+   assert( 0 <= k && k < m_nRows );
+
+   long p = Offset(k);
+   for (int i = k+1; i < m_nRows; ++i) {
+      const double* row = m_Data.data() + Offset(i);
+      for (int j = 0; j <= i; ++j) {
+         if (j != k) m_Data[p++] = row[j];
+      }
+   }
+
+   --m_nRows;
+   m_Data.resize( Offset(m_nRows) );
+}
+
+//-----------------------------------------------------------------------------
+// Scalar assignment.
+//-----------------------------------------------------------------------------
+PackedMatrix& PackedMatrix::operator=( double a )
+{
+   std::fill( m_Data.begin(), m_Data.end(), a );
+   return *this;
+}
+
+//-----------------------------------------------------------------------------
+// Mutable access.
+//-----------------------------------------------------------------------------
+double& PackedMatrix::operator()( int row, int col )
+{
+   assert( 0 <= col && col <= row && row < m_nRows );
+   return m_Data[ Offset(row) + col ];
+}
+
+//-----------------------------------------------------------------------------
+// Const access.
+//-----------------------------------------------------------------------------
+double PackedMatrix::operator()( int row, int col ) const
+{
+   assert( 0 <= col && col <= row && row < m_nRows );
+   return m_Data[ Offset(row) + col ];
+}
+
+//-----------------------------------------------------------------------------
+int PackedMatrix::nRows() const
+{
+   return m_nRows;
+}
+
+//-----------------------------------------------------------------------------
+long PackedMatrix::Size() const
+{
+   return m_Data.size();
+}
+
+//-----------------------------------------------------------------------------
+const double* PackedMatrix::Base( int row ) const
+{
+   assert( 0 <= row && row <= m_nRows );
+   return m_Data.data() + Offset(row);
+}
+
+//-----------------------------------------------------------------------------
+double* PackedMatrix::Base( int row )
+{
+   assert( 0 <= row && row <= m_nRows );
+   return m_Data.data() + Offset(row);
+}
+
+//=============================================================================
+// Unpack
+//
+//    Expand a symmetric PackedMatrix into a full Matrix.
+//=============================================================================
+void Unpack( const PackedMatrix& A, Matrix& C )
+{
+   const int N = A.nRows();
+
+   C.Resize(N, N);
+   for (int i = 0; i < N; ++i) {
+      for (int j = 0; j <= i; ++j) {
+         C(i,j) = A(i,j);
+         C(j,i) = A(i,j);
+      }
+   }
+}
+
+//=============================================================================
+// UnpackLower
+//
+//    Expand a lower triangular PackedMatrix into a full Matrix, with the
+//    upper triangle zeroed.
+//=============================================================================
+void UnpackLower( const PackedMatrix& A, Matrix& C )
+{
+   const int N = A.nRows();
+
+   C.Resize(N, N);
+   for (int i = 0; i < N; ++i)
+      std::copy( A.Base(i), A.Base(i)+i+1, C.Base(i,0) );
+}
+
+//=============================================================================
+// Multiply_SM
+//
+//    C = AB, where A is a symmetric PackedMatrix.
+//
+// Notes:
+//
+// o  Each stored entry A(i,j), j < i, is used twice: once as A(i,j) and
+//    once as A(j,i). The rows of A, B, and C are all accessed with unit
+//    stride.
+//=============================================================================
+void Multiply_SM( const PackedMatrix& A, const Matrix& B, Matrix& C )
+{
+   assert( A.nRows() == B.nRows() );
+
+   const int N = A.nRows();
+   const int R = B.nCols();
+
+   C.Resize(N, R);
+
+   for (int i = 0; i < N; ++i) {
+      const double* a = A.Base(i);
+      const double* bi = B.Base(i,0);
+      double* ci = C.Base(i,0);
+
+      for (int j = 0; j < i; ++j) {
+         const double* bj = B.Base(j,0);
+         double* cj = C.Base(j,0);
+         for (int r = 0; r < R; ++r) {
+            ci[r] += a[j] * bj[r];
+            cj[r] += a[j] * bi[r];
+         }
+      }
+
+      for (int r = 0; r < R; ++r)
+         ci[r] += a[i] * bi[r];
+   }
+}
+
+//=============================================================================
+// Trace
+//
+//    Return the sum of the diagonal elements.
+//=============================================================================
+double Trace( const PackedMatrix& A )
+{
+   double sum = 0.0;
+   for (int i = 0; i < A.nRows(); ++i)
+      sum += A(i,i);
+   return sum;
+}
@@ -0,0 +1,79 @@
+//=============================================================================
+// packed_matrix.h
+//
+//    A symmetric, or lower triangular, matrix that stores only its lower
+//    triangle.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef PACKED_MATRIX_H
+#define PACKED_MATRIX_H
+
+#include <vector>
+
+#include "matrix.h"
+
+//=============================================================================
+// PackedMatrix
+//
+//    An (N x N) matrix holding the lower triangle, including the diagonal,
+//    packed row by row: row i holds columns 0 through i, and immediately
+//    follows row i-1. This is half the storage of a full Matrix, and each
+//    row is contiguous, so the row-oriented Cholesky routines use
+//    unit-stride dot products.
+//
+//    Whether the matrix is symmetric or lower triangular is up to the
+//    routine using it; only entries with row >= col may be accessed.
+//=============================================================================
+class PackedMatrix
+{
+public:
+   // Life cycle
+   PackedMatrix();                                    // null constructor
+   explicit PackedMatrix( int n );                    // dimensioned constructor
+   PackedMatrix( int n, double a );                   // constructor w/ scalar fill
+   explicit PackedMatrix( const Matrix& A );          // lower triangle of A
+
+   void Resize( int n );                              // destructive resize.
+   void Extend( int n );                              // keep rows, add zero rows
+   void Erase( int k );                               // delete row and column k
+
+   // Operators
+   PackedMatrix& operator=( double a );               // scalar assignment
+
+   double& operator()( int row, int col );            // mutable access
+   double  operator()( int row, int col ) const;      // const access
+
+   // Inquiry.
+   int  nRows() const;                                // return the order
+   long Size() const;                                 // stored entries
+
+   // Access to the raw storage.
+   const double* Base( int row ) const;               // r/o start of a row
+   double* Base( int row );                           // r/w start of a row
+
+private:
+   int m_nRows;
+   std::vector<double> m_Data;
+};
+
+//=============================================================================
+// Conversions to a full Matrix.
+//=============================================================================
+void Unpack( const PackedMatrix& A, Matrix& C );                     // C = A, symmetric
+void UnpackLower( const PackedMatrix& A, Matrix& C );                // C = A, lower triangular
+
+//=============================================================================
+// Symmetric packed operations.
+//=============================================================================
+void Multiply_SM( const PackedMatrix& A, const Matrix& B, Matrix& C );  // C = AB
+double Trace( const PackedMatrix& A );                                 // sum of the diagonal
+
+//=============================================================================
+#endif  // PACKED_MATRIX_H
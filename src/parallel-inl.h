@@ -0,0 +1,76 @@
+//=============================================================================
+// parallel-inl.h
+//
+//    A minimal parallel loop built on the C++11 standard thread library.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// This routine returns the number of worker threads to use.
+//-----------------------------------------------------------------------------
+inline int ThreadCount()
+{
+   int n = std::thread::hardware_concurrency();
+   return (n > 0 ? n : 1);
+}
+
+//-----------------------------------------------------------------------------
+// This routine calls f(i) for every i in [begin, end), distributing the
+// calls over the available hardware threads.
+//
+// Arguments:
+//
+//    begin the first index.
+//    end   one past the last index.
+//    f     the loop body; a callable taking a single int.
+//
+// Notes:
+//
+// o  The indices are handed out dynamically, one at a time, so the loop
+//    balances well when the iterations have unequal cost.
+//
+// o  The iterations must be independent; f must not throw.
+//-----------------------------------------------------------------------------
+template <typename Function>
+void ParallelFor( int begin, int end, Function f )
+{
+   const int nThreads = std::min( ThreadCount(), end-begin );
+
+   if (nThreads <= 1) {
+      for (int i = begin; i < end; ++i)
+         f(i);
+      return;
+   }
+
+   std::atomic<int> next( begin );
+   auto worker = [&]() {
+      for (int i = next++; i < end; i = next++)
+         f(i);
+   };
+
+   std::vector<std::thread> pool;
+   for (int t = 1; t < nThreads; ++t)
+      pool.push_back( std::thread(worker) );
+
+   worker();
+
+   for (unsigned t = 0; t < pool.size(); ++t)
+      pool[t].join();
+}
+
+//=============================================================================
+#endif  // PARALLEL_H
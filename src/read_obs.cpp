@@ -5,19 +5,24 @@
 //
 // notes:
 // o  This function uses Ben Strasser's "fast-cpp-csv-parser" to read in the
-//    .csv input file. See
+//    .csv input files. See
 //
 //       https://github.com/ben-strasser/fast-cpp-csv-parser
 //
+// o  The second form accepts any number of value columns after ID, X, and
+//    Y, as long as every line has the same number of fields. obs[n].z is
+//    the first value, and values[n] holds all of them.
+//
 // author:
 //    Dr. Randal J. Barnes
 //    Department of Civil, Environmental, and Geo- Engineering
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 
@@ -56,3 +61,63 @@ std::vector<ObsRecord> read_obs( const std::string& obsfilename ) {
 
    return obs;
 }
+
+//-----------------------------------------------------------------------------
+std::vector<ObsRecord> read_obs( const std::string& obsfilename, std::vector< std::vector<double> >& values ) {
+   std::vector<ObsRecord> obs;
+   values.clear();
+
+   try {
+      io::LineReader in(obsfilename);
+
+      unsigned nfields = 0;
+      while (char* line = in.next_line()) {
+         // Skip blank lines and comment lines, as the CSVReader does.
+         const char* c = line;
+         while (*c == ' ' || *c == '\t')
+            ++c;
+         if (*c == '\0' || *line == '!' || *line == '#')
+            continue;
+
+         // Split the line on commas, trimming blanks and tabs.
+         std::vector<std::string> fields;
+         std::stringstream ss(line);
+         std::string field;
+         while (std::getline(ss, field, ',')) {
+            const std::size_t first = field.find_first_not_of(" \t");
+            const std::size_t last  = field.find_last_not_of(" \t");
+            fields.push_back( first == std::string::npos ? std::string() : field.substr(first, last-first+1) );
+         }
+
+         if (nfields == 0)
+            nfields = fields.size();
+         if (fields.size() < 4 || fields.size() != nfields)
+            throw InvalidObsRecord("");
+
+         // Everything after the ID is a number.
+         std::vector<double> v(nfields-1);
+         for (unsigned k = 1; k < nfields; ++k) {
+            char* end;
+            v[k-1] = strtod(fields[k].c_str(), &end);
+            if (fields[k].empty() || *end != '\0')
+               throw InvalidObsRecord("");
+         }
+
+         ObsRecord s = { fields[0], v[0], v[1], v[2] };
+         obs.push_back(s);
+         values.push_back( std::vector<double>(v.begin()+2, v.end()) );
+      }
+   }
+   catch (io::error::can_not_open_file& e) {
+      std::stringstream message;
+      message << "Could not open <" << obsfilename << "> for input.";
+      throw InvalidObsFile(message.str());
+   }
+   catch (...) {
+      std::stringstream message;
+      message << "Reading the observation data failed on line " << obs.size()+1 << " of file " << obsfilename << ".";
+      throw InvalidObsRecord(message.str());
+   }
+
+   return obs;
+}
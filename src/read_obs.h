@@ -7,7 +7,7 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #ifndef read_obs_H
 #define read_obs_H
@@ -39,6 +39,7 @@ struct ObsRecord{
 };
 
 std::vector<ObsRecord> read_obs( const std::string& obsfilename );
+std::vector<ObsRecord> read_obs( const std::string& obsfilename, std::vector< std::vector<double> >& values );
 
 
 //=============================================================================
@@ -0,0 +1,56 @@
+//=============================================================================
+// read_params.cpp
+//
+//    Read in the semi-variogram parameter sets from the user-specified file.
+//
+// notes:
+// o  This function uses Ben Strasser's "fast-cpp-csv-parser" to read in the
+//    .csv input file. See
+//
+//       https://github.com/ben-strasser/fast-cpp-csv-parser
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <sstream>
+
+#include "../include/csv.h"
+#include "read_params.h"
+
+//-----------------------------------------------------------------------------
+std::vector<ParamsRecord> read_params( const std::string& paramsfilename ) {
+   std::vector<ParamsRecord> params;
+
+   try {
+      io::CSVReader<3,
+         io::trim_chars<' ', '\t'>,
+         io::no_quote_escape<','>,
+         io::throw_on_overflow,
+         io::single_and_empty_line_comment<'!','#'>> in(paramsfilename);
+
+      double nugget, sill, range;
+
+      while (in.read_row(nugget,sill,range)){
+         if (nugget <= 0 || sill <= 0 || range <= 0) throw std::domain_error("non-positive parameter");
+         ParamsRecord s = { nugget, sill, range };
+         params.push_back(s);
+      }
+   }
+   catch (io::error::can_not_open_file& e) {
+      std::stringstream message;
+      message << "Could not open <" << paramsfilename << "> for input.";
+      throw InvalidParamsFile(message.str());
+   }
+   catch (...) {
+      std::stringstream message;
+      message << "Reading the parameter sets failed on line " << params.size()+1 << " of file " << paramsfilename << ".";
+      throw InvalidParamsRecord(message.str());
+   }
+
+   return params;
+}
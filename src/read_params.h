@@ -0,0 +1,43 @@
+//=============================================================================
+// read_params.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef read_params_H
+#define read_params_H
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+class InvalidParamsFile : public std::runtime_error {
+   public :
+      InvalidParamsFile( const std::string& message ) : std::runtime_error(message) {
+      }
+};
+
+class InvalidParamsRecord : public std::runtime_error {
+   public :
+      InvalidParamsRecord( const std::string& message ) : std::runtime_error(message) {
+      }
+};
+
+//-----------------------------------------------------------------------------
+struct ParamsRecord{
+   double nugget;
+   double sill;
+   double range;
+};
+
+std::vector<ParamsRecord> read_params( const std::string& paramsfilename );
+
+
+//=============================================================================
+#endif  // read_params_H
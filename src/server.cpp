@@ -0,0 +1,371 @@
+//=============================================================================
+// server.cpp
+//
+//    A resident prediction server, answering target queries against a
+//    fitted KrigingModel over a line protocol.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "server.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "parallel-inl.h"
+
+namespace{
+   typedef std::chrono::steady_clock Clock;
+
+   // Manifest constants.
+   const int MAXIMUM_BATCH = 4096;            // queries answered at once
+   const int LATENCY_WINDOW = 100000;         // latencies kept for percentiles
+
+   //--------------------------------------------------------------------------
+   // One line of input, stamped with its arrival time.
+   //--------------------------------------------------------------------------
+   struct Query {
+      std::string line;
+      Clock::time_point arrival;
+   };
+
+   enum Kind { TARGET, STATS, QUIT, IGNORE, INVALID };
+
+   //--------------------------------------------------------------------------
+   // Trim the leading and trailing spaces and tabs.
+   //--------------------------------------------------------------------------
+   std::string Trim( const std::string& s )
+   {
+      std::string::size_type first = s.find_first_not_of(" \t\r");
+      if (first == std::string::npos) return std::string();
+      std::string::size_type last = s.find_last_not_of(" \t\r");
+      return s.substr(first, last-first+1);
+   }
+
+   //--------------------------------------------------------------------------
+   // Convert a whole field to a double.
+   //--------------------------------------------------------------------------
+   bool ToDouble( const std::string& field, double& value )
+   {
+      if (field.empty()) return false;
+      char* end;
+      value = strtod(field.c_str(), &end);
+      return *end == '\0' && std::isfinite(value);
+   }
+
+   //--------------------------------------------------------------------------
+   // Classify one line of input. A target line has the same three fields
+   // as a line of the targets file: <ID>, <x>, <y>.
+   //--------------------------------------------------------------------------
+   Kind Parse( const std::string& line, TargetRecord& target )
+   {
+      std::string s = Trim(line);
+      if (s.empty() || s[0] == '#' || s[0] == '!') return IGNORE;
+      if (s == "stats") return STATS;
+      if (s == "quit") return QUIT;
+
+      std::string::size_type c1 = s.find(',');
+      if (c1 == std::string::npos) return INVALID;
+      std::string::size_type c2 = s.find(',', c1+1);
+      if (c2 == std::string::npos || s.find(',', c2+1) != std::string::npos) return INVALID;
+
+      target.id = Trim( s.substr(0, c1) );
+      if ( !ToDouble( Trim(s.substr(c1+1, c2-c1-1)), target.x ) ) return INVALID;
+      if ( !ToDouble( Trim(s.substr(c2+1)), target.y ) ) return INVALID;
+      return TARGET;
+   }
+
+   //--------------------------------------------------------------------------
+   // A fixed set of worker threads that share the iterations of a loop.
+   //
+   // o  Unlike ParallelFor, the threads are started once, and sleep between
+   //    loops, so a small batch of queries does not pay for thread creation.
+   //--------------------------------------------------------------------------
+   class WorkerPool
+   {
+   public:
+      explicit WorkerPool( int nThreads );
+      ~WorkerPool();
+
+      void For( int n, const std::function<void(int)>& f );
+
+   private:
+      void Work();
+      void Drain();
+
+      std::vector<std::thread> m_Threads;
+      std::mutex m_Mutex;
+      std::condition_variable m_Start;
+      std::condition_variable m_Done;
+
+      const std::function<void(int)>* m_Task;
+      int m_Size;
+      std::atomic<int> m_Next;
+      int m_Active;
+      long m_Generation;
+      bool m_Stop;
+   };
+
+   WorkerPool::WorkerPool( int nThreads )
+   :  m_Task( nullptr ),
+      m_Size( 0 ),
+      m_Next( 0 ),
+      m_Active( 0 ),
+      m_Generation( 0 ),
+      m_Stop( false )
+   {
+      for (int t = 1; t < nThreads; ++t)
+         m_Threads.push_back( std::thread(&WorkerPool::Work, this) );
+   }
+
+   WorkerPool::~WorkerPool()
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         m_Stop = true;
+      }
+      m_Start.notify_all();
+
+      for (unsigned t = 0; t < m_Threads.size(); ++t)
+         m_Threads[t].join();
+   }
+
+   // Call f(i) for every i in [0, n), and return when all calls are done.
+   void WorkerPool::For( int n, const std::function<void(int)>& f )
+   {
+      if (n <= 1 || m_Threads.empty()) {
+         for (int i = 0; i < n; ++i)
+            f(i);
+         return;
+      }
+
+      {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         m_Task = &f;
+         m_Size = n;
+         m_Next = 0;
+         m_Active = m_Threads.size();
+         ++m_Generation;
+      }
+      m_Start.notify_all();
+
+      Drain();
+
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Done.wait(lock, [&]{ return m_Active == 0; });
+   }
+
+   void WorkerPool::Work()
+   {
+      long seen = 0;
+      for (;;) {
+         {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Start.wait(lock, [&]{ return m_Stop || m_Generation != seen; });
+            if (m_Stop) return;
+            seen = m_Generation;
+         }
+
+         Drain();
+
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         if (--m_Active == 0) m_Done.notify_one();
+      }
+   }
+
+   void WorkerPool::Drain()
+   {
+      for (int i = m_Next++; i < m_Size; i = m_Next++)
+         (*m_Task)(i);
+   }
+}
+
+//=============================================================================
+// LatencyCounter
+//=============================================================================
+LatencyCounter::LatencyCounter()
+:  m_Count( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+// Record the latency of one query.
+//-----------------------------------------------------------------------------
+void LatencyCounter::Record( double latency )
+{
+   if (m_Window.size() < static_cast<unsigned>(LATENCY_WINDOW))
+      m_Window.push_back(latency);
+   else
+      m_Window[m_Count % LATENCY_WINDOW] = latency;
+   ++m_Count;
+}
+
+//-----------------------------------------------------------------------------
+long LatencyCounter::Count() const
+{
+   return m_Count;
+}
+
+//-----------------------------------------------------------------------------
+// The p'th percentile, by the nearest rank, of the latencies of the most
+// recent LATENCY_WINDOW queries. This is 0 if there have been none.
+//-----------------------------------------------------------------------------
+double LatencyCounter::Percentile( double p ) const
+{
+   assert( 0 < p && p <= 100 );
+
+   if (m_Window.empty()) return 0.0;
+
+   std::vector<double> sorted( m_Window );
+   int rank = static_cast<int>( ceil(p/100 * sorted.size()) ) - 1;
+   rank = std::max(0, std::min(rank, static_cast<int>(sorted.size())-1));
+
+   std::nth_element( sorted.begin(), sorted.begin()+rank, sorted.end() );
+   return sorted[rank];
+}
+
+//=============================================================================
+// Serve
+//
+//    Answer queries, one line at a time, until the input ends or a "quit"
+//    line is read.
+//
+// Arguments:
+//
+//    model    a fitted KrigingModel.
+//
+//    in       the queries.
+//
+//    out      the replies, one line per target or "stats" query, in the
+//             order of the queries.
+//
+//    latency  the latencies of the answered targets, in microseconds, from
+//             the arrival of the query to the writing of its reply.
+//
+// Notes:
+//
+// o  The protocol follows the input files. A target line has the fields
+//    <ID>, <x>, <y>, and its reply has the fields <ID>, <x>, <y>, <Zhat>,
+//    <Kstd>, as in the results file. Blank and comment lines are ignored.
+//    An invalid line is answered by a comment line starting "# ERROR".
+//    A "stats" line is answered by the query count and the p50 and p99
+//    latencies.
+//
+// o  A reader thread queues the lines as they arrive. Whenever the
+//    previous batch is done, every queued line, up to MAXIMUM_BATCH, is
+//    taken as the next batch, and its targets are kriged across a pool of
+//    worker threads. A lone query is answered at once, while a burst of
+//    queries shares the workers, and the output is flushed once per batch.
+//=============================================================================
+void Serve( const KrigingModel& model, std::istream& in, std::ostream& out, LatencyCounter& latency )
+{
+   std::deque<Query> queue;
+   std::mutex mutex;
+   std::condition_variable arrived;
+   bool finished = false;
+
+   std::thread reader( [&]() {
+      std::string line;
+      while (std::getline(in, line)) {
+         bool quit = ( Trim(line) == "quit" );
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back( Query{ line, Clock::now() } );
+         }
+         arrived.notify_one();
+         if (quit) break;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      finished = true;
+      arrived.notify_one();
+   });
+
+   WorkerPool pool( ThreadCount() );
+
+   out << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+
+   bool quit = false;
+   while (!quit) {
+      std::vector<Query> batch;
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         arrived.wait(lock, [&]{ return !queue.empty() || finished; });
+         if (queue.empty()) break;
+
+         const int n = std::min( static_cast<int>(queue.size()), MAXIMUM_BATCH );
+         batch.assign( queue.begin(), queue.begin()+n );
+         queue.erase( queue.begin(), queue.begin()+n );
+      }
+
+      const int n = batch.size();
+      std::vector<Kind> kind(n);
+      std::vector<TargetRecord> targets(n);
+      std::vector<ResultRecord> results(n);
+
+      for (int k = 0; k < n; ++k)
+         kind[k] = Parse( batch[k].line, targets[k] );
+
+      pool.For( n, [&](int k) {
+         if (kind[k] == TARGET)
+            model.Predict( targets[k], results[k] );
+      });
+
+      for (int k = 0; k < n && !quit; ++k) {
+         switch (kind[k]) {
+            case TARGET: {
+               out << results[k].id << ','
+                   << results[k].x << ','
+                   << results[k].y << ','
+                   << results[k].zhat << ','
+                   << results[k].kstd << '\n';
+
+               std::chrono::duration<double, std::micro> elapsed = Clock::now() - batch[k].arrival;
+               latency.Record( elapsed.count() );
+               break;
+            }
+            case STATS: {
+               std::ostringstream stats;
+               stats << std::fixed << std::setprecision(1)
+                     << "# queries " << latency.Count()
+                     << ", p50 " << latency.Percentile(50) << " us"
+                     << ", p99 " << latency.Percentile(99) << " us";
+               out << stats.str() << '\n';
+               break;
+            }
+            case QUIT: {
+               quit = true;
+               break;
+            }
+            case INVALID: {
+               out << "# ERROR: invalid query <" << Trim(batch[k].line) << ">." << '\n';
+               break;
+            }
+            case IGNORE: {
+               break;
+            }
+         }
+      }
+      out.flush();
+   }
+
+   reader.join();
+}
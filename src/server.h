@@ -0,0 +1,53 @@
+//=============================================================================
+// server.h
+//
+//    A resident prediction server, answering target queries against a
+//    fitted KrigingModel over a line protocol.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <iostream>
+#include <vector>
+
+#include "kriging_model.h"
+
+//=============================================================================
+// LatencyCounter
+//
+//    The number of queries answered, and the latencies of the most recent
+//    of them, in microseconds.
+//=============================================================================
+class LatencyCounter
+{
+public:
+   // Life cycle
+   LatencyCounter();
+
+   // Operations
+   void Record( double latency );                     // one more query
+
+   // Inquiry.
+   long Count() const;                                // all queries recorded
+   double Percentile( double p ) const;               // 0 < p <= 100, recent
+
+private:
+   long m_Count;
+   std::vector<double> m_Window;                      // a ring buffer
+};
+
+//=============================================================================
+// Serve
+//=============================================================================
+void Serve( const KrigingModel& model, std::istream& in, std::ostream& out, LatencyCounter& latency );
+
+//=============================================================================
+#endif  // SERVER_H
@@ -0,0 +1,85 @@
+//=============================================================================
+// sparse_matrix.h
+//
+//    A symmetric sparse matrix, its fill-reducing ordering, and its sparse
+//    Cholesky decomposition.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <vector>
+
+#include "matrix.h"
+#include "read_obs.h"
+
+//=============================================================================
+// SparseMatrix
+//
+//    A symmetric matrix holding the lower triangle, including the diagonal,
+//    in compressed sparse row (CSR) form. The rows are appended in order, and
+//    the column indices within a row must be increasing.
+//=============================================================================
+class SparseMatrix
+{
+public:
+   // Life cycle
+   SparseMatrix();                                    // null constructor
+
+   // Assembly
+   void Append( int col, double a );                  // add to the current row
+   void EndRow();                                     // start the next row
+
+   // Operations
+   void Multiply( const Matrix& x, Matrix& y ) const; // y = A x
+
+   // Inquiry.
+   int  nRows() const;                                // number of rows
+   long nNonZeros() const;                            // stored entries
+
+   // Access to the raw storage.
+   long   Begin( int row ) const;                     // first entry of a row
+   long   End( int row ) const;                       // one past the last
+   int    Col( long p ) const;                        // column of an entry
+   double Value( long p ) const;                      // value of an entry
+
+private:
+   std::vector<long>   m_RowPtr;
+   std::vector<int>    m_Col;
+   std::vector<double> m_Value;
+};
+
+//=============================================================================
+// SparseCholesky
+//
+//    The sparse Cholesky decomposition A = LL' of a SparseMatrix.
+//=============================================================================
+class SparseCholesky
+{
+public:
+   // Operations
+   bool Factor( const SparseMatrix& A );              // A = LL'
+   void Solve( const Matrix& b, Matrix& x ) const;    // x = A~b
+
+   // Inquiry.
+   int  nRows() const;                                // number of rows
+   long nNonZeros() const;                            // stored entries of L
+
+private:
+   std::vector<long>   m_ColPtr;                      // L by columns, with
+   std::vector<int>    m_Row;                         // the diagonal first
+   std::vector<double> m_Value;
+};
+
+//-----------------------------------------------------------------------------
+void NestedDissection( const std::vector<ObsRecord>& obs, double separation, std::vector<int>& perm );
+
+//=============================================================================
+#endif  // SPARSE_MATRIX_H
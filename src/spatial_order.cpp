@@ -0,0 +1,130 @@
+//=============================================================================
+// spatial_order.cpp
+//
+//    Space-filling curve orderings of scattered points, so that points that
+//    are near one another in the plane are near one another in memory.
+//
+// references:
+// o  Hilbert, D., 1891, Ueber die stetige Abbildung einer Linie auf ein
+//    Flachenstuck, Mathematische Annalen, v. 38, p. 459-460.
+//
+// o  Warren, H.S., 2013, Hacker's Delight, 2nd ed., Addison-Wesley,
+//    Chapter 16.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "spatial_order.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace{
+   // The order of the curve: the bounding square is divided into
+   // 2^BITS x 2^BITS cells.
+   const int BITS = 16;
+   const unsigned SIDE = 1u << BITS;
+
+   //--------------------------------------------------------------------------
+   // The Hilbert order of any records with members x and y.
+   //--------------------------------------------------------------------------
+   template <typename Record>
+   void Order( const std::vector<Record>& points, std::vector<int>& perm )
+   {
+      const int N = points.size();
+      perm.resize(N);
+      if (N == 0) return;
+
+      // The bounding square, so that the cells are square.
+      double xmin = points[0].x, xmax = points[0].x, ymin = points[0].y, ymax = points[0].y;
+      for (int n = 1; n < N; ++n) {
+         xmin = std::min(xmin, points[n].x);  xmax = std::max(xmax, points[n].x);
+         ymin = std::min(ymin, points[n].y);  ymax = std::max(ymax, points[n].y);
+      }
+      const double side = std::max(xmax - xmin, ymax - ymin);
+      const double scale = (side > 0) ? (SIDE - 1) / side : 0.0;
+
+      // Sort by the distance along the curve; ties keep the input order.
+      std::vector< std::pair<unsigned long long,int> > key(N);
+      for (int n = 0; n < N; ++n) {
+         unsigned i = static_cast<unsigned>( (points[n].x - xmin) * scale );
+         unsigned j = static_cast<unsigned>( (points[n].y - ymin) * scale );
+         key[n] = std::make_pair( HilbertIndex(i, j), n );
+      }
+      std::sort(key.begin(), key.end());
+
+      for (int n = 0; n < N; ++n)
+         perm[n] = key[n].second;
+   }
+}
+
+//=============================================================================
+// HilbertIndex
+//
+//    The distance along the Hilbert curve of the cell (x,y).
+//
+// Notes:
+//
+// o  The curve is descended one level per bit, from the largest quadrant
+//    to the smallest: each level adds the position of the quadrant along
+//    the curve, and then rotates and reflects the coordinates into the
+//    frame of that quadrant.
+//=============================================================================
+unsigned long long HilbertIndex( unsigned x, unsigned y )
+{
+   unsigned long long d = 0;
+
+   for (unsigned s = SIDE/2; s > 0; s /= 2) {
+      const unsigned rx = (x & s) ? 1 : 0;
+      const unsigned ry = (y & s) ? 1 : 0;
+      d += static_cast<unsigned long long>(s) * s * ((3 * rx) ^ ry);
+
+      if (ry == 0) {
+         if (rx == 1) {
+            x = SIDE-1 - x;
+            y = SIDE-1 - y;
+         }
+         std::swap(x, y);
+      }
+   }
+   return d;
+}
+
+//=============================================================================
+// HilbertOrder
+//
+//    Order points along the Hilbert curve through their bounding square.
+//
+// Arguments:
+//
+//    obs, targets
+//          the points.
+//
+//    perm  on exit, perm[k] is the index of the k'th point in the new
+//          order.
+//
+// Notes:
+//
+// o  Consecutive points along the curve are close in the plane, and any
+//    run of consecutive points covers a compact region. Processing
+//    points in this order keeps the data they touch in the processor
+//    caches, and makes neighboring points share work.
+//
+// o  The Hilbert curve is used, rather than the simpler Morton (Z-order)
+//    curve, because it never jumps: cells adjacent along the curve are
+//    adjacent in the plane.
+//=============================================================================
+void HilbertOrder( const std::vector<ObsRecord>& obs, std::vector<int>& perm )
+{
+   Order(obs, perm);
+}
+
+void HilbertOrder( const std::vector<TargetRecord>& targets, std::vector<int>& perm )
+{
+   Order(targets, perm);
+}
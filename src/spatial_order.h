@@ -0,0 +1,36 @@
+//=============================================================================
+// spatial_order.h
+//
+//    Space-filling curve orderings of scattered points, so that points that
+//    are near one another in the plane are near one another in memory.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef SPATIAL_ORDER_H
+#define SPATIAL_ORDER_H
+
+#include <vector>
+
+#include "read_obs.h"
+#include "read_targets.h"
+
+//-----------------------------------------------------------------------------
+// On exit, perm[k] is the index of the k'th point along the Hilbert curve.
+//-----------------------------------------------------------------------------
+void HilbertOrder( const std::vector<ObsRecord>& obs, std::vector<int>& perm );
+void HilbertOrder( const std::vector<TargetRecord>& targets, std::vector<int>& perm );
+
+//-----------------------------------------------------------------------------
+// The distance along the Hilbert curve of order 16 of the cell (x,y),
+// 0 <= x, y < 65536.
+//-----------------------------------------------------------------------------
+unsigned long long HilbertIndex( unsigned x, unsigned y );
+
+//=============================================================================
+#endif  // SPATIAL_ORDER_H
@@ -13,7 +13,7 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #include <cassert>
 #include <cmath>
@@ -449,3 +449,120 @@ double GaussianCDFInv(double p)
 
    return (p<0.5 ? u : -u);
 }
+
+//-----------------------------------------------------------------------------
+// GaussianCDF
+//
+//    The batch version: p[i] = GaussianCDF(x[i]) for 0 <= i < n.
+//
+// notes:
+// o  Hart's (1968) rational approximation of the scaled tail,
+//
+//       Phi(-y) = exp(-y^2/2) A(y)/B(y),   0 <= y < 7.07,
+//
+//    as given by West (2005), and Laplace's continued fraction, cut at 12
+//    terms, beyond. The absolute error is below 3e-16 everywhere; the
+//    relative error in the lower tail grows from 1e-15 at y = 2 to 5e-9 at
+//    y = 7, where Phi(-y) is 1e-12. This is at a small fraction of the cost
+//    of the series above: nothing iterates to convergence, and every
+//    element follows the same path through the loop, with the branches as
+//    selections, so that the compiler may vectorize it.
+//
+// references:
+// o  Hart, J.F., et al., 1968, Computer Approximations, John Wiley and
+//    Sons.
+//
+// o  West, Graeme, 2005, Better approximations to cumulative normal
+//    functions, Wilmott Magazine, May 2005, p. 70-76.
+//-----------------------------------------------------------------------------
+void GaussianCDF( const double* x, double* p, int n )
+{
+   const double a[] = { 220.2068679123761, 221.2135961699311, 112.0792914978709,
+                        33.91286607838300, 6.373962203531650, 0.7003830644436881,
+                        0.03526249659989109 };
+   const double b[] = { 440.4137358247522, 793.8265125199484, 637.3336333788311,
+                        296.5642487796737, 86.78073220294608, 16.06417757920695,
+                        1.755667163182642, 0.08838834764831844 };
+
+   for (int i = 0; i < n; ++i) {
+      const double y = fabs(x[i]);
+      const double e = exp(-0.5*y*y);
+
+      // Hart's rational function.
+      const double A = ((((((a[6]*y + a[5])*y + a[4])*y + a[3])*y + a[2])*y + a[1])*y + a[0]);
+      const double B = (((((((b[7]*y + b[6])*y + b[5])*y + b[4])*y + b[3])*y + b[2])*y + b[1])*y + b[0]);
+
+      // Laplace's continued fraction, to a fixed depth.
+      double C = 0.0;
+      for (int k = 12; k >= 1; --k)
+         C = k/(y + C);
+      C += y;
+
+      const double tail = (y < 7.07106781186547) ? e*A/B : e/(C*SQRT_TWO_PI);
+      p[i] = (x[i] > 0.0) ? 1.0 - tail : tail;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// GaussianCDFInv
+//
+//    The batch version: x[i] = GaussianCDFInv(p[i]) for 0 <= i < n.
+//
+// notes:
+// o  Acklam's rational approximations, with a relative error below
+//    1.15e-9, on a central region and on the tails, refined by one step of
+//    Halley's method using the batch GaussianCDF above, as in the scalar
+//    version. The refinement is done in the lower tail, q = min(p,1-p),
+//    so that it does not lose accuracy to cancellation near p = 1. The
+//    result reproduces p to a relative error below 1e-10.
+//
+// references:
+// o  Acklam, Peter J., 2003, An algorithm for computing the inverse normal
+//    cumulative distribution function. Available on-line at
+//    https://web.archive.org/web/20151030215612/http://home.online.no/~pjacklam/notes/invnorm/
+//-----------------------------------------------------------------------------
+void GaussianCDFInv( const double* p, double* x, int n )
+{
+   const double a[] = { -3.969683028665376e+01,  2.209460984245205e+02, -2.759285104469687e+02,
+                         1.383577518672690e+02, -3.066479806614716e+01,  2.506628277459239e+00 };
+   const double b[] = { -5.447609879822406e+01,  1.615858368580409e+02, -1.556989798598866e+02,
+                         6.680131188771972e+01, -1.328068155288572e+01 };
+   const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                        -2.549732539343734e+00,  4.374664141464968e+00,  2.938163982698783e+00 };
+   const double d[] = {  7.784695709041462e-03,  3.224671290700398e-01,  2.445134137142996e+00,
+                         3.754408661907416e+00 };
+   const double PLOW = 0.02425;
+
+   const int BLOCK = 256;
+   double q[BLOCK], u[BLOCK], f[BLOCK];
+
+   for (int i0 = 0; i0 < n; i0 += BLOCK) {
+      const int m = (n - i0 < BLOCK) ? n - i0 : BLOCK;
+
+      // The initial approximations, in the lower tail.
+      for (int i = 0; i < m; ++i) {
+         assert( p[i0+i] > 0 && p[i0+i] < 1 );
+         q[i] = (p[i0+i] < 0.5) ? p[i0+i] : 1.0 - p[i0+i];
+
+         const double s = q[i] - 0.5;
+         const double r = s*s;
+         const double central = (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5])*s /
+                                (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1.0);
+
+         const double t = sqrt(-2.0*log(q[i]));
+         const double tail = (((((c[0]*t + c[1])*t + c[2])*t + c[3])*t + c[4])*t + c[5]) /
+                             ((((d[0]*t + d[1])*t + d[2])*t + d[3])*t + 1.0);
+
+         u[i] = (q[i] < PLOW) ? tail : central;
+      }
+
+      // One Halley step.
+      GaussianCDF( u, f, m );
+      for (int i = 0; i < m; ++i) {
+         double t = f[i] - q[i];                   // error
+         t = t * SQRT_TWO_PI*exp(u[i]*u[i]/2);     // f(u)/df(u)
+         const double v = u[i] - t/(1 + u[i]*t/2); // Halley's update formula
+         x[i0+i] = (p[i0+i] < 0.5) ? v : -v;
+      }
+   }
+}
@@ -7,7 +7,7 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #ifndef SPEICAL_FUNCTIONS_H
 #define SPECIAL_FUNCTIONS_H
@@ -25,5 +25,8 @@ double IncompleteGammaInv( double p, double a );
 double GaussianCDF( double x );
 double GaussianCDFInv( double p );
 
+void GaussianCDF( const double* x, double* p, int n );
+void GaussianCDFInv( const double* p, double* x, int n );
+
 //=============================================================================
 #endif  // SPECIAL_FUNCTIONS_H
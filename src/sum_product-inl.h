@@ -9,7 +9,7 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #ifndef SUM_PRODUCT_H
 #define SUM_PRODUCT_H
@@ -151,5 +151,36 @@ inline double SumProduct( int n, const double* x, int dx )
    return Sum;
 }
 
+//-----------------------------------------------------------------------------
+// This routine computes a dot product between two single precision vectors.
+// The sum is accumulated in single precision, in eight independent partial
+// sums, so that the compiler can vectorize the loop without reordering the
+// arithmetic itself.
+//
+// Arguments:
+//
+//    n     total number of elements in each vector.
+//    x     pointer to the first element of the first vector.
+//    y     pointer to the first element of the second vector.
+//-----------------------------------------------------------------------------
+inline float SumProduct( int n, const float* x, const float* y )
+{
+   float Part[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+   int i = 0;
+   for (; i+8 <= n; i += 8)
+      for (int k=0; k<8; ++k)
+         Part[k] += x[i+k] * y[i+k];
+
+   float Sum = 0.0f;
+   for (int k=0; k<8; ++k)
+      Sum += Part[k];
+
+   for (; i<n; ++i)
+      Sum += x[i] * y[i];
+
+   return Sum;
+}
+
 //=============================================================================
 #endif  // SUM_PRODUCT_H
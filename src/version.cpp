@@ -7,7 +7,7 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #include <iostream>
 
@@ -88,6 +88,19 @@ void Help()
    std::cout <<
       "Example: \n"
       "   Mizhodan 3 25 3500 obs.csv target.csv results.csv \n"
+      "   Mizhodan --outliers 3 25 3500 0.01 obs.csv outliers.csv \n"
+      "   Mizhodan --sweep params.csv obs.csv target.csv results.csv scores.csv \n"
+      "   Mizhodan --estimate obs.csv params.csv \n"
+      "   Mizhodan --hmatrix 1e-8 3 25 3500 obs.csv target.csv results.csv \n"
+      "   Mizhodan --taper 10000 3 25 3500 obs.csv target.csv results.csv \n"
+      "   Mizhodan --mixed 1e-10 3 25 3500 obs.csv target.csv results.csv \n"
+      "   Mizhodan --local 16 3 25 3500 obs.csv target.csv results.csv \n"
+      "   Mizhodan --weights 0 3 25 3500 obs.csv target.csv weights.bin \n"
+      "   Mizhodan --apply weights.bin obs.csv results.csv \n"
+      "   Mizhodan --indicator-thresholds 90,95,100,105,110 0.02 0.25 3500 obs.csv target.csv ccdf.csv \n"
+      "   Mizhodan --exceedance 100,110 3 25 3500 obs.csv target.csv results.csv \n"
+      "   Mizhodan --quantiles 0.05,0.5,0.95 3 25 3500 obs.csv target.csv results.csv \n"
+      "   Mizhodan --serve 3 25 3500 obs.csv \n"
    << std::endl;
 
    std::cout <<
@@ -114,6 +127,12 @@ void Help()
       "\n"
       "   Each of the four fields must separated by a single comma. Spaces and tabs \n"
       "   at the start and end of fields are trimmed. \n"
+      "\n"
+      "   Without an option, a line may carry more than one value after <y>, as \n"
+      "   long as every line has the same number. Each value column is a separate \n"
+      "   variable with the same semi-variogram, all of them are kriged together \n"
+      "   from one factorization, and the results file has one <Zhat> column per \n"
+      "   variable. Several variables are limited to 500 observations. \n"
    << std::endl;
 
    std::cout <<
@@ -162,11 +181,171 @@ void Help()
       "                   Ordinary Kriging variance. \n"
    << std::endl;
 
+   std::cout <<
+      "Outlier Detection: \n"
+      "   With --outliers, Mizhodan computes the leave-one-out Ordinary Kriging \n"
+      "   estimate and zscore at every observation. The observation with the \n"
+      "   largest absolute zscore is removed if it is significant at the two-sided \n"
+      "   level <alpha>, and the process is repeated. The <alpha> must satisfy \n"
+      "   0 < <alpha> < 1. \n"
+      "\n"
+      "   The outliers file contains one header line, followed by one line for \n"
+      "   each outlier, in the order in which they were removed. Each line has \n"
+      "   six fields: <ID>, <x>, <y>, <z>, <Zhat>, and <Zscore>, where <Zhat> is \n"
+      "   the leave-one-out estimate and <Zscore> = (<z> - <Zhat>)/<Kstd>. \n"
+   << std::endl;
+
+   std::cout <<
+      "Parameter Sweep: \n"
+      "   With --sweep, Mizhodan runs the Ordinary Kriging once for each of the \n"
+      "   semi-variogram parameter sets in the <params file>. The separation \n"
+      "   distances are computed once, and the parameter sets are evaluated in \n"
+      "   parallel. Parameter sets that share the same <range> share a single \n"
+      "   eigendecomposition, so varying only the <nugget> and <sill> is cheap. \n"
+      "\n"
+      "   The <params file> contains no header line, and it may include blank and \n"
+      "   comment lines. Each line has three fields: <nugget>, <sill>, and \n"
+      "   <range>, all strictly positive. \n"
+      "\n"
+      "   The <results file> has the same fields as the Results File below, \n"
+      "   preceded by a <Set> field giving the 1-based index of the parameter \n"
+      "   set among those in the <params file>; blank and comment lines are not \n"
+      "   counted. \n"
+      "\n"
+      "   The <scores file> contains one line per parameter set with the fields \n"
+      "   <Set>, <Nugget>, <Sill>, <Range>, <ME>, <RMSE>, and <MSSE>: the mean, \n"
+      "   root mean squared, and mean squared standardized leave-one-out \n"
+      "   cross validation errors. A well-calibrated model has <ME> near 0 and \n"
+      "   <MSSE> near 1. \n"
+   << std::endl;
+
+   std::cout <<
+      "Hierarchical Matrix: \n"
+      "   With --hmatrix, Mizhodan uses all of the observations, as usual, but \n"
+      "   holds the covariance matrix in a compressed hierarchical (HODLR) form. \n"
+      "   The observations are clustered by recursive coordinate bisection, and \n"
+      "   the covariance between neighboring clusters is approximated by a \n"
+      "   low-rank product to the relative accuracy <tolerance>, 0 < <tolerance> \n"
+      "   < 1. The memory and time grow as N log^2 N rather than N^2 and N^3, so \n"
+      "   up to 1000000 observations are allowed. A <tolerance> of 1e-8 gives \n"
+      "   results that agree with the dense computation to several digits. \n"
+   << std::endl;
+
+   std::cout <<
+      "Covariance Tapering: \n"
+      "   With --taper, Mizhodan multiplies the exponential covariance by a \n"
+      "   compactly supported Wendland taper, which is zero beyond the <taper> \n"
+      "   distance. The Kriging system is then sparse, and is solved by a sparse \n"
+      "   Cholesky decomposition in a nested dissection order. The <taper> should \n"
+      "   be a few times the <range>; larger values are more accurate but use \n"
+      "   more memory. Up to 1000000 observations are allowed. \n"
+   << std::endl;
+
+   std::cout <<
+      "Mixed Precision: \n"
+      "   With --mixed, Mizhodan factors and solves the Kriging system in single \n"
+      "   precision, and refines each solution against the double precision \n"
+      "   system until its relative residual is below <tolerance>, 0 < \n"
+      "   <tolerance> < 1. If the refinement does not converge, the system is \n"
+      "   solved in double precision instead. This is fastest when there are \n"
+      "   many more observations than targets. Up to 10000 observations are \n"
+      "   allowed. \n"
+   << std::endl;
+
+   std::cout <<
+      "Local Neighborhood: \n"
+      "   With --local, Mizhodan kriges each target from only its <neighbors> \n"
+      "   nearest observations, 1 <= <neighbors> <= 32, rather than from all of \n"
+      "   the data. Each target has its own small Kriging system, so the time \n"
+      "   grows linearly with the number of targets, whatever the number of \n"
+      "   observations. The results differ from global Kriging where distant \n"
+      "   observations carry weight. Up to 10000000 observations are allowed. \n"
+   << std::endl;
+
+   std::cout <<
+      "Persisted Weights: \n"
+      "   The Kriging weights depend only on the locations and the variogram. \n"
+      "   With --weights, Mizhodan computes the weights of every target and \n"
+      "   saves them, with the Kriging standard deviations, in a binary <weights \n"
+      "   file>. A <keep> of 0 saves all of the weights; otherwise only the \n"
+      "   <keep> largest weights of each target are saved, rescaled to sum to \n"
+      "   one. Up to 500 observations are allowed. \n"
+      "\n"
+      "   With --apply, Mizhodan reads a <weights file> and applies it to the \n"
+      "   values in the <obs file>, which must list the same locations in the \n"
+      "   same order. The values may change from run to run; nothing is solved. \n"
+      "   Several value columns are allowed, as without an option. \n"
+   << std::endl;
+
+   std::cout <<
+      "Indicator Kriging: \n"
+      "   With --indicator-thresholds, Mizhodan estimates the conditional \n"
+      "   cumulative distribution function (ccdf) of the value at each target by \n"
+      "   median indicator Kriging. The <thresholds> are one argument: increasing \n"
+      "   numbers separated by commas, with no spaces. The <nugget>, <sill>, and \n"
+      "   <range> describe the median indicator semi-variogram, which is shared by \n"
+      "   every threshold. \n"
+      "\n"
+      "   The results file has one column F(t) for each threshold t, the \n"
+      "   probability that the value is at most t, in place of <Zhat>. Each ccdf \n"
+      "   is corrected to lie in [0,1] and to be non-decreasing. Up to 500 \n"
+      "   observations are allowed. \n"
+   << std::endl;
+
+   std::cout <<
+      "Exceedance and Quantiles: \n"
+      "   With --exceedance or --quantiles, Mizhodan kriges as without an option \n"
+      "   and treats the Kriging error at each target as Gaussian, with mean 0 and \n"
+      "   standard deviation <Kstd>. The <thresholds> or <probabilities> are one \n"
+      "   argument: increasing numbers separated by commas, with no spaces. Each \n"
+      "   probability must satisfy 0 < p < 1. \n"
+      "\n"
+      "   The results file has the usual five fields and then one more for each \n"
+      "   threshold t, P(Z>t), the probability that the value exceeds t, or for \n"
+      "   each probability p, Q(p), the value that is exceeded with probability \n"
+      "   1-p. \n"
+   << std::endl;
+
+   std::cout <<
+      "Prediction Server: \n"
+      "   With --serve, Mizhodan reads the observations and factors the Kriging \n"
+      "   system once, and then answers queries from the standard input on the \n"
+      "   standard output until the input ends or a 'quit' line is read. All \n"
+      "   other messages are written to the standard error. Up to 10000 \n"
+      "   observations are allowed. \n"
+      "\n"
+      "   A query line has the three fields of a line of the Targets File, and \n"
+      "   it is answered by a line with the five fields of a line of the Results \n"
+      "   File, in the order of the queries. Blank and comment lines are \n"
+      "   ignored, and an invalid line is answered by a line starting with \n"
+      "   '# ERROR'. A 'stats' line is answered by the number of queries so far \n"
+      "   and the median (p50) and 99th percentile (p99) latencies in \n"
+      "   microseconds. Queries that arrive together are answered together, in \n"
+      "   parallel. \n"
+   << std::endl;
+
+   std::cout <<
+      "Parameter Estimation: \n"
+      "   With --estimate, Mizhodan estimates the <nugget>, <sill>, and <range> \n"
+      "   by maximizing the restricted (REML) Gaussian likelihood of the \n"
+      "   observations; with --estimate-ml, it maximizes the full (ML) \n"
+      "   likelihood. REML accounts for the unknown mean and is the better \n"
+      "   choice for small data sets. Up to 5000 observations are allowed. \n"
+      "\n"
+      "   The <params file> contains one comment line reporting the maximized \n"
+      "   log likelihood, followed by one parameter set, so it may be used \n"
+      "   directly as the <params file> for --sweep. \n"
+   << std::endl;
+
    std::cout <<
       "Notes: \n"
       "   o  An exponential variogram model is used. \n"
       "         gamma(h) = <nugget> + (<sill>-<nugget>)*(1 - exp(-3h/<range>)) \n"
       "\n"
+      "   o  With more than 500 observations, the Kriging system is solved by \n"
+      "      preconditioned conjugate gradients, computing the covariances on \n"
+      "      the fly, so the memory grows only linearly with the observations. \n"
+      "\n"
       "   o  The project name 'Mizhodan' is the Ojibwe word for the inanimate \n"
       "      transitive verb 'hit it (in shooting)'. See [http://ojibwe.lib.umn.edu]. \n"
    << std::endl;
@@ -184,6 +363,20 @@ void Usage()
    std::cout <<
       "Usage: \n"
       "   Mizhodan <nugget> <sill> <range> <obs file> <targets file> <results file> \n"
+      "   Mizhodan --outliers <nugget> <sill> <range> <alpha> <obs file> <outliers file> \n"
+      "   Mizhodan --sweep <params file> <obs file> <targets file> <results file> <scores file> \n"
+      "   Mizhodan --hmatrix <tolerance> <nugget> <sill> <range> <obs file> <targets file> <results file> \n"
+      "   Mizhodan --taper <taper> <nugget> <sill> <range> <obs file> <targets file> <results file> \n"
+      "   Mizhodan --mixed <tolerance> <nugget> <sill> <range> <obs file> <targets file> <results file> \n"
+      "   Mizhodan --local <neighbors> <nugget> <sill> <range> <obs file> <targets file> <results file> \n"
+      "   Mizhodan --weights <keep> <nugget> <sill> <range> <obs file> <targets file> <weights file> \n"
+      "   Mizhodan --apply <weights file> <obs file> <results file> \n"
+      "   Mizhodan --indicator-thresholds <thresholds> <nugget> <sill> <range> <obs file> <targets file> <results file> \n"
+      "   Mizhodan --exceedance <thresholds> <nugget> <sill> <range> <obs file> <targets file> <results file> \n"
+      "   Mizhodan --quantiles <probabilities> <nugget> <sill> <range> <obs file> <targets file> <results file> \n"
+      "   Mizhodan --serve <nugget> <sill> <range> <obs file> \n"
+      "   Mizhodan --estimate <obs file> <params file> \n"
+      "   Mizhodan --estimate-ml <obs file> <params file> \n"
       "   Mizhodan --help \n"
       "   Mizhodan --version \n"
    << std::endl;
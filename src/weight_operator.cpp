@@ -0,0 +1,327 @@
+//=============================================================================
+// weight_operator.cpp
+//
+//    The Ordinary Kriging weights of a fixed set of targets on a fixed set
+//    of observation locations, saved once and applied to new observed
+//    values as often as needed.
+//
+// notes:
+// o  The file holds a signature, the counts N, M, and K, the observation
+//    IDs and locations, the target IDs, locations, and Kriging standard
+//    deviations, and then the column indices and weights, row by row. The
+//    numbers are written in the native byte order of the machine, so the
+//    file is only portable between machines of the same architecture.
+//
+// o  Applying the operator is a sparse matrix-vector product, or one per
+//    value column, with the rows split among the threads.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include "weight_operator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "parallel-inl.h"
+
+namespace{
+   // Manifest constants.
+   const char SIGNATURE[8] = { 'M', 'Z', 'W', 'E', 'I', 'G', 'H', '1' };
+   const int APPLY_BLOCK = 256;
+
+   //--------------------------------------------------------------------------
+   // Unformatted output and input of the numbers and strings.
+   //--------------------------------------------------------------------------
+   template <typename T>
+   void Put( std::ostream& ost, const T* p, long count )
+   {
+      ost.write( reinterpret_cast<const char*>(p), count*sizeof(T) );
+   }
+
+   template <typename T>
+   void Get( std::istream& ist, T* p, long count )
+   {
+      if (count > 0 && !ist.read( reinterpret_cast<char*>(p), count*sizeof(T) ))
+         throw InvalidWeightsFile("The weights file is truncated.");
+   }
+
+   void PutString( std::ostream& ost, const std::string& s )
+   {
+      const std::int32_t n = s.size();
+      Put( ost, &n, 1 );
+      Put( ost, s.data(), n );
+   }
+
+   std::string GetString( std::istream& ist )
+   {
+      std::int32_t n;
+      Get( ist, &n, 1 );
+      if (n < 0)
+         throw InvalidWeightsFile("The weights file is corrupt.");
+
+      std::string s( n, ' ' );
+      Get( ist, &s[0], n );
+      return s;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Life cycle.
+//-----------------------------------------------------------------------------
+WeightOperator::WeightOperator()
+:  m_K( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+// Assembly.
+//-----------------------------------------------------------------------------
+void WeightOperator::Reset( const std::vector<ObsRecord>& obs, const std::vector<TargetRecord>& targets, int K )
+{
+   assert( 0 < K && K <= static_cast<int>(obs.size()) );
+
+   m_Obs = obs;
+   for (unsigned n = 0; n < m_Obs.size(); ++n)
+      m_Obs[n].z = 0.0;
+   m_Targets = targets;
+   m_Kstd.assign( targets.size(), 0.0 );
+
+   m_K = K;
+   m_Col.assign( targets.size()*K, 0 );
+   m_Weight.assign( targets.size()*K, 0.0 );
+}
+
+void WeightOperator::SetRow( int m, const int* col, const double* w, double kstd )
+{
+   const long base = static_cast<long>(m)*m_K;
+   for (int k = 0; k < m_K; ++k) {
+      assert( k == 0 || col[k-1] < col[k] );
+      m_Col[base+k]    = col[k];
+      m_Weight[base+k] = w[k];
+   }
+   m_Kstd[m] = kstd;
+}
+
+//-----------------------------------------------------------------------------
+// The observations must be at the locations of the operator, in the same
+// order.
+//-----------------------------------------------------------------------------
+void WeightOperator::Check( const std::vector<ObsRecord>& obs ) const
+{
+   if (obs.size() != m_Obs.size()) {
+      std::stringstream message;
+      message << "The weights were computed for " << m_Obs.size() << " observations, not " << obs.size() << ".";
+      throw ObservationMismatch(message.str());
+   }
+
+   // The locations must match bit for bit, as they were saved.
+   for (unsigned n = 0; n < obs.size(); ++n) {
+      if (memcmp(&obs[n].x, &m_Obs[n].x, sizeof(double)) != 0 || memcmp(&obs[n].y, &m_Obs[n].y, sizeof(double)) != 0) {
+         std::stringstream message;
+         message << "Observation " << n+1 << " is not at the location for which the weights were computed.";
+         throw ObservationMismatch(message.str());
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// zhat = W z, for the values obs[n].z.
+//-----------------------------------------------------------------------------
+std::vector<ResultRecord> WeightOperator::Apply( const std::vector<ObsRecord>& obs ) const
+{
+   Matrix Z( obs.size(), 1 );
+   for (unsigned n = 0; n < obs.size(); ++n)
+      Z(n,0) = obs[n].z;
+
+   Matrix Zhat;
+   return Apply( obs, Z, Zhat );
+}
+
+//-----------------------------------------------------------------------------
+// Zhat = W Z, for the (N x P) values Z. The results carry the first column.
+//-----------------------------------------------------------------------------
+std::vector<ResultRecord> WeightOperator::Apply( const std::vector<ObsRecord>& obs, const Matrix& Z, Matrix& Zhat ) const
+{
+   Check( obs );
+   assert( Z.nRows() == static_cast<int>(obs.size()) && Z.nCols() > 0 );
+
+   const int M = m_Targets.size();
+   const int P = Z.nCols();
+
+   std::vector<ResultRecord> results(M);
+   Zhat.ResizeUninitialized(M, P);
+
+   ParallelFor(0, (M + APPLY_BLOCK - 1) / APPLY_BLOCK, [&](int b) {
+      const int m1 = std::min(M, (b+1)*APPLY_BLOCK);
+      for (int m = b*APPLY_BLOCK; m < m1; ++m) {
+         const int*    col = &m_Col[static_cast<long>(m)*m_K];
+         const double* w   = &m_Weight[static_cast<long>(m)*m_K];
+         double* zhat = Zhat.Base(m,0);
+
+         for (int p = 0; p < P; ++p)
+            zhat[p] = 0.0;
+         for (int k = 0; k < m_K; ++k) {
+            const double* z = Z.Base(col[k],0);
+            for (int p = 0; p < P; ++p)
+               zhat[p] += w[k] * z[p];
+         }
+
+         results[m].id   = m_Targets[m].id;
+         results[m].x    = m_Targets[m].x;
+         results[m].y    = m_Targets[m].y;
+         results[m].zhat = zhat[0];
+         results[m].kstd = m_Kstd[m];
+      }
+   });
+
+   return results;
+}
+
+//-----------------------------------------------------------------------------
+// Persistence.
+//-----------------------------------------------------------------------------
+void WeightOperator::Save( std::ostream& ost ) const
+{
+   const std::int32_t counts[3] = { static_cast<std::int32_t>(m_Obs.size()), static_cast<std::int32_t>(m_Targets.size()), m_K };
+
+   Put( ost, SIGNATURE, sizeof(SIGNATURE) );
+   Put( ost, counts, 3 );
+
+   for (unsigned n = 0; n < m_Obs.size(); ++n) {
+      PutString( ost, m_Obs[n].id );
+      Put( ost, &m_Obs[n].x, 1 );
+      Put( ost, &m_Obs[n].y, 1 );
+   }
+   for (unsigned m = 0; m < m_Targets.size(); ++m) {
+      PutString( ost, m_Targets[m].id );
+      Put( ost, &m_Targets[m].x, 1 );
+      Put( ost, &m_Targets[m].y, 1 );
+      Put( ost, &m_Kstd[m], 1 );
+   }
+
+   for (unsigned m = 0; m < m_Targets.size(); ++m) {
+      const long base = static_cast<long>(m)*m_K;
+      for (int k = 0; k < m_K; ++k) {
+         const std::int32_t col = m_Col[base+k];
+         Put( ost, &col, 1 );
+      }
+      Put( ost, &m_Weight[base], m_K );
+   }
+}
+
+void WeightOperator::Save( const std::string& filename ) const
+{
+   std::ofstream ost( filename, std::ios::binary );
+   if (ost.fail()) {
+      std::stringstream message;
+      message << "Could not open <" << filename << "> for output.";
+      throw InvalidWeightsFile(message.str());
+   }
+
+   Save( ost );
+   if (!ost) {
+      std::stringstream message;
+      message << "Writing the weights file <" << filename << "> failed.";
+      throw InvalidWeightsFile(message.str());
+   }
+}
+
+void WeightOperator::Load( std::istream& ist )
+{
+   char signature[sizeof(SIGNATURE)];
+   Get( ist, signature, sizeof(SIGNATURE) );
+   if (memcmp(signature, SIGNATURE, sizeof(SIGNATURE)) != 0)
+      throw InvalidWeightsFile("The file is not a Mizhodan weights file.");
+
+   std::int32_t counts[3];
+   Get( ist, counts, 3 );
+   const int N = counts[0], M = counts[1], K = counts[2];
+   if (N < 1 || M < 1 || K < 1 || K > N)
+      throw InvalidWeightsFile("The weights file is corrupt.");
+
+   std::vector<ObsRecord> obs(N);
+   for (int n = 0; n < N; ++n) {
+      obs[n].id = GetString( ist );
+      Get( ist, &obs[n].x, 1 );
+      Get( ist, &obs[n].y, 1 );
+   }
+
+   std::vector<TargetRecord> targets(M);
+   std::vector<double> kstd(M);
+   for (int m = 0; m < M; ++m) {
+      targets[m].id = GetString( ist );
+      Get( ist, &targets[m].x, 1 );
+      Get( ist, &targets[m].y, 1 );
+      Get( ist, &kstd[m], 1 );
+   }
+
+   // Read into a new operator, so that a failure leaves this one intact.
+   WeightOperator W;
+   W.Reset( obs, targets, K );
+   W.m_Kstd = kstd;
+
+   std::vector<std::int32_t> col(K);
+   for (int m = 0; m < M; ++m) {
+      const long base = static_cast<long>(m)*K;
+      Get( ist, col.data(), K );
+      for (int k = 0; k < K; ++k) {
+         if (col[k] < 0 || col[k] >= N || (k > 0 && col[k] <= col[k-1]))
+            throw InvalidWeightsFile("The weights file is corrupt.");
+         W.m_Col[base+k] = col[k];
+      }
+      Get( ist, &W.m_Weight[base], K );
+   }
+
+   *this = std::move(W);
+}
+
+void WeightOperator::Load( const std::string& filename )
+{
+   std::ifstream ist( filename, std::ios::binary );
+   if (ist.fail()) {
+      std::stringstream message;
+      message << "Could not open <" << filename << "> for input.";
+      throw InvalidWeightsFile(message.str());
+   }
+
+   Load( ist );
+}
+
+//-----------------------------------------------------------------------------
+// Inquiry.
+//-----------------------------------------------------------------------------
+int WeightOperator::nObservations() const
+{
+   return m_Obs.size();
+}
+
+int WeightOperator::nTargets() const
+{
+   return m_Targets.size();
+}
+
+int WeightOperator::nWeights() const
+{
+   return m_K;
+}
+
+int WeightOperator::Col( int m, int k ) const
+{
+   return m_Col[static_cast<long>(m)*m_K + k];
+}
+
+double WeightOperator::Weight( int m, int k ) const
+{
+   return m_Weight[static_cast<long>(m)*m_K + k];
+}
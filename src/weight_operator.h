@@ -0,0 +1,94 @@
+//=============================================================================
+// weight_operator.h
+//
+//    The Ordinary Kriging weights of a fixed set of targets on a fixed set
+//    of observation locations, saved once and applied to new observed
+//    values as often as needed.
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef WEIGHT_OPERATOR_H
+#define WEIGHT_OPERATOR_H
+
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+#include "matrix.h"
+#include "read_obs.h"
+#include "read_targets.h"
+
+//-----------------------------------------------------------------------------
+class InvalidWeightsFile : public std::runtime_error {
+   public :
+      InvalidWeightsFile( const std::string& message ) : std::runtime_error(message) {
+      }
+};
+
+class ObservationMismatch : public std::runtime_error {
+   public :
+      ObservationMismatch( const std::string& message ) : std::runtime_error(message) {
+      }
+};
+
+//=============================================================================
+// WeightOperator
+//
+//    The (M x N) matrix W of Kriging weights, zhat = W z, and the Kriging
+//    standard deviations of the M targets. Each row holds the same number
+//    K <= N of weights, with their column indices in increasing order; the
+//    operator is dense when K = N.
+//
+//    The Kriging weights and standard deviations depend only on the
+//    locations and the semi-variogram, so an operator built once serves
+//    every later set of values observed at the same locations.
+//=============================================================================
+class WeightOperator
+{
+public:
+   // Life cycle
+   WeightOperator();                                  // empty
+
+   // Assembly, by Weight_Engine. Distinct rows may be set concurrently.
+   void Reset( const std::vector<ObsRecord>& obs, const std::vector<TargetRecord>& targets, int K );
+   void SetRow( int m, const int* col, const double* w, double kstd );
+
+   // Operations
+   std::vector<ResultRecord> Apply( const std::vector<ObsRecord>& obs ) const;
+   std::vector<ResultRecord> Apply( const std::vector<ObsRecord>& obs, const Matrix& Z, Matrix& Zhat ) const;
+
+   // Persistence, in a native-endian binary format.
+   void Save( std::ostream& ost ) const;
+   void Save( const std::string& filename ) const;
+   void Load( std::istream& ist );
+   void Load( const std::string& filename );
+
+   // Inquiry.
+   int nObservations() const;                         // N
+   int nTargets() const;                              // M
+   int nWeights() const;                              // K, per target
+   int Col( int m, int k ) const;                     // column of a weight
+   double Weight( int m, int k ) const;               // k'th weight of row m
+
+private:
+   void Check( const std::vector<ObsRecord>& obs ) const;
+
+   std::vector<ObsRecord>    m_Obs;                   // locations only
+   std::vector<TargetRecord> m_Targets;
+   std::vector<double>       m_Kstd;
+
+   int m_K;
+   std::vector<int>    m_Col;                         // M x K, row-major
+   std::vector<double> m_Weight;                      // M x K, row-major
+};
+
+//=============================================================================
+#endif  // WEIGHT_OPERATOR_H
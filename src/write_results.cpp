@@ -9,7 +9,7 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #include <algorithm>
 #include <fstream>
@@ -45,3 +45,214 @@ void write_results( const std::string& resultsfilename, std::vector<ResultRecord
    }
    resultsfile.close();
 }
+
+//-----------------------------------------------------------------------------
+void write_results( const std::string& resultsfilename, std::vector<ResultRecord> results, const Matrix& Zhat ) {
+   // Open the results file.
+   std::ofstream resultsfile( resultsfilename );
+   if ( resultsfile.fail() ) {
+      std::stringstream message;
+      message << "Could not open <" << resultsfilename << "> for output.";
+      throw InvalidResultsFile(message.str());
+   }
+
+   // Write out the header line to the results file: one estimate column
+   // for each variable.
+   resultsfile << "ID,X,Y";
+   for ( int p = 0; p < Zhat.nCols(); ++p )
+      resultsfile << ",Zhat" << p+1;
+   resultsfile << ",Kstd" << std::endl;
+
+   // Write out the results.
+   resultsfile << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+
+   for ( unsigned n = 0; n < results.size(); ++n ) {
+      resultsfile << results[n].id << ',';
+      resultsfile << results[n].x  << ',';
+      resultsfile << results[n].y  << ',';
+      for ( int p = 0; p < Zhat.nCols(); ++p )
+         resultsfile << Zhat(n,p) << ',';
+      resultsfile << results[n].kstd;
+      resultsfile << std::endl;
+   }
+   resultsfile.close();
+}
+
+//-----------------------------------------------------------------------------
+void write_results( const std::string& resultsfilename, std::vector<ResultRecord> results, const std::vector<std::string>& titles, const Matrix& columns ) {
+   // Open the results file.
+   std::ofstream resultsfile( resultsfilename );
+   if ( resultsfile.fail() ) {
+      std::stringstream message;
+      message << "Could not open <" << resultsfilename << "> for output.";
+      throw InvalidResultsFile(message.str());
+   }
+
+   // Write out the header line to the results file: the usual fields, and
+   // then the titles of the extra columns.
+   resultsfile << "ID,X,Y,Zhat,Kstd";
+   for ( unsigned k = 0; k < titles.size(); ++k )
+      resultsfile << ',' << titles[k];
+   resultsfile << std::endl;
+
+   // Write out the results.
+   resultsfile << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+
+   for ( unsigned n = 0; n < results.size(); ++n ) {
+      resultsfile << results[n].id << ',';
+      resultsfile << results[n].x  << ',';
+      resultsfile << results[n].y  << ',';
+      resultsfile << results[n].zhat << ',';
+      resultsfile << results[n].kstd;
+      for ( int k = 0; k < columns.nCols(); ++k )
+         resultsfile << ',' << columns(n,k);
+      resultsfile << std::endl;
+   }
+   resultsfile.close();
+}
+
+//-----------------------------------------------------------------------------
+void write_ccdf( const std::string& resultsfilename, std::vector<ResultRecord> results, const std::vector<double>& thresholds, const Matrix& F ) {
+   // Open the results file.
+   std::ofstream resultsfile( resultsfilename );
+   if ( resultsfile.fail() ) {
+      std::stringstream message;
+      message << "Could not open <" << resultsfilename << "> for output.";
+      throw InvalidResultsFile(message.str());
+   }
+
+   // Write out the header line to the results file: one ccdf column for
+   // each threshold, titled by the threshold.
+   resultsfile << "ID,X,Y";
+   for ( unsigned k = 0; k < thresholds.size(); ++k )
+      resultsfile << ",F(" << thresholds[k] << ')';
+   resultsfile << ",Kstd" << std::endl;
+
+   // Write out the results.
+   resultsfile << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+
+   for ( unsigned n = 0; n < results.size(); ++n ) {
+      resultsfile << results[n].id << ',';
+      resultsfile << results[n].x  << ',';
+      resultsfile << results[n].y  << ',';
+      for ( int k = 0; k < F.nCols(); ++k )
+         resultsfile << F(n,k) << ',';
+      resultsfile << results[n].kstd;
+      resultsfile << std::endl;
+   }
+   resultsfile.close();
+}
+
+//-----------------------------------------------------------------------------
+void write_sweep( const std::string& resultsfilename, std::vector<SweepRecord> sweep ) {
+   // Open the results file.
+   std::ofstream resultsfile( resultsfilename );
+   if ( resultsfile.fail() ) {
+      std::stringstream message;
+      message << "Could not open <" << resultsfilename << "> for output.";
+      throw InvalidResultsFile(message.str());
+   }
+
+   // Write out the header line to the results file.
+   resultsfile << "Set,ID,X,Y,Zhat,Kstd" << std::endl;
+
+   // Write out the results for each parameter set in turn.
+   resultsfile << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+
+   for ( unsigned p = 0; p < sweep.size(); ++p ) {
+      const std::vector<ResultRecord>& results = sweep[p].results;
+
+      for ( unsigned n = 0; n < results.size(); ++n ) {
+         resultsfile << p+1 << ',';
+         resultsfile << results[n].id << ',';
+         resultsfile << results[n].x  << ',';
+         resultsfile << results[n].y  << ',';
+         resultsfile << results[n].zhat << ',';
+         resultsfile << results[n].kstd;
+         resultsfile << std::endl;
+      }
+   }
+   resultsfile.close();
+}
+
+//-----------------------------------------------------------------------------
+void write_scores( const std::string& scoresfilename, std::vector<SweepRecord> sweep ) {
+   // Open the scores file.
+   std::ofstream scoresfile( scoresfilename );
+   if ( scoresfile.fail() ) {
+      std::stringstream message;
+      message << "Could not open <" << scoresfilename << "> for output.";
+      throw InvalidResultsFile(message.str());
+   }
+
+   // Write out the header line to the scores file.
+   scoresfile << "Set,Nugget,Sill,Range,ME,RMSE,MSSE" << std::endl;
+
+   // Write out the cross validation scores for each parameter set.
+   scoresfile << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+
+   for ( unsigned p = 0; p < sweep.size(); ++p ) {
+      scoresfile << p+1 << ',';
+      scoresfile << sweep[p].params.nugget << ',';
+      scoresfile << sweep[p].params.sill << ',';
+      scoresfile << sweep[p].params.range << ',';
+      scoresfile << sweep[p].me << ',';
+      scoresfile << sweep[p].rmse << ',';
+      scoresfile << sweep[p].msse;
+      scoresfile << std::endl;
+   }
+   scoresfile.close();
+}
+
+//-----------------------------------------------------------------------------
+void write_outliers( const std::string& outliersfilename, const std::vector<ObsRecord>& obs, std::vector<Outlier> outliers ) {
+   // Open the outliers file.
+   std::ofstream outliersfile( outliersfilename );
+   if ( outliersfile.fail() ) {
+      std::stringstream message;
+      message << "Could not open <" << outliersfilename << "> for output.";
+      throw InvalidResultsFile(message.str());
+   }
+
+   // Write out the header line to the outliers file.
+   outliersfile << "ID,X,Y,Z,Zhat,Zscore" << std::endl;
+
+   // Write out the outliers in the order in which they were removed.
+   outliersfile << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+
+   for ( unsigned n = 0; n < outliers.size(); ++n ) {
+      const ObsRecord& s = obs[ outliers[n].index ];
+      outliersfile << s.id << ',';
+      outliersfile << s.x  << ',';
+      outliersfile << s.y  << ',';
+      outliersfile << s.z  << ',';
+      outliersfile << outliers[n].zhat << ',';
+      outliersfile << outliers[n].zscore;
+      outliersfile << std::endl;
+   }
+   outliersfile.close();
+}
+
+//-----------------------------------------------------------------------------
+void write_estimate( const std::string& paramsfilename, const EstimateRecord& estimate, bool reml ) {
+   // Open the params file.
+   std::ofstream paramsfile( paramsfilename );
+   if ( paramsfile.fail() ) {
+      std::stringstream message;
+      message << "Could not open <" << paramsfilename << "> for output.";
+      throw InvalidResultsFile(message.str());
+   }
+
+   // Write out the estimate as a comment line and a single parameter set,
+   // so that the file may be used directly with --sweep.
+   paramsfile << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+
+   paramsfile << "# " << (reml ? "REML" : "ML") << " estimate: log likelihood = " << estimate.loglik;
+   paramsfile << ", iterations = " << estimate.iterations << std::endl;
+   paramsfile << estimate.params.nugget << ',';
+   paramsfile << estimate.params.sill << ',';
+   paramsfile << estimate.params.range;
+   paramsfile << std::endl;
+
+   paramsfile.close();
+}
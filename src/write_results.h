@@ -7,7 +7,7 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #ifndef WRITE_RESULTS_H
 #define WRITE_RESULTS_H
@@ -26,6 +26,13 @@ class InvalidResultsFile : public std::runtime_error {
 
 //-----------------------------------------------------------------------------
 void write_results( const std::string& outfilename, std::vector<ResultRecord> results );
+void write_results( const std::string& outfilename, std::vector<ResultRecord> results, const Matrix& Zhat );
+void write_results( const std::string& outfilename, std::vector<ResultRecord> results, const std::vector<std::string>& titles, const Matrix& columns );
+void write_ccdf( const std::string& outfilename, std::vector<ResultRecord> results, const std::vector<double>& thresholds, const Matrix& F );
+void write_sweep( const std::string& outfilename, std::vector<SweepRecord> sweep );
+void write_scores( const std::string& outfilename, std::vector<SweepRecord> sweep );
+void write_outliers( const std::string& outfilename, const std::vector<ObsRecord>& obs, std::vector<Outlier> outliers );
+void write_estimate( const std::string& outfilename, const EstimateRecord& estimate, bool reml );
 
 
 //=============================================================================
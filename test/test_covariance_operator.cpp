@@ -0,0 +1,140 @@
+//=============================================================================
+// test_covariance_operator.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "test_covariance_operator.h"
+#include "unit_test.h"
+#include "..\src\covariance_operator.h"
+#include "..\src\matrix.h"
+#include "..\src\read_obs.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double NUGGET = 2.0;
+   const double SILL   = 25.0;
+   const double RANGE  = 400.0;
+
+   //--------------------------------------------------------------------------
+   // Scattered observation locations from a linear congruential generator.
+   //--------------------------------------------------------------------------
+   std::vector<ObsRecord> ScatteredObs( int N )
+   {
+      std::vector<ObsRecord> obs;
+      unsigned long seed = 54321;
+      for (int n = 0; n < N; ++n) {
+         seed = (1103515245*seed + 12345) % 2147483648UL;
+         double x = 8000.0 * seed / 2147483648.0;
+         seed = (1103515245*seed + 12345) % 2147483648UL;
+         double y = 3000.0 * seed / 2147483648.0;
+         ObsRecord s = { "", x, y, sin(x/700.0) + cos(y/900.0) };
+         obs.push_back(s);
+      }
+      return obs;
+   }
+
+   //--------------------------------------------------------------------------
+   // The dense covariance matrix, for comparison.
+   //--------------------------------------------------------------------------
+   void DenseCovariance( const std::vector<ObsRecord>& obs, Matrix& C )
+   {
+      const int N = obs.size();
+      C.Resize(N, N);
+      for (int i = 0; i < N; ++i)
+         for (int j = 0; j < N; ++j)
+            C(i,j) = (i == j) ? SILL : (SILL-NUGGET)*exp(-3.0*hypot(obs[i].x-obs[j].x, obs[i].y-obs[j].y)/RANGE);
+   }
+
+   //--------------------------------------------------------------------------
+   // TestCovarianceMultiply
+   //--------------------------------------------------------------------------
+   bool TestCovarianceMultiply()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(900);
+      const int N = obs.size();
+
+      CovarianceOperator A(NUGGET, SILL, RANGE, obs);
+
+      Matrix C;
+      DenseCovariance(obs, C);
+
+      Matrix x(N, 2);
+      for (int n = 0; n < N; ++n) {
+         x(n,0) = 1.0;
+         x(n,1) = obs[n].z;
+      }
+
+      Matrix y, yy, e;
+      A.Multiply(x, y);
+      Multiply_MM(C, x, yy);
+      Subtract_MM(y, yy, e);
+
+      bool flag = true;
+      flag &= CHECK( A.nRows() == N );
+      flag &= CHECK( FNorm(e) < 1e-12 * FNorm(yy) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestCovarianceSolve
+   //--------------------------------------------------------------------------
+   bool TestCovarianceSolve()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(900);
+      const int N = obs.size();
+
+      CovarianceOperator A(NUGGET, SILL, RANGE, obs);
+
+      bool flag = true;
+      flag &= CHECK( A.Factor() );
+
+      Matrix b(N, 3);
+      for (int n = 0; n < N; ++n) {
+         b(n,0) = 1.0;
+         b(n,1) = obs[n].z;
+         b(n,2) = (n % 7) - 3.0;
+      }
+
+      Matrix x;
+      int iterations;
+      flag &= CHECK( A.Solve(b, x, 1e-10, iterations) );
+      flag &= CHECK( iterations > 0 && iterations < N );
+
+      Matrix C, Cx, e;
+      DenseCovariance(obs, C);
+      Multiply_MM(C, x, Cx);
+      Subtract_MM(Cx, b, e);
+
+      flag &= CHECK( FNorm(e) < 1e-9 * FNorm(b) );
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_CovarianceOperator
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_CovarianceOperator()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestCovarianceMultiply() );
+   TALLY( TestCovarianceSolve() );
+
+   return std::make_pair( nsucc, nfail );
+}
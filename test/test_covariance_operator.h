@@ -0,0 +1,21 @@
+//=============================================================================
+// test_covariance_operator.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_COVARIANCE_OPERATOR_H
+#define TEST_COVARIANCE_OPERATOR_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_CovarianceOperator();
+
+//=============================================================================
+#endif  // TEST_COVARIANCE_OPERATOR_H
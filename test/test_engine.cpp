@@ -7,13 +7,16 @@
 //    University of Minnesota
 //
 // version:
-//    2 July 2017
+//    18 October 2026
 //=============================================================================
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "test_engine.h"
 #include "unit_test.h"
 #include "..\src\engine.h"
+#include "..\src\likelihood.h"
 
 //-----------------------------------------------------------------------------
 // Hide all of the testing details inside an unnamed namespace. This allows me
@@ -23,80 +26,634 @@ namespace{
    const double TOLERANCE = 1e-9;
 
    //--------------------------------------------------------------------------
-   // TestEngine
+   // An example data set of 101 observations.
+   //--------------------------------------------------------------------------
+   const double x_data[] = {
+        0.00,         0.00,         0.00,         0.00,         0.00,        33.33,        33.33,        33.33,        66.67,        66.67,
+      100.00,       100.00,       133.33,       166.67,       166.67,       166.67,       166.67,       200.00,       200.00,       200.00,
+      233.33,       233.33,       266.67,       266.67,       266.67,       266.67,       300.00,       300.00,       333.33,       333.33,
+      366.67,       366.67,       366.67,       366.67,       400.00,       400.00,       433.33,       433.33,       433.33,       433.33,
+      433.33,       433.33,       466.67,       466.67,       466.67,       466.67,       466.67,       500.00,       500.00,       500.00,
+      500.00,       533.33,       566.67,       566.67,       566.67,       566.67,       633.33,       633.33,       633.33,       633.33,
+      633.33,       633.33,       633.33,       633.33,       666.67,       666.67,       666.67,       666.67,       666.67,       666.67,
+      700.00,       700.00,       733.33,       733.33,       766.67,       766.67,       766.67,       766.67,       766.67,       800.00,
+      800.00,       800.00,       833.33,       833.33,       833.33,       833.33,       833.33,       833.33,       833.33,       866.67,
+      900.00,       900.00,       900.00,       900.00,       933.33,       966.67,       966.67,      1000.00,      1000.00,      1000.00,
+     1000.00 };
+
+   const double y_data[] = {
+        0.00,       500.00,       533.33,       766.67,       800.00,       100.00,       933.33,      1000.00,        33.33,        66.67,
+      133.33,       466.67,       233.33,        33.33,       133.33,       900.00,       933.33,       100.00,       300.00,      1000.00,
+       33.33,       133.33,       100.00,       500.00,       933.33,       966.67,       600.00,       766.67,       466.67,       533.33,
+      100.00,       166.67,       433.33,       600.00,       200.00,      1000.00,         0.00,       100.00,       333.33,       366.67,
+      400.00,       800.00,       133.33,       400.00,       466.67,       566.67,       933.33,        33.33,       133.33,       700.00,
+      966.67,       133.33,         0.00,       100.00,       200.00,       966.67,         0.00,        33.33,        66.67,       100.00,
+      300.00,       566.67,       633.33,       966.67,        33.33,       233.33,       600.00,       800.00,       900.00,       933.33,
+      266.67,       566.67,       600.00,       966.67,        66.67,       500.00,       600.00,       633.33,       833.33,        66.67,
+      266.67,      1000.00,        66.67,       100.00,       300.00,       366.67,       466.67,       600.00,       766.67,       166.67,
+      600.00,       666.67,       800.00,       933.33,       400.00,       100.00,       200.00,       133.33,       266.67,       566.67,
+      700.00 };
+
+   const double z_data[] = {
+      108.03,       105.52,       101.94,        95.56,        92.45,        99.34,        89.03,        83.73,       100.50,       104.06,
+      100.18,       103.07,       106.43,       101.14,       102.66,        84.75,        85.55,        96.83,        95.63,        80.58,
+       96.56,        98.94,        94.00,        89.38,        92.22,        87.94,        96.48,        73.96,        87.63,        87.43,
+       95.06,        96.27,        87.32,        82.40,       109.61,        98.02,        87.51,        90.94,        90.26,        85.98,
+       86.28,        89.04,        89.55,        95.25,        92.12,        93.75,        92.63,        92.45,        87.85,        90.83,
+       90.37,        90.94,        92.49,        89.53,        93.32,        94.75,        90.20,        92.86,        96.23,       102.72,
+      103.14,       103.66,       103.70,        96.94,        89.02,       108.95,       104.24,       109.74,       111.75,       105.77,
+      117.63,       106.17,       104.19,       102.87,       102.82,       111.26,       109.66,       114.20,       109.44,       104.45,
+      125.84,       105.78,       110.62,       116.80,       126.66,       117.21,       109.99,       101.98,       120.85,       127.80,
+      106.00,       101.03,       101.46,        96.70,       111.55,       115.76,       110.40,       113.96,       106.49,        92.68,
+      96.41 };
+
+   const int N_DATA = sizeof(x_data)/sizeof(x_data[0]);
+
+   std::vector<ObsRecord> ExampleObs()
+   {
+      std::vector<ObsRecord> obs;
+      for (int n = 0; n < N_DATA; ++n) {
+         ObsRecord s = { "", x_data[n], y_data[n], z_data[n] };
+         obs.push_back(s);
+      }
+      return obs;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestAakozi_EngineMinimum
+   //
+   //    With only the minimum number of observations, a gross outlier is
+   //    still reported, but no more are sought.
+   //--------------------------------------------------------------------------
+   bool TestAakozi_EngineMinimum()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+      obs.resize(10);
+      obs[3].z += 1000.0;
+
+      std::vector<Outlier> outliers = Aakozi_Engine(6.0, 45.0, 500.0, obs, 0.01);
+
+      bool flag = true;
+      flag &= CHECK( outliers.size() == 1 );
+      if (outliers.size() != 1) return false;
+      flag &= CHECK( outliers[0].index == 3 );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestAakozi_Engine
    //
-   //    This is simply an example problem.  The "correct" solution was
-   //    computed using the Matlab version of mizhodan.
+   //    The outliers are checked against
+   //    a brute force leave-one-out Ordinary Kriging using Engine.
    //--------------------------------------------------------------------------
-   bool TestEngine()
+   bool TestAakozi_Engine()
    {
-      static const double x_data[] = {
-           0.00,         0.00,         0.00,         0.00,         0.00,        33.33,        33.33,        33.33,        66.67,        66.67,
-         100.00,       100.00,       133.33,       166.67,       166.67,       166.67,       166.67,       200.00,       200.00,       200.00,
-         233.33,       233.33,       266.67,       266.67,       266.67,       266.67,       300.00,       300.00,       333.33,       333.33,
-         366.67,       366.67,       366.67,       366.67,       400.00,       400.00,       433.33,       433.33,       433.33,       433.33,
-         433.33,       433.33,       466.67,       466.67,       466.67,       466.67,       466.67,       500.00,       500.00,       500.00,
-         500.00,       533.33,       566.67,       566.67,       566.67,       566.67,       633.33,       633.33,       633.33,       633.33,
-         633.33,       633.33,       633.33,       633.33,       666.67,       666.67,       666.67,       666.67,       666.67,       666.67,
-         700.00,       700.00,       733.33,       733.33,       766.67,       766.67,       766.67,       766.67,       766.67,       800.00,
-         800.00,       800.00,       833.33,       833.33,       833.33,       833.33,       833.33,       833.33,       833.33,       866.67,
-         900.00,       900.00,       900.00,       900.00,       933.33,       966.67,       966.67,      1000.00,      1000.00,      1000.00,
-        1000.00 };
-
-      static const double y_data[] = {
-           0.00,       500.00,       533.33,       766.67,       800.00,       100.00,       933.33,      1000.00,        33.33,        66.67,
-         133.33,       466.67,       233.33,        33.33,       133.33,       900.00,       933.33,       100.00,       300.00,      1000.00,
-          33.33,       133.33,       100.00,       500.00,       933.33,       966.67,       600.00,       766.67,       466.67,       533.33,
-         100.00,       166.67,       433.33,       600.00,       200.00,      1000.00,         0.00,       100.00,       333.33,       366.67,
-         400.00,       800.00,       133.33,       400.00,       466.67,       566.67,       933.33,        33.33,       133.33,       700.00,
-         966.67,       133.33,         0.00,       100.00,       200.00,       966.67,         0.00,        33.33,        66.67,       100.00,
-         300.00,       566.67,       633.33,       966.67,        33.33,       233.33,       600.00,       800.00,       900.00,       933.33,
-         266.67,       566.67,       600.00,       966.67,        66.67,       500.00,       600.00,       633.33,       833.33,        66.67,
-         266.67,      1000.00,        66.67,       100.00,       300.00,       366.67,       466.67,       600.00,       766.67,       166.67,
-         600.00,       666.67,       800.00,       933.33,       400.00,       100.00,       200.00,       133.33,       266.67,       566.67,
-         700.00 };
-
-      static const double z_data[] = {
-         108.03,       105.52,       101.94,        95.56,        92.45,        99.34,        89.03,        83.73,       100.50,       104.06,
-         100.18,       103.07,       106.43,       101.14,       102.66,        84.75,        85.55,        96.83,        95.63,        80.58,
-          96.56,        98.94,        94.00,        89.38,        92.22,        87.94,        96.48,        73.96,        87.63,        87.43,
-          95.06,        96.27,        87.32,        82.40,       109.61,        98.02,        87.51,        90.94,        90.26,        85.98,
-          86.28,        89.04,        89.55,        95.25,        92.12,        93.75,        92.63,        92.45,        87.85,        90.83,
-          90.37,        90.94,        92.49,        89.53,        93.32,        94.75,        90.20,        92.86,        96.23,       102.72,
-         103.14,       103.66,       103.70,        96.94,        89.02,       108.95,       104.24,       109.74,       111.75,       105.77,
-         117.63,       106.17,       104.19,       102.87,       102.82,       111.26,       109.66,       114.20,       109.44,       104.45,
-         125.84,       105.78,       110.62,       116.80,       126.66,       117.21,       109.99,       101.98,       120.85,       127.80,
-         106.00,       101.03,       101.46,        96.70,       111.55,       115.76,       110.40,       113.96,       106.49,        92.68,
-         96.41 };
-
-      std::vector<double>x( x_data, x_data + sizeof(x_data)/sizeof(x_data[0]) );
-      std::vector<double>y( y_data, y_data + sizeof(y_data)/sizeof(y_data[0]) );
-      std::vector<double>z( z_data, z_data + sizeof(z_data)/sizeof(z_data[0]) );
-
-   /*
+      std::vector<ObsRecord> obs = ExampleObs();
+      const int N = obs.size();
+
+      const double nugget = 6.0;
+      const double sill   = 45.0;
+      const double range  = 500.0;
+
       std::vector<Outlier> outliers;
-      outliers = Aakozi_Engine(x,y,z,0.01);
+      outliers = Aakozi_Engine(nugget, sill, range, obs, 0.01);
 
       bool flag = true;
 
       flag &= CHECK( outliers.size() == 3 );
+      if (outliers.size() != 3) return false;
 
       flag &= CHECK( outliers[0].index == 34 );
-      flag &= CHECK( isClose(outliers[0].zhat,    93.5148160515804, TOLERANCE) );
-      flag &= CHECK( isClose(outliers[0].zscore,  3.43970663681202, TOLERANCE) );
-
       flag &= CHECK( outliers[1].index == 88 );
-      flag &= CHECK( isClose(outliers[1].zhat,    106.083204587754, TOLERANCE) );
-      flag &= CHECK( isClose(outliers[1].zscore,  3.06606747002609, TOLERANCE) );
-
       flag &= CHECK( outliers[2].index == 27 );
-      flag &= CHECK( isClose(outliers[2].zhat,    90.5745922395216, TOLERANCE) );
-      flag &= CHECK( isClose(outliers[2].zscore, -2.83612404250454, TOLERANCE) );
+
+      // Each leave-one-out statistic must match a brute force Ordinary
+      // Kriging of the outlier location using the remaining observations.
+      std::vector<int> removed;
+
+      for (unsigned k = 0; k < outliers.size(); ++k) {
+         const int i = outliers[k].index;
+         removed.push_back(i);
+
+         std::vector<ObsRecord> others;
+         for (int n = 0; n < N; ++n)
+            if (std::find(removed.begin(), removed.end(), n) == removed.end())
+               others.push_back(obs[n]);
+
+         TargetRecord target = { "", obs[i].x, obs[i].y };
+         std::vector<TargetRecord> targets(1, target);
+
+         std::vector<ResultRecord> results;
+         results = Engine(nugget, sill, range, others, targets);
+
+         double zscore = (obs[i].z - results[0].zhat) / results[0].kstd;
+
+         flag &= CHECK( isClose(outliers[k].zhat,   results[0].zhat, TOLERANCE) );
+         flag &= CHECK( isClose(outliers[k].zscore, zscore,          TOLERANCE) );
+      }
 
       return flag;
-   */
+   }
+
+   //--------------------------------------------------------------------------
+   // TestSweep_Engine
+   //
+   //    The sweep results must match separate runs of Engine, and the cross
+   //    validation scores must match a brute force leave-one-out.
+   //--------------------------------------------------------------------------
+   bool TestSweep_Engine()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+      const int N = obs.size();
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 4; ++i) {
+         TargetRecord s = { "", 100.0 + 250.0*i, 900.0 - 200.0*i };
+         targets.push_back(s);
+      }
+
+      ParamsRecord p0 = { 3.0, 25.0, 3500.0 };
+      ParamsRecord p1 = { 6.0, 45.0, 500.0 };
+      ParamsRecord p2 = { 10.0, 100.0, 500.0 };
 
-      return true;
+      // The last two sets share a range, so they use the eigendecomposition.
+      std::vector<ParamsRecord> params;
+      params.push_back(p0);
+      params.push_back(p1);
+      params.push_back(p2);
+
+      std::vector<SweepRecord> sweep;
+      sweep = Sweep_Engine(params, obs, targets);
+
+      bool flag = true;
+
+      flag &= CHECK( sweep.size() == 3 );
+      if (sweep.size() != 3) return false;
+
+      for (unsigned p = 0; p < params.size(); ++p) {
+         std::vector<ResultRecord> results;
+         results = Engine(params[p].nugget, params[p].sill, params[p].range, obs, targets);
+
+         for (unsigned m = 0; m < targets.size(); ++m) {
+            flag &= CHECK( isClose(sweep[p].results[m].zhat, results[m].zhat, TOLERANCE) );
+            flag &= CHECK( isClose(sweep[p].results[m].kstd, results[m].kstd, TOLERANCE) );
+         }
+      }
+
+      // Brute force leave-one-out for the second parameter set.
+      double se = 0.0, sse = 0.0, ssse = 0.0;
+      for (int i = 0; i < N; ++i) {
+         std::vector<ObsRecord> others(obs);
+         others.erase(others.begin() + i);
+
+         TargetRecord target = { "", obs[i].x, obs[i].y };
+         std::vector<TargetRecord> one(1, target);
+
+         std::vector<ResultRecord> results;
+         results = Engine(p1.nugget, p1.sill, p1.range, others, one);
+
+         double e = obs[i].z - results[0].zhat;
+         se   += e;
+         sse  += e*e;
+         ssse += e*e/(results[0].kstd*results[0].kstd);
+      }
+
+      flag &= CHECK( isClose(sweep[1].me,   se/N,         TOLERANCE) );
+      flag &= CHECK( isClose(sweep[1].rmse, sqrt(sse/N),  TOLERANCE) );
+      flag &= CHECK( isClose(sweep[1].msse, ssse/N,       TOLERANCE) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestMultiple_Engine
+   //
+   //    Kriging several variables together must match kriging each one
+   //    alone. 300 targets span more than one block of weights.
+   //--------------------------------------------------------------------------
+   bool TestMultiple_Engine()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      const int P = 3;
+      Matrix Z(N_DATA, P);
+      for (int n = 0; n < N_DATA; ++n) {
+         Z(n,0) = z_data[n];
+         Z(n,1) = 50.0 - 2.0*z_data[n];
+         Z(n,2) = z_data[n] * x_data[n] / 1000.0;
+      }
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 300; ++i) {
+         TargetRecord s = { "", 3.3*i, 1000.0 - 2.9*i };
+         targets.push_back(s);
+      }
+
+      Matrix Zhat;
+      std::vector<ResultRecord> multiple = Engine(6.0, 45.0, 500.0, obs, Z, targets, Zhat);
+
+      bool flag = true;
+      flag &= CHECK( Zhat.nRows() == 300 && Zhat.nCols() == P );
+
+      for (int p = 0; p < P; ++p) {
+         for (int n = 0; n < N_DATA; ++n)
+            obs[n].z = Z(n,p);
+         std::vector<ResultRecord> alone = Engine(6.0, 45.0, 500.0, obs, targets);
+
+         for (unsigned m = 0; m < targets.size(); ++m) {
+            flag &= CHECK( isClose(Zhat(m,p), alone[m].zhat, TOLERANCE) );
+            flag &= CHECK( isClose(multiple[m].kstd, alone[m].kstd, TOLERANCE) );
+         }
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestIndicator_Engine
+   //
+   //    Every ccdf lies in [0,1] and is non-decreasing. Where the kriged
+   //    indicators already are, they are unchanged.
+   //--------------------------------------------------------------------------
+   bool TestIndicator_Engine()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      std::vector<double> thresholds;
+      for (int k = 0; k < 7; ++k)
+         thresholds.push_back( 85.0 + 5.0*k );
+      const int K = thresholds.size();
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 50; ++i) {
+         TargetRecord s = { "", 20.0*i, 1000.0 - 19.0*i };
+         targets.push_back(s);
+      }
+
+      Matrix F;
+      std::vector<ResultRecord> results = Indicator_Engine(0.02, 0.25, 300.0, obs, thresholds, targets, F);
+
+      bool flag = true;
+      flag &= CHECK( F.nRows() == 50 && F.nCols() == K );
+
+      // The indicators kriged one at a time.
+      Matrix raw(50, K);
+      for (int k = 0; k < K; ++k) {
+         for (int n = 0; n < N_DATA; ++n)
+            obs[n].z = (z_data[n] <= thresholds[k]) ? 1.0 : 0.0;
+         std::vector<ResultRecord> alone = Engine(0.02, 0.25, 300.0, obs, targets);
+         for (int m = 0; m < 50; ++m)
+            raw(m,k) = alone[m].zhat;
+      }
+
+      int corrected = 0;
+      for (int m = 0; m < 50; ++m) {
+         bool valid = true;
+         for (int k = 0; k < K; ++k) {
+            flag &= CHECK( 0.0 <= F(m,k) && F(m,k) <= 1.0 );
+            if (k > 0)
+               flag &= CHECK( F(m,k-1) <= F(m,k) );
+            valid &= ( 0.0 <= raw(m,k) && raw(m,k) <= 1.0 && (k == 0 || raw(m,k-1) <= raw(m,k)) );
+         }
+
+         if (valid) {
+            for (int k = 0; k < K; ++k)
+               flag &= CHECK( isClose(F(m,k), raw(m,k), TOLERANCE) );
+         }
+         else
+            ++corrected;
+      }
+      flag &= CHECK( 0 < corrected && corrected < 50 );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestExceedance
+   //
+   //    The exceedance probabilities and the quantiles are consistent with
+   //    each other and with the Kriging results.
+   //--------------------------------------------------------------------------
+   bool TestExceedance()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 40; ++i) {
+         TargetRecord s = { "", 25.0*i, 1000.0 - 20.0*i };
+         targets.push_back(s);
+      }
+
+      std::vector<ResultRecord> results = Engine(6.0, 45.0, 500.0, obs, targets);
+
+      const double p[] = { 0.01, 0.25, 0.5, 0.75, 0.99 };
+      std::vector<double> probabilities( p, p+5 );
+      Matrix Q;
+      Quantiles(results, probabilities, Q);
+
+      bool flag = true;
+      flag &= CHECK( Q.nRows() == 40 && Q.nCols() == 5 );
+
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         flag &= CHECK( isClose(Q(m,2), results[m].zhat, TOLERANCE) );
+
+         std::vector<double> thresholds( Q.Base(m,0), Q.Base(m,0) + 5 );
+         std::vector<ResultRecord> one(1, results[m]);
+         Matrix P;
+         Exceedance(one, thresholds, P);
+         for (int k = 0; k < 5; ++k)
+            flag &= CHECK( isClose(P(0,k), 1.0 - p[k], TOLERANCE) );
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestHierarchical_Engine
+   //--------------------------------------------------------------------------
+   bool TestHierarchical_Engine()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 4; ++i) {
+         TargetRecord s = { "", 100.0 + 250.0*i, 900.0 - 200.0*i };
+         targets.push_back(s);
+      }
+
+      std::vector<ResultRecord> dense = Engine(6.0, 45.0, 500.0, obs, targets);
+      std::vector<ResultRecord> hier  = Hierarchical_Engine(6.0, 45.0, 500.0, obs, targets, 1e-10);
+
+      bool flag = true;
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         flag &= CHECK( isClose(hier[m].zhat, dense[m].zhat, 1e-6) );
+         flag &= CHECK( isClose(hier[m].kstd, dense[m].kstd, 1e-6) );
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestIterative_Engine
+   //
+   //    With more than 500 observations, Engine solves iteratively. The
+   //    example data are tiled six times to exceed the threshold.
+   //--------------------------------------------------------------------------
+   bool TestIterative_Engine()
+   {
+      std::vector<ObsRecord> obs;
+      for (int k = 0; k < 6; ++k) {
+         std::vector<ObsRecord> tile = ExampleObs();
+         for (unsigned n = 0; n < tile.size(); ++n) {
+            tile[n].x += 1500.0*k;
+            obs.push_back(tile[n]);
+         }
+      }
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 40; ++i) {
+         TargetRecord s = { "", 100.0 + 220.0*i, 900.0 - 20.0*i };
+         targets.push_back(s);
+      }
+
+      std::vector<ResultRecord> iter = Engine(6.0, 45.0, 500.0, obs, targets);
+      std::vector<ResultRecord> hier = Hierarchical_Engine(6.0, 45.0, 500.0, obs, targets, 1e-12);
+
+      bool flag = true;
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         flag &= CHECK( isClose(iter[m].zhat, hier[m].zhat, 1e-6) );
+         flag &= CHECK( isClose(iter[m].kstd, hier[m].kstd, 1e-6) );
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestTapered_Engine
+   //
+   //    A taper much longer than the data extent changes nothing.
+   //--------------------------------------------------------------------------
+   bool TestTapered_Engine()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 4; ++i) {
+         TargetRecord s = { "", 100.0 + 250.0*i, 900.0 - 200.0*i };
+         targets.push_back(s);
+      }
+
+      std::vector<ResultRecord> dense = Engine(6.0, 45.0, 500.0, obs, targets);
+      std::vector<ResultRecord> taper = Tapered_Engine(6.0, 45.0, 500.0, obs, targets, 1e7);
+
+      bool flag = true;
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         flag &= CHECK( isClose(taper[m].zhat, dense[m].zhat, 1e-4) );
+         flag &= CHECK( isClose(taper[m].kstd, dense[m].kstd, 1e-4) );
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestLocal_Engine
+   //
+   //    With every observation in the neighborhood, local Kriging is global
+   //    Kriging; otherwise it is global Kriging of the nearest observations.
+   //--------------------------------------------------------------------------
+   bool TestLocal_Engine()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 4; ++i) {
+         TargetRecord s = { "", 100.0 + 250.0*i, 900.0 - 200.0*i };
+         targets.push_back(s);
+      }
+      TargetRecord far = { "", -3.0e5, 4.0e5 };
+      targets.push_back(far);
+
+      bool flag = true;
+
+      // All of the observations.
+      std::vector<ObsRecord> some(obs.begin(), obs.begin() + 30);
+      std::vector<ResultRecord> dense = Engine(6.0, 45.0, 500.0, some, targets);
+      std::vector<ResultRecord> local = Local_Engine(6.0, 45.0, 500.0, some, targets, 30);
+
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         flag &= CHECK( isClose(local[m].zhat, dense[m].zhat, TOLERANCE) );
+         flag &= CHECK( isClose(local[m].kstd, dense[m].kstd, TOLERANCE) );
+      }
+
+      // The nearest 12, found by brute force.
+      const int K = 12;
+      local = Local_Engine(6.0, 45.0, 500.0, obs, targets, K);
+
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         std::vector< std::pair<double,int> > order;
+         for (unsigned n = 0; n < obs.size(); ++n)
+            order.push_back( std::make_pair(hypot(obs[n].x - targets[m].x, obs[n].y - targets[m].y), n) );
+         std::sort(order.begin(), order.end());
+
+         std::vector<ObsRecord> nearest;
+         for (int k = 0; k < K; ++k)
+            nearest.push_back( obs[order[k].second] );
+         std::vector<TargetRecord> one(1, targets[m]);
+         std::vector<ResultRecord> exact = Engine(6.0, 45.0, 500.0, nearest, one);
+
+         flag &= CHECK( isClose(local[m].zhat, exact[0].zhat, TOLERANCE) );
+         flag &= CHECK( isClose(local[m].kstd, exact[0].kstd, TOLERANCE) );
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestLocal_EngineOneLocation
+   //
+   //    Observations that all share one location make the grid cells tiny;
+   //    a distant target must still be found quickly. Every weight is the
+   //    same, so the estimate is the mean.
+   //--------------------------------------------------------------------------
+   bool TestLocal_EngineOneLocation()
+   {
+      std::vector<ObsRecord> obs;
+      double mean = 0.0;
+      for (int n = 0; n < 20; ++n) {
+         ObsRecord s = { "", 500.0, 500.0, 10.0 + n };
+         obs.push_back(s);
+         mean += s.z / 20;
+      }
+
+      std::vector<TargetRecord> targets;
+      TargetRecord near = { "", 510.0, 490.0 }, far = { "", 1.0e6, -2.0e6 };
+      targets.push_back(near);
+      targets.push_back(far);
+
+      std::vector<ResultRecord> local = Local_Engine(6.0, 45.0, 500.0, obs, targets, 20);
+
+      bool flag = true;
+      for (unsigned m = 0; m < targets.size(); ++m)
+         flag &= CHECK( isClose(local[m].zhat, mean, TOLERANCE) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestLocal_EngineCache
+   //
+   //    A tight cluster of targets shares one neighborhood, so only the
+   //    first target factors it, and the reuse changes nothing.
+   //--------------------------------------------------------------------------
+   bool TestLocal_EngineCache()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 20; ++i) {
+         TargetRecord s = { "", 450.0 + 0.1*(i%5), 450.0 + 0.1*(i/5) };
+         targets.push_back(s);
+      }
+
+      CacheRecord cache = { -1, -1 };
+      std::vector<ResultRecord> local = Local_Engine(6.0, 45.0, 500.0, obs, targets, 16, &cache);
+
+      bool flag = true;
+      flag &= CHECK( cache.lookups == 20 );
+      flag &= CHECK( cache.hits == 19 );
+
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         std::vector<TargetRecord> one(1, targets[m]);
+         std::vector<ResultRecord> alone = Local_Engine(6.0, 45.0, 500.0, obs, one, 16);
+         flag &= CHECK( isClose(local[m].zhat, alone[0].zhat, TOLERANCE) );
+         flag &= CHECK( isClose(local[m].kstd, alone[0].kstd, TOLERANCE) );
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestMixed_Engine
+   //
+   //    The refined single precision solutions match the double precision
+   //    ones, both for a well conditioned system and for a nearly singular
+   //    one that needs the double precision fallback. Duplicated locations
+   //    with a tiny nugget make the single precision decomposition fail.
+   //--------------------------------------------------------------------------
+   bool TestMixed_Engine()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 40; ++i) {
+         TargetRecord s = { "", 25.0*i, 1000.0 - 20.0*i };
+         targets.push_back(s);
+      }
+
+      bool flag = true;
+
+      const double nuggets[] = { 6.0, 1e-9 };
+      for (int k = 0; k < 2; ++k) {
+         std::vector<ResultRecord> dense = Engine(nuggets[k], 45.0, 5000.0, obs, targets);
+         std::vector<ResultRecord> mixed = Mixed_Engine(nuggets[k], 45.0, 5000.0, obs, targets, 1e-12);
+
+         for (unsigned m = 0; m < targets.size(); ++m) {
+            flag &= CHECK( isClose(mixed[m].zhat, dense[m].zhat, 1e-8) );
+            flag &= CHECK( isClose(mixed[m].kstd, dense[m].kstd, 1e-6) );
+         }
+      }
+
+      std::vector<ObsRecord> twins;
+      for (int n = 0; n < 20; ++n) {
+         ObsRecord s = { "", 100.0*(n/2), 50.0*(n/2), 1.0 + 0.1*n };
+         twins.push_back(s);
+      }
+
+      std::vector<ResultRecord> dense = Engine(1e-9, 1.0, 1000.0, twins, targets);
+      std::vector<ResultRecord> mixed = Mixed_Engine(1e-9, 1.0, 1000.0, twins, targets, 1e-12);
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         flag &= CHECK( isClose(mixed[m].zhat, dense[m].zhat, 1e-6) );
+         flag &= CHECK( isClose(mixed[m].kstd, dense[m].kstd, 1e-6) );
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestEstimate_Engine
+   //
+   //    The reported log likelihood must match the likelihood at the estimate,
+   //    and perturbing the estimate must not increase it.
+   //--------------------------------------------------------------------------
+   bool TestEstimate_Engine()
+   {
+      std::vector<ObsRecord> obs = ExampleObs();
+
+      bool flag = true;
+
+      for (int reml = 0; reml < 2; ++reml) {
+         EstimateRecord estimate = Estimate_Engine(obs, reml);
+         const ParamsRecord& p = estimate.params;
+
+         flag &= CHECK( p.nugget > 0.0 && p.sill > p.nugget && p.range > 0.0 );
+
+         double f;
+         flag &= CHECK( NegativeLogLikelihood(obs, p.nugget, p.sill, p.range, reml, f) );
+         flag &= CHECK( isClose(estimate.loglik, -f, TOLERANCE) );
+
+         const double scale[2] = { 0.9, 1.1 };
+         for (int k = 0; k < 2; ++k) {
+            double g;
+            NegativeLogLikelihood(obs, p.nugget, p.nugget + scale[k]*(p.sill - p.nugget), p.range, reml, g);
+            flag &= CHECK( g > f );
+
+            NegativeLogLikelihood(obs, p.nugget, p.sill, scale[k]*p.range, reml, g);
+            flag &= CHECK( g > f );
+         }
+      }
+
+      return flag;
    }
 }
 
@@ -109,7 +666,20 @@ std::pair<int,int> test_Engine()
    int nsucc = 0;
    int nfail = 0;
 
-   TALLY( TestEngine() );
+   TALLY( TestAakozi_Engine() );
+   TALLY( TestAakozi_EngineMinimum() );
+   TALLY( TestSweep_Engine() );
+   TALLY( TestMultiple_Engine() );
+   TALLY( TestIndicator_Engine() );
+   TALLY( TestExceedance() );
+   TALLY( TestHierarchical_Engine() );
+   TALLY( TestIterative_Engine() );
+   TALLY( TestTapered_Engine() );
+   TALLY( TestMixed_Engine() );
+   TALLY( TestLocal_Engine() );
+   TALLY( TestLocal_EngineOneLocation() );
+   TALLY( TestLocal_EngineCache() );
+   TALLY( TestEstimate_Engine() );
 
    return std::make_pair( nsucc, nfail );
 }
@@ -0,0 +1,176 @@
+//=============================================================================
+// test_fixed_matrix.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "test_fixed_matrix.h"
+#include "unit_test.h"
+#include "..\src\fixed_matrix-inl.h"
+#include "..\src\linear_systems.h"
+#include "..\src\matrix.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double TOLERANCE = 1e-9;
+
+   //--------------------------------------------------------------------------
+   // TestFixedCholesky
+   //
+   //    The same example as TestPackedCholesky.
+   //--------------------------------------------------------------------------
+   bool TestFixedCholesky()
+   {
+      const double a[] = { 4,6,4,4, 6,10,9,7, 4,9,17,11, 4,7,11,18 };
+      FixedMatrix<4,4> A;
+      for (int k = 0; k < 16; ++k)
+         A.Base()[k] = a[k];
+
+      bool flag = true;
+      flag &= CHECK( A.nRows() == 4 && A.nCols() == 4 );
+      flag &= CHECK( CholeskyDecomposition(A) );
+
+      const double l[] = { 2,0,0,0, 3,1,0,0, 2,3,2,0, 2,1,2,3 };
+      for (int i = 0; i < 4; ++i)
+         for (int j = 0; j <= i; ++j)
+            flag &= CHECK( isClose(A(i,j), l[4*i+j], TOLERANCE) );
+
+      const double b[] = { 44,4, 81,2, 117,1, 123,0 };
+      const double x[] = { 1,17.875, 2,-12.75, 3,3.25, 4,-1 };
+      FixedMatrix<4,2> B;
+      for (int k = 0; k < 8; ++k)
+         B.Base()[k] = b[k];
+      CholeskySolve(A, B);
+      for (int k = 0; k < 8; ++k)
+         flag &= CHECK( isClose(B.Base()[k], x[k], TOLERANCE) );
+
+      FixedMatrix<2,2> S;
+      S(0,0) = 1;  S(1,0) = 2;  S(1,1) = 1;
+      flag &= CHECK( !CholeskyDecomposition(S) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestFixedBatch
+   //
+   //    Each lane of a batch agrees with the same system solved alone, and
+   //    a lane that is not positive definite does not disturb the others.
+   //--------------------------------------------------------------------------
+   bool TestFixedBatch()
+   {
+      const int K = 5, L = 4;
+      FixedBatch<K,K,L> A;
+      FixedBatch<K,2,L> B;
+      FixedMatrix<K,K> S[L];
+      FixedMatrix<K,2> T[L];
+
+      for (int l = 0; l < L; ++l) {
+         for (int i = 0; i < K; ++i) {
+            for (int j = 0; j <= i; ++j)
+               S[l](i,j) = A(i,j)[l] = exp( -(0.2 + 0.1*l)*(i-j) );
+            T[l](i,0) = B(i,0)[l] = i - 2.0*l;
+            T[l](i,1) = B(i,1)[l] = 1.0;
+         }
+      }
+
+      bool flag = true;
+      flag &= CHECK( A.nLanes() == L );
+      flag &= CHECK( CholeskyDecomposition(A) );
+      CholeskySolve(A, B);
+
+      for (int l = 0; l < L; ++l) {
+         CholeskyDecomposition(S[l]);
+         CholeskySolve(S[l], T[l]);
+         for (int i = 0; i < K; ++i)
+            for (int c = 0; c < 2; ++c)
+               flag &= CHECK( isClose(B(i,c)[l], T[l](i,c), TOLERANCE) );
+      }
+
+      FixedBatch<2,2,L> P;
+      for (int l = 0; l < L; ++l) {
+         P(0,0)[l] = 1.0;  P(1,0)[l] = 0.5;  P(1,1)[l] = 1.0;
+      }
+      P(1,0)[2] = 2.0;
+      flag &= CHECK( !CholeskyDecomposition(P) );
+      flag &= CHECK( isClose(P(1,1)[0], sqrt(0.75), TOLERANCE) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // The order seen by FixedDispatch, and a solve of that order checked
+   // against the dynamic Matrix routines.
+   //--------------------------------------------------------------------------
+   struct Probe {
+      int order;
+      double discrepancy;
+
+      template <int K>
+      void Run() {
+         order = K;
+
+         FixedMatrix<K,K> A;
+         FixedMatrix<K,1> b;
+         Matrix D(K, K), c(K, 1);
+         for (int i = 0; i < K; ++i) {
+            for (int j = 0; j < K; ++j)
+               D(i,j) = A(i,j) = exp( -0.3*std::abs(i-j) );
+            c(i,0) = b(i,0) = i + 1.0;
+         }
+
+         Matrix L, y;
+         CholeskyDecomposition(D, L);
+         CholeskySolve(L, c, y);
+
+         CholeskyDecomposition(A);
+         CholeskySolve(A, b);
+
+         discrepancy = 0.0;
+         for (int i = 0; i < K; ++i)
+            discrepancy = std::max( discrepancy, std::fabs(b(i,0) - y(i,0)) );
+      }
+   };
+
+   //--------------------------------------------------------------------------
+   // TestFixedDispatch
+   //--------------------------------------------------------------------------
+   bool TestFixedDispatch()
+   {
+      bool flag = true;
+      for (int k = 1; k <= MAXIMUM_FIXED_ORDER; ++k) {
+         Probe probe = { 0, 1.0 };
+         FixedDispatch<>::Call(k, probe);
+         flag &= CHECK( probe.order == k );
+         flag &= CHECK( probe.discrepancy < TOLERANCE );
+      }
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_FixedMatrix
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_FixedMatrix()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestFixedCholesky() );
+   TALLY( TestFixedBatch() );
+   TALLY( TestFixedDispatch() );
+
+   return std::make_pair( nsucc, nfail );
+}
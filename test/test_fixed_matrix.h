@@ -0,0 +1,21 @@
+//=============================================================================
+// test_fixed_matrix.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_FIXED_MATRIX_H
+#define TEST_FIXED_MATRIX_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_FixedMatrix();
+
+//=============================================================================
+#endif  // TEST_FIXED_MATRIX_H
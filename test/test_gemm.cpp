@@ -0,0 +1,196 @@
+//=============================================================================
+// test_gemm.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "test_gemm.h"
+#include "unit_test.h"
+#include "..\src\gemm.h"
+#include "..\src\matrix.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double TOLERANCE = 1e-12;
+
+   //--------------------------------------------------------------------------
+   // A reproducible (m x n) array of values in [-1,1), with leading
+   // dimension ld >= n.
+   //--------------------------------------------------------------------------
+   std::vector<double> Fill( int m, int n, int ld, unsigned seed )
+   {
+      std::vector<double> A( static_cast<long>(m)*ld, 99.0 );
+      for (int i = 0; i < m; ++i)
+         for (int j = 0; j < n; ++j) {
+            seed = seed*1103515245u + 12345u;
+            A[static_cast<long>(i)*ld + j] = ((seed >> 8) % 2001) / 1000.0 - 1.0;
+         }
+      return A;
+   }
+
+   //--------------------------------------------------------------------------
+   // The largest relative difference between Gemm and the textbook triple
+   // loop, for one shape and one pair of transposes. The leading dimensions
+   // are padded, so that the strides are exercised, too.
+   //--------------------------------------------------------------------------
+   double Discrepancy( bool transA, bool transB, int M, int N, int K )
+   {
+      const int ra = transA ? K : M,  ca = transA ? M : K,  lda = ca + 3;
+      const int rb = transB ? N : K,  cb = transB ? K : N,  ldb = cb + 1;
+      const int ldc = N + 2;
+
+      std::vector<double> A = Fill( ra, ca, lda, 17 );
+      std::vector<double> B = Fill( rb, cb, ldb, 29 );
+      std::vector<double> C( static_cast<long>(M)*ldc, -7.0 );
+
+      Gemm( transA, transB, M, N, K, A.data(), lda, B.data(), ldb, C.data(), ldc );
+
+      double worst = 0.0;
+      for (int i = 0; i < M; ++i) {
+         for (int j = 0; j < N; ++j) {
+            double sum = 0.0;
+            for (int k = 0; k < K; ++k) {
+               const double a = transA ? A[static_cast<long>(k)*lda + i] : A[static_cast<long>(i)*lda + k];
+               const double b = transB ? B[static_cast<long>(j)*ldb + k] : B[static_cast<long>(k)*ldb + j];
+               sum += a*b;
+            }
+            const double c = C[static_cast<long>(i)*ldc + j];
+            worst = std::max( worst, std::fabs(c - sum) / (1.0 + std::fabs(sum)) );
+         }
+
+         // The padding between the rows of C is untouched.
+         for (int j = N; j < ldc; ++j)
+            if (!isClose(C[static_cast<long>(i)*ldc + j], -7.0, TOLERANCE))
+               return 1.0;
+      }
+      return worst;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestGemm
+   //
+   //    Every pair of transposes, for shapes that are smaller than, equal
+   //    to, and not multiples of, the register and cache blocks.
+   //--------------------------------------------------------------------------
+   bool TestGemm()
+   {
+      const int shapes[][3] = {
+         {1, 1, 1}, {3, 5, 2}, {6, 8, 256}, {7, 9, 1}, {13, 17, 300},
+         {121, 33, 257}, {50, 250, 70}, {245, 19, 513}
+      };
+
+      bool flag = true;
+      for (const auto& s : shapes)
+         for (int t = 0; t < 4; ++t)
+            flag &= CHECK( Discrepancy( t & 1, t & 2, s[0], s[1], s[2] ) < TOLERANCE );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestGemmEmpty
+   //
+   //    K = 0 is the zero matrix.
+   //--------------------------------------------------------------------------
+   bool TestGemmEmpty()
+   {
+      std::vector<double> C(12, 5.0);
+      Gemm( false, false, 3, 4, 0, nullptr, 1, nullptr, 4, C.data(), 4 );
+
+      bool flag = true;
+      for (double c : C)
+         flag &= CHECK( isClose(c, 0.0, TOLERANCE) );
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestGemmSerial
+   //
+   //    A large product computed without threads agrees with the threaded
+   //    one.
+   //--------------------------------------------------------------------------
+   bool TestGemmSerial()
+   {
+      const int M = 250, N = 200, K = 180;
+      std::vector<double> A = Fill( M, K, K, 11 );
+      std::vector<double> B = Fill( K, N, N, 13 );
+      std::vector<double> C1( static_cast<long>(M)*N ), C2( static_cast<long>(M)*N );
+
+      Gemm( false, false, M, N, K, A.data(), K, B.data(), N, C1.data(), N );
+      Gemm( false, false, M, N, K, A.data(), K, B.data(), N, C2.data(), N, false );
+
+      bool flag = true;
+      for (long i = 0; i < static_cast<long>(M)*N; ++i)
+         flag &= CHECK( isClose(C1[i], C2[i], TOLERANCE) );
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestGemmMatrix
+   //
+   //    The four Matrix products agree with one another, through the
+   //    transposes, at a size that takes the packed path.
+   //--------------------------------------------------------------------------
+   bool TestGemmMatrix()
+   {
+      const int m = 70, n = 90, k = 110;
+      std::vector<double> a = Fill( m, k, k, 3 );
+      std::vector<double> b = Fill( k, n, n, 5 );
+
+      Matrix A(m, k, a.data()), B(k, n, b.data());
+
+      Matrix At, Bt;
+      Transpose(A, At);
+      Transpose(B, Bt);
+
+      Matrix C1, C2, C3, C4;
+      Multiply_MM  (A,  B,  C1);
+      Multiply_MtM (At, B,  C2);
+      Multiply_MMt (A,  Bt, C3);
+      Multiply_MtMt(At, Bt, C4);
+
+      bool flag = true;
+      flag &= CHECK( C1.nRows() == m && C1.nCols() == n );
+      flag &= CHECK( isClose(C1, C2, TOLERANCE) );
+      flag &= CHECK( isClose(C1, C3, TOLERANCE) );
+      flag &= CHECK( isClose(C1, C4, TOLERANCE) );
+
+      // The product may overwrite one of its factors.
+      Matrix S = At;
+      Multiply_MM(S, A, S);
+      Matrix T;
+      Multiply_MtM(A, A, T);
+      flag &= CHECK( isClose(S, T, TOLERANCE) );
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_Gemm
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_Gemm()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestGemm() );
+   TALLY( TestGemmEmpty() );
+   TALLY( TestGemmSerial() );
+   TALLY( TestGemmMatrix() );
+
+   return std::make_pair( nsucc, nfail );
+}
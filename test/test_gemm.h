@@ -0,0 +1,21 @@
+//=============================================================================
+// test_gemm.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_GEMM_H
+#define TEST_GEMM_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_Gemm();
+
+//=============================================================================
+#endif  // TEST_GEMM_H
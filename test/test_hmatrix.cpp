@@ -0,0 +1,137 @@
+//=============================================================================
+// test_hmatrix.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "test_hmatrix.h"
+#include "unit_test.h"
+#include "..\src\hmatrix.h"
+#include "..\src\matrix.h"
+#include "..\src\read_obs.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double NUGGET = 2.0;
+   const double SILL   = 25.0;
+   const double RANGE  = 1500.0;
+
+   //--------------------------------------------------------------------------
+   // Scattered observation locations from a linear congruential generator.
+   //--------------------------------------------------------------------------
+   std::vector<ObsRecord> ScatteredObs( int N )
+   {
+      std::vector<ObsRecord> obs;
+      unsigned long seed = 12345;
+      for (int n = 0; n < N; ++n) {
+         seed = (1103515245*seed + 12345) % 2147483648UL;
+         double x = 5000.0 * seed / 2147483648.0;
+         seed = (1103515245*seed + 12345) % 2147483648UL;
+         double y = 5000.0 * seed / 2147483648.0;
+         ObsRecord s = { "", x, y, sin(x/700.0) + cos(y/900.0) };
+         obs.push_back(s);
+      }
+      return obs;
+   }
+
+   //--------------------------------------------------------------------------
+   // The dense covariance matrix, for comparison.
+   //--------------------------------------------------------------------------
+   void DenseCovariance( const std::vector<ObsRecord>& obs, Matrix& C )
+   {
+      const int N = obs.size();
+      C.Resize(N, N);
+      for (int i = 0; i < N; ++i)
+         for (int j = 0; j < N; ++j)
+            C(i,j) = (i == j) ? SILL : (SILL-NUGGET)*exp(-3.0*hypot(obs[i].x-obs[j].x, obs[i].y-obs[j].y)/RANGE);
+   }
+
+   //--------------------------------------------------------------------------
+   // TestHMatrixMultiply
+   //--------------------------------------------------------------------------
+   bool TestHMatrixMultiply()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(700);
+      const int N = obs.size();
+
+      HMatrix H(NUGGET, SILL, RANGE, obs, 1e-10);
+
+      Matrix C;
+      DenseCovariance(obs, C);
+
+      Matrix x(N, 2);
+      for (int n = 0; n < N; ++n) {
+         x(n,0) = 1.0;
+         x(n,1) = obs[n].z;
+      }
+
+      Matrix y, yy, e;
+      H.Multiply(x, y);
+      Multiply_MM(C, x, yy);
+      Subtract_MM(y, yy, e);
+
+      bool flag = true;
+      flag &= CHECK( H.nRows() == N );
+      flag &= CHECK( H.MaxRank() > 0 && H.MaxRank() < N/4 );
+      flag &= CHECK( H.Storage() < static_cast<long>(N)*N );
+      flag &= CHECK( FNorm(e) < 1e-8 * FNorm(yy) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestHMatrixSolve
+   //--------------------------------------------------------------------------
+   bool TestHMatrixSolve()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(700);
+      const int N = obs.size();
+
+      HMatrix H(NUGGET, SILL, RANGE, obs, 1e-10);
+
+      bool flag = true;
+      flag &= CHECK( H.Factor() );
+
+      Matrix b(N, 1);
+      for (int n = 0; n < N; ++n)
+         b(n,0) = obs[n].z;
+
+      Matrix x;
+      H.Solve(b, x);
+
+      Matrix C, Cx, e;
+      DenseCovariance(obs, C);
+      Multiply_MM(C, x, Cx);
+      Subtract_MM(Cx, b, e);
+
+      flag &= CHECK( FNorm(e) < 1e-6 * FNorm(b) );
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_HMatrix
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_HMatrix()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestHMatrixMultiply() );
+   TALLY( TestHMatrixSolve() );
+
+   return std::make_pair( nsucc, nfail );
+}
@@ -0,0 +1,21 @@
+//=============================================================================
+// test_hmatrix.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_HMATRIX_H
+#define TEST_HMATRIX_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_HMatrix();
+
+//=============================================================================
+#endif  // TEST_HMATRIX_H
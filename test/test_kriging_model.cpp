@@ -0,0 +1,189 @@
+//=============================================================================
+// test_kriging_model.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "test_kriging_model.h"
+#include "unit_test.h"
+#include "..\src\engine.h"
+#include "..\src\kriging_model.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double NUGGET = 2.0;
+   const double SILL   = 30.0;
+   const double RANGE  = 400.0;
+
+   //--------------------------------------------------------------------------
+   // A scattered data set on a 1000 x 1000 square.
+   //--------------------------------------------------------------------------
+   std::vector<ObsRecord> ScatteredObs( int n )
+   {
+      std::vector<ObsRecord> obs;
+      for (int k = 0; k < n; ++k) {
+         double x = fmod(k * 618.034, 1000.0);
+         double y = fmod(k * 414.214 + 50.0, 1000.0);
+         ObsRecord s = { "", x, y, 100.0 + 0.01*x - 0.02*y + 3.0*sin(0.1*k) };
+         obs.push_back(s);
+      }
+      return obs;
+   }
+
+   std::vector<TargetRecord> Targets()
+   {
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 5; ++i) {
+         TargetRecord s = { "", 90.0 + 200.0*i, 850.0 - 170.0*i };
+         targets.push_back(s);
+      }
+      return targets;
+   }
+
+   //--------------------------------------------------------------------------
+   // Compare a model's predictions with those of Engine.
+   //--------------------------------------------------------------------------
+   bool Matches( const KrigingModel& model, const std::vector<ObsRecord>& obs )
+   {
+      std::vector<TargetRecord> targets = Targets();
+      std::vector<ResultRecord> expected = Engine(NUGGET, SILL, RANGE, obs, targets);
+
+      bool flag = true;
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         ResultRecord result;
+         model.Predict(targets[m], result);
+         flag &= CHECK( isClose(result.zhat, expected[m].zhat, 1e-9) );
+         flag &= CHECK( isClose(result.kstd, expected[m].kstd, 1e-9) );
+      }
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestKrigingModelFit
+   //--------------------------------------------------------------------------
+   bool TestKrigingModelFit()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(80);
+
+      KrigingModel model(NUGGET, SILL, RANGE);
+      model.Fit(obs);
+
+      return Matches(model, obs);
+   }
+
+   //--------------------------------------------------------------------------
+   // TestKrigingModelUpdate
+   //
+   //    Adding and removing observations one at a time gives the same
+   //    predictions as refitting from scratch.
+   //--------------------------------------------------------------------------
+   bool TestKrigingModelUpdate()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(80);
+
+      KrigingModel model(NUGGET, SILL, RANGE);
+      model.Fit( std::vector<ObsRecord>(obs.begin(), obs.begin()+50) );
+      for (int n = 50; n < 80; ++n)
+         model.AddObservation(obs[n]);
+
+      bool flag = true;
+      flag &= CHECK( model.nObservations() == 80 );
+      flag &= Matches(model, obs);
+
+      const int removed[] = { 79, 0, 37, 12 };
+      for (int k = 0; k < 4; ++k) {
+         model.RemoveObservation(removed[k]);
+         obs.erase(obs.begin() + removed[k]);
+      }
+
+      flag &= CHECK( model.nObservations() == 76 );
+      flag &= CHECK( isClose(model.Observation(12).x, obs[12].x, 1e-12) );
+      flag &= Matches(model, obs);
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestKrigingModelLibrary
+   //
+   //    The library interface: the variogram supplied with the observations,
+   //    and a whole batch of targets predicted at once.
+   //--------------------------------------------------------------------------
+   bool TestKrigingModelLibrary()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(80);
+      std::vector<TargetRecord> targets = Targets();
+
+      KrigingModel model;
+      bool flag = true;
+      flag &= CHECK( !model.IsFitted() );
+
+      ParamsRecord variogram = { NUGGET, SILL, RANGE };
+      model.Fit(obs, variogram);
+      flag &= CHECK( model.IsFitted() );
+      flag &= CHECK( isClose(model.Variogram().range, RANGE, 1e-12) );
+
+      std::vector<ResultRecord> results = model.Predict(targets);
+      std::vector<ResultRecord> expected = Engine(NUGGET, SILL, RANGE, obs, targets);
+
+      flag &= CHECK( results.size() == targets.size() );
+      for (unsigned m = 0; m < targets.size(); ++m) {
+         flag &= CHECK( isClose(results[m].x, targets[m].x, 1e-12) );
+         flag &= CHECK( isClose(results[m].zhat, expected[m].zhat, 1e-9) );
+         flag &= CHECK( isClose(results[m].kstd, expected[m].kstd, 1e-9) );
+      }
+
+      // A failed Fit leaves the model unfitted.
+      std::vector<ObsRecord> same( 20, obs[0] );
+      ParamsRecord singular = { 0.0, SILL, RANGE };
+      try {
+         model.Fit(same, singular);
+         flag &= CHECK( false );
+      }
+      catch (CholeskyDecompositionFailed&) {
+      }
+      flag &= CHECK( !model.IsFitted() );
+
+      // So does a fitted model refitted with too few observations, and it
+      // keeps its previous variogram.
+      model.Fit(obs, variogram);
+      ParamsRecord other = { 2.0*NUGGET, 2.0*SILL, 2.0*RANGE };
+      try {
+         model.Fit( std::vector<ObsRecord>(obs.begin(), obs.begin()+5), other );
+         flag &= CHECK( false );
+      }
+      catch (TooFewObservations&) {
+      }
+      flag &= CHECK( !model.IsFitted() );
+      flag &= CHECK( isClose(model.Variogram().range, RANGE, 1e-12) );
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_KrigingModel
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_KrigingModel()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestKrigingModelFit() );
+   TALLY( TestKrigingModelUpdate() );
+   TALLY( TestKrigingModelLibrary() );
+
+   return std::make_pair( nsucc, nfail );
+}
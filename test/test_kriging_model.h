@@ -0,0 +1,21 @@
+//=============================================================================
+// test_kriging_model.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_KRIGING_MODEL_H
+#define TEST_KRIGING_MODEL_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_KrigingModel();
+
+//=============================================================================
+#endif  // TEST_KRIGING_MODEL_H
@@ -0,0 +1,148 @@
+//=============================================================================
+// test_likelihood.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "test_likelihood.h"
+#include "unit_test.h"
+#include "..\src\likelihood.h"
+#include "..\src\matrix.h"
+#include "..\src\numerical_constants.h"
+#include "..\src\read_obs.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double TOLERANCE = 1e-9;
+
+   //--------------------------------------------------------------------------
+   // A small, smooth, irregularly spaced data set.
+   //--------------------------------------------------------------------------
+   std::vector<ObsRecord> SyntheticObs()
+   {
+      std::vector<ObsRecord> obs;
+      for (int i = 0; i < 5; ++i) {
+         for (int j = 0; j < 5; ++j) {
+            double x = 200.0*i + 37.0*((3*i + 7*j) % 5);
+            double y = 200.0*j + 53.0*((7*i + 3*j) % 5);
+            double z = 10.0 + 4.0*sin(x/300.0) + 3.0*cos(y/250.0) + 0.5*((i*j) % 3);
+            ObsRecord s = { "", x, y, z };
+            obs.push_back(s);
+         }
+      }
+      return obs;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestLikelihoodValue
+   //
+   //    With two observations the likelihoods have a closed form.
+   //--------------------------------------------------------------------------
+   bool TestLikelihoodValue()
+   {
+      std::vector<ObsRecord> obs;
+      ObsRecord a = { "", 0.0, 0.0, 3.0 };
+      ObsRecord b = { "", 30.0, 40.0, 7.0 };
+      obs.push_back(a);
+      obs.push_back(b);
+
+      const double nugget = 2.0;
+      const double sill   = 10.0;
+      const double range  = 150.0;
+
+      double s = sill;
+      double c = (sill - nugget) * exp(-3.0*50.0/range);
+      double zPz = (a.z - b.z)*(a.z - b.z) / (2.0*(s - c));
+
+      double ml   = 0.5*(log(s*s - c*c) + zPz) + log(TWO_PI);
+      double reml = 0.5*(log(s*s - c*c) + log(2.0/(s + c)) + zPz) + 0.5*log(TWO_PI);
+
+      bool flag = true;
+      double f;
+
+      flag &= CHECK( NegativeLogLikelihood(obs, nugget, sill, range, false, f) );
+      flag &= CHECK( isClose(f, ml, TOLERANCE) );
+
+      flag &= CHECK( NegativeLogLikelihood(obs, nugget, sill, range, true, f) );
+      flag &= CHECK( isClose(f, reml, TOLERANCE) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestLikelihoodGradient
+   //
+   //    The analytic gradient, with respect to log(nugget), log(sill-nugget),
+   //    and log(range), is checked against central differences.
+   //--------------------------------------------------------------------------
+   bool TestLikelihoodGradient()
+   {
+      std::vector<ObsRecord> obs = SyntheticObs();
+
+      const double t[3] = { log(0.5), log(8.0), log(400.0) };
+      const double delta = 1e-5;
+
+      bool flag = true;
+
+      for (int reml = 0; reml < 2; ++reml) {
+         double f;
+         Matrix grad;
+         flag &= CHECK( NegativeLogLikelihood(obs, exp(t[0]), exp(t[0])+exp(t[1]), exp(t[2]), reml, f, grad) );
+
+         for (int k = 0; k < 3; ++k) {
+            double tp[3] = { t[0], t[1], t[2] };
+            double tm[3] = { t[0], t[1], t[2] };
+            tp[k] += delta;
+            tm[k] -= delta;
+
+            double fp, fm;
+            NegativeLogLikelihood(obs, exp(tp[0]), exp(tp[0])+exp(tp[1]), exp(tp[2]), reml, fp);
+            NegativeLogLikelihood(obs, exp(tm[0]), exp(tm[0])+exp(tm[1]), exp(tm[2]), reml, fm);
+
+            flag &= CHECK( isClose(grad(k,0), (fp - fm)/(2.0*delta), 1e-6) );
+         }
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestLikelihoodFailure
+   //--------------------------------------------------------------------------
+   bool TestLikelihoodFailure()
+   {
+      std::vector<ObsRecord> obs = SyntheticObs();
+      obs.push_back( obs[0] );
+
+      // A duplicated location with no nugget is singular.
+      double f;
+      return CHECK( !NegativeLogLikelihood(obs, 1e-300, 10.0, 400.0, true, f) );
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_Likelihood
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_Likelihood()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestLikelihoodValue() );
+   TALLY( TestLikelihoodGradient() );
+   TALLY( TestLikelihoodFailure() );
+
+   return std::make_pair( nsucc, nfail );
+}
@@ -0,0 +1,21 @@
+//=============================================================================
+// test_likelihood.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_LIKELIHOOD_H
+#define TEST_LIKELIHOOD_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_Likelihood();
+
+//=============================================================================
+#endif  // TEST_LIKELIHOOD_H
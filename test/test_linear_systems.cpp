@@ -7,8 +7,9 @@
 //    University of Minnesota
 //
 // version:
-//    2 July 2017
+//    18 October 2026
 //=============================================================================
+#include <cmath>
 #include <utility>
 
 #include "test_linear_systems.h"
@@ -71,6 +72,45 @@ namespace{
       return CHECK( isClose(Ainv, C, TOLERANCE) );
    }
 
+   //--------------------------------------------------------------------------
+   // TestLargeCholesky
+   //
+   //    A matrix large enough to use the blocked, parallel code.
+   //--------------------------------------------------------------------------
+   bool TestLargeCholesky()
+   {
+      const int N = 1100;
+
+      Matrix A(N, N);
+      for (int i = 0; i < N; ++i) {
+         for (int j = 0; j <= i; ++j) {
+            double h = fabs( static_cast<double>((37*i) % N) - static_cast<double>((37*j) % N) );
+            A(i,j) = exp(-3.0*h/200.0);
+            A(j,i) = A(i,j);
+         }
+         A(i,i) = 1.5;
+      }
+
+      bool flag = true;
+
+      Matrix L;
+      flag &= CHECK( CholeskyDecomposition(A, L) );
+
+      Matrix LLt;
+      Multiply_MMt(L, L, LLt);
+      flag &= CHECK( isClose(LLt, A, TOLERANCE) );
+
+      Matrix Ainv;
+      CholeskyInverse(L, Ainv);
+
+      Matrix I, AAinv;
+      Identity(I, N);
+      Multiply_MM(A, Ainv, AAinv);
+      flag &= CHECK( isClose(AAinv, I, TOLERANCE) );
+
+      return flag;
+   }
+
    //--------------------------------------------------------------------------
    // TestRSPDInv
    //--------------------------------------------------------------------------
@@ -99,6 +139,45 @@ namespace{
       return CHECK( isClose(X, C, TOLERANCE) );
    }
 
+   //--------------------------------------------------------------------------
+   // TestSymmetricEigen
+   //--------------------------------------------------------------------------
+   bool TestSymmetricEigen()
+   {
+      Matrix A("4,6,4,4; 6,10,9,7; 4,9,17,11; 4,7,11,18");
+      Matrix d, Q;
+
+      bool flag = true;
+      flag &= CHECK( SymmetricEigen(A, d, Q) );
+
+      // The eigenvalues are in ascending order.
+      for (int i = 0; i < d.nRows()-1; ++i)
+         flag &= CHECK( d(i,0) <= d(i+1,0) );
+
+      // Q is orthogonal.
+      Matrix QtQ, I;
+      Multiply_MtM(Q, Q, QtQ);
+      Identity(I, 4);
+      flag &= CHECK( isClose(QtQ, I, TOLERANCE) );
+
+      // A = Q diag(d) Q'.
+      Matrix QD(Q);
+      for (int i = 0; i < 4; ++i)
+         for (int j = 0; j < 4; ++j)
+            QD(i,j) *= d(j,0);
+
+      Matrix B;
+      Multiply_MMt(QD, Q, B);
+      flag &= CHECK( isClose(A, B, TOLERANCE) );
+
+      // A simple case with known eigenvalues.
+      Matrix C("2,1,0; 1,2,0; 0,0,5");
+      SymmetricEigen(C, d, Q);
+      flag &= CHECK( isClose(d, Matrix("1;3;5"), TOLERANCE) );
+
+      return flag;
+   }
+
    //--------------------------------------------------------------------------
    // TestAffineTransformation
    //--------------------------------------------------------------------------
@@ -127,8 +206,10 @@ std::pair<int,int> test_LinearSystems()
    TALLY( TestCholeskyDecomposition() );
    TALLY( TestCholeskySolve() );
    TALLY( TestCholeskyInverse() );
+   TALLY( TestLargeCholesky() );
    TALLY( TestRSPDInv() );
    TALLY( TestLeastSquaresSolve() );
+   TALLY( TestSymmetricEigen() );
    TALLY( TestAffineTransformation() );
 
    return std::make_pair( nsucc, nfail );
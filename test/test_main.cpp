@@ -7,14 +7,27 @@
 //    University of Minnesota
 //
 // version:
-//    29 June 2017
+//    18 October 2026
 //=============================================================================
 #include <iostream>
 
+#include "test_covariance_operator.h"
 #include "test_engine.h"
+#include "test_fixed_matrix.h"
+#include "test_gemm.h"
+#include "test_hmatrix.h"
+#include "test_kriging_model.h"
+#include "test_likelihood.h"
 #include "test_linear_systems.h"
 #include "test_matrix.h"
+#include "test_mixed_cholesky.h"
+#include "test_mizhodan_c.h"
+#include "test_packed_matrix.h"
+#include "test_server.h"
+#include "test_sparse_matrix.h"
+#include "test_spatial_order.h"
 #include "test_special_functions.h"
+#include "test_weight_operator.h"
 
 //-----------------------------------------------------------------------------
 //
@@ -26,10 +39,34 @@ int main()
 
    std::pair<int,int> counts;
 
+   counts = test_CovarianceOperator();
+   nsucc += counts.first;
+   nfail += counts.second;
+
    counts = test_Engine();
    nsucc += counts.first;
    nfail += counts.second;
 
+   counts = test_FixedMatrix();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_Gemm();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_HMatrix();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_KrigingModel();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_Likelihood();
+   nsucc += counts.first;
+   nfail += counts.second;
+
    counts = test_LinearSystems();
    nsucc += counts.first;
    nfail += counts.second;
@@ -38,10 +75,38 @@ int main()
    nsucc += counts.first;
    nfail += counts.second;
 
+   counts = test_MixedCholesky();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_MizhodanC();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_PackedMatrix();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_Server();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_SparseMatrix();
+   nsucc += counts.first;
+   nfail += counts.second;
+
+   counts = test_SpatialOrder();
+   nsucc += counts.first;
+   nfail += counts.second;
+
    counts = test_SpecialFunctions();
    nsucc += counts.first;
    nfail += counts.second;
 
+   counts = test_WeightOperator();
+   nsucc += counts.first;
+   nfail += counts.second;
+
    if (nfail > 0)
       std::cerr << "MIZHODAN TESTS: nsucc = " << nsucc << '\t' << "nfail = " << nfail << std::endl;
    else
@@ -15,8 +15,9 @@
 //    University of Minnesota
 //
 // version:
-//    2 July 2017
+//    18 October 2026
 //=============================================================================
+#include <cstdint>
 #include <iomanip>
 #include <utility>
 
@@ -139,6 +140,75 @@ namespace{
       return CHECK( isClose(A, B, TOLERANCE) );
    }
 
+   //--------------------------------------------------------------------------
+   // TestMatrixMoveConstructor
+   //--------------------------------------------------------------------------
+   bool TestMatrixMoveConstructor()
+   {
+      Matrix A("1,2,3;4,5,6");
+      const double* data = A.Base();
+
+      long before = Matrix::Allocations();
+      Matrix B( std::move(A) );
+
+      bool flag = true;
+      flag &= CHECK( Matrix::Allocations() == before );
+      flag &= CHECK( B.Base() == data );
+      flag &= CHECK( A.nRows() == 0 && A.nCols() == 0 && A.Base() == nullptr );
+      flag &= CHECK( isClose(B, Matrix("1,2,3;4,5,6"), TOLERANCE) );
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestMatrixMoveAssignment
+   //--------------------------------------------------------------------------
+   bool TestMatrixMoveAssignment()
+   {
+      Matrix A("1,2,3;4,5,6");
+      Matrix B("0,1,1,0");
+      const double* data = A.Base();
+
+      long before = Matrix::Allocations();
+      B = std::move(A);
+
+      bool flag = true;
+      flag &= CHECK( Matrix::Allocations() == before );
+      flag &= CHECK( B.Base() == data );
+      flag &= CHECK( isClose(B, Matrix("1,2,3;4,5,6"), TOLERANCE) );
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestMatrixStorage
+   //
+   //    The storage is 64 byte aligned, and freed storage is reused.
+   //--------------------------------------------------------------------------
+   bool TestMatrixStorage()
+   {
+      bool flag = true;
+
+      const double* freed;
+      {
+         Matrix A(7, 3);
+         flag &= CHECK( reinterpret_cast<std::uintptr_t>(A.Base()) % 64 == 0 );
+         freed = A.Base();
+      }
+
+      Matrix B;
+      B.ResizeUninitialized(3, 6);
+      flag &= CHECK( B.nRows() == 3 && B.nCols() == 6 );
+      flag &= CHECK( B.Base() == freed );
+
+      B.Resize(3, 6);
+      flag &= CHECK( B.Base() == freed );
+      flag &= CHECK( isClose(MaxAbs(B), 0.0, TOLERANCE) );
+
+      Matrix C(1000, 1000);
+      flag &= CHECK( reinterpret_cast<std::uintptr_t>(C.Base()) % 64 == 0 );
+
+      return flag;
+   }
+
    //--------------------------------------------------------------------------
    // TestMatrixScalarAssignment
    //--------------------------------------------------------------------------
@@ -464,6 +534,93 @@ namespace{
       return CHECK( isClose(C, AmB, TOLERANCE) );
    }
 
+   //--------------------------------------------------------------------------
+   // TestMatrixAliasedArithmetic
+   //
+   //    The result may be one of the arguments.
+   //--------------------------------------------------------------------------
+   bool TestMatrixAliasedArithmetic()
+   {
+      Matrix A("1,2,3;4,5,6");
+      Matrix B("1,0,1;0,0,1");
+
+      bool flag = true;
+
+      Multiply_aM(2, A, A);
+      flag &= CHECK( isClose(A, Matrix("2,4,6;8,10,12"), TOLERANCE) );
+
+      Subtract_MM(A, B, A);
+      flag &= CHECK( isClose(A, Matrix("1,4,5;8,10,11"), TOLERANCE) );
+
+      Add_MM(A, B, B);
+      flag &= CHECK( isClose(B, Matrix("2,4,6;8,10,12"), TOLERANCE) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestMatrixExpression
+   //--------------------------------------------------------------------------
+   bool TestMatrixExpression()
+   {
+      Matrix u("1,2,3;4,5,6");
+      Matrix v("1,0,1;0,0,1");
+      Matrix z("2,2,2;2,2,2");
+
+      bool flag = true;
+
+      Matrix w = u - 2*v;
+      flag &= CHECK( isClose(w, Matrix("-1,2,1;4,5,4"), TOLERANCE) );
+
+      w = -(u + v*3) + 0.5*(z - u);
+      flag &= CHECK( isClose(w, Matrix("-3.5,-2,-6.5;-5,-6.5,-11"), TOLERANCE) );
+
+      u = u - v;
+      flag &= CHECK( isClose(u, Matrix("0,2,2;4,5,5"), TOLERANCE) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestMatrixAllocationCount
+   //
+   //    The expression templates allocate only the result, and nothing at
+   //    all when the result already has the right dimensions, where the
+   //    routine-by-routine computation needs a temporary for each step.
+   //--------------------------------------------------------------------------
+   bool TestMatrixAllocationCount()
+   {
+      Matrix u("1,2,3;4,5,6");
+      Matrix v("1,0,1;0,0,1");
+      const double lambda = 0.5;
+
+      bool flag = true;
+
+      long before = Matrix::Allocations();
+      Matrix lv, w1;
+      Multiply_aM(lambda, v, lv);
+      Subtract_MM(u, lv, w1);
+      flag &= CHECK( Matrix::Allocations() - before == 2 );
+
+      before = Matrix::Allocations();
+      Matrix w2 = u - lambda*v;
+      flag &= CHECK( Matrix::Allocations() - before == 1 );
+
+      before = Matrix::Allocations();
+      w2 = u - lambda*v + w2;
+      flag &= CHECK( Matrix::Allocations() - before == 0 );
+
+      before = Matrix::Allocations();
+      Matrix C;
+      Multiply_MM(u, Matrix("1;1;1"), C);
+      flag &= CHECK( Matrix::Allocations() - before == 2 );   // the argument and the product
+
+      flag &= CHECK( isClose(w1, Matrix("0.5,2,2.5;4,5,5.5"), TOLERANCE) );
+      flag &= CHECK( isClose(w2, Matrix("1,4,5;8,10,11"), TOLERANCE) );
+      flag &= CHECK( isClose(C, Matrix("6;15"), TOLERANCE) );
+      return flag;
+   }
+
    //--------------------------------------------------------------------------
    // TestMatrixMultiply_MM
    //--------------------------------------------------------------------------
@@ -686,6 +843,9 @@ std::pair<int,int> test_Matrix()
    TALLY( TestMatrixConstructorWithStringFill() );
    TALLY( TestMatrixDestructiveResize() );
    TALLY( TestMatrixAssignmentOperator() );
+   TALLY( TestMatrixMoveConstructor() );
+   TALLY( TestMatrixMoveAssignment() );
+   TALLY( TestMatrixStorage() );
    TALLY( TestMatrixScalarAssignment() );
    TALLY( TestMatrixAccess() );
    TALLY( TestMatrixRowAndColumnSize() );
@@ -711,6 +871,9 @@ std::pair<int,int> test_Matrix()
    TALLY( TestMatrixMultiply_aM() );
    TALLY( TestMatrixAdd_MM() );
    TALLY( TestMatrixSubtract_MM() );
+   TALLY( TestMatrixAliasedArithmetic() );
+   TALLY( TestMatrixExpression() );
+   TALLY( TestMatrixAllocationCount() );
    TALLY( TestMatrixMultiply_MM() );
    TALLY( TestMatrixMultiply_MtM() );
    TALLY( TestMatrixMultiply_MMt() );
@@ -0,0 +1,82 @@
+//=============================================================================
+// test_mixed_cholesky.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cmath>
+#include <utility>
+
+#include "test_mixed_cholesky.h"
+#include "unit_test.h"
+#include "..\src\matrix.h"
+#include "..\src\mixed_cholesky.h"
+#include "..\src\packed_matrix.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   //--------------------------------------------------------------------------
+   // TestMixedCholesky
+   //
+   //    The single precision solution is accurate to single precision, and
+   //    the refined solution to double precision.
+   //--------------------------------------------------------------------------
+   bool TestMixedCholesky()
+   {
+      PackedMatrix A( Matrix("1,0.5,0.25; 0.5,1,0.5; 0.25,0.5,1") );
+      Matrix b("2.75,1; 4,0; 4.25,0");
+      Matrix z("1,1.3333333333333333; 2,-0.6666666666666667; 3,0");
+
+      bool flag = true;
+
+      MixedCholesky F;
+      flag &= CHECK( F.Factor(A) );
+
+      Matrix x;
+      F.Solve(b, x);
+      flag &= CHECK( isClose(x, z, 1e-3) );
+      flag &= CHECK( !isClose(x, z, 1e-12) );
+
+      int iterations;
+      flag &= CHECK( F.Refine(A, b, x, 1e-15, iterations) );
+      flag &= CHECK( iterations > 0 );
+      flag &= CHECK( isClose(x, z, 1e-12) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestMixedCholeskyFailure
+   //
+   //    A matrix that is positive definite only in double precision.
+   //--------------------------------------------------------------------------
+   bool TestMixedCholeskyFailure()
+   {
+      PackedMatrix A( Matrix("1,1; 1,1.0000000001") );
+
+      MixedCholesky F;
+      return CHECK( !F.Factor(A) );
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_MixedCholesky
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_MixedCholesky()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestMixedCholesky() );
+   TALLY( TestMixedCholeskyFailure() );
+
+   return std::make_pair( nsucc, nfail );
+}
@@ -0,0 +1,21 @@
+//=============================================================================
+// test_mixed_cholesky.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_MIXED_CHOLESKY_H
+#define TEST_MIXED_CHOLESKY_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_MixedCholesky();
+
+//=============================================================================
+#endif  // TEST_MIXED_CHOLESKY_H
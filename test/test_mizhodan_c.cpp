@@ -0,0 +1,112 @@
+//=============================================================================
+// test_mizhodan_c.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "test_mizhodan_c.h"
+#include "unit_test.h"
+#include "..\src\kriging_model.h"
+#include "..\src\mizhodan_c.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const int N = 60;
+
+   //--------------------------------------------------------------------------
+   // TestMizhodanFitPredict
+   //
+   //    The C interface gives the same predictions as the KrigingModel.
+   //--------------------------------------------------------------------------
+   bool TestMizhodanFitPredict()
+   {
+      std::vector<double> x(N), y(N), z(N);
+      std::vector<ObsRecord> obs(N);
+      for (int k = 0; k < N; ++k) {
+         x[k] = fmod(k*618.034, 1000.0);
+         y[k] = fmod(k*414.214, 1000.0);
+         z[k] = 10.0 + sin(0.3*k);
+
+         ObsRecord s = { "", x[k], y[k], z[k] };
+         obs[k] = s;
+      }
+
+      KrigingModel expected(1.0, 5.0, 300.0);
+      expected.Fit(obs);
+
+      bool flag = true;
+
+      mizhodan_model* model = mizhodan_create();
+      flag &= CHECK( model != nullptr );
+      flag &= CHECK( mizhodan_fit(model, 1.0, 5.0, 300.0, x.data(), y.data(), z.data(), N) == MIZHODAN_OK );
+      flag &= CHECK( mizhodan_observations(model) == N );
+
+      const double tx[] = { 100.0, 505.5, 990.0 };
+      const double ty[] = { 200.0, 10.0, 990.0 };
+      double zhat[3], kstd[3];
+      flag &= CHECK( mizhodan_predict(model, tx, ty, 3, zhat, kstd) == MIZHODAN_OK );
+
+      for (int m = 0; m < 3; ++m) {
+         double ez, ek;
+         expected.Predict(tx[m], ty[m], ez, ek);
+         flag &= CHECK( isClose(zhat[m], ez, 1e-12) );
+         flag &= CHECK( isClose(kstd[m], ek, 1e-12) );
+      }
+
+      mizhodan_destroy(model);
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestMizhodanErrors
+   //
+   //    Failures are reported by status codes and messages, not exceptions.
+   //--------------------------------------------------------------------------
+   bool TestMizhodanErrors()
+   {
+      std::vector<double> x(N, 1.0), y(N, 2.0), z(N, 3.0);
+      double zhat, kstd;
+
+      bool flag = true;
+
+      mizhodan_model* model = mizhodan_create();
+      flag &= CHECK( mizhodan_predict(model, x.data(), y.data(), 1, &zhat, &kstd) == MIZHODAN_NOT_FITTED );
+      flag &= CHECK( strlen(mizhodan_last_error()) > 0 );
+
+      flag &= CHECK( mizhodan_fit(model, 1.0, 5.0, 300.0, nullptr, y.data(), z.data(), N) == MIZHODAN_INVALID_ARGUMENT );
+      flag &= CHECK( mizhodan_fit(model, 5.0, 1.0, 300.0, x.data(), y.data(), z.data(), N) == MIZHODAN_INVALID_ARGUMENT );
+      flag &= CHECK( mizhodan_fit(model, 1.0, 5.0, 300.0, x.data(), y.data(), z.data(), 3) == MIZHODAN_TOO_FEW );
+      flag &= CHECK( mizhodan_fit(model, 0.0, 5.0, 300.0, x.data(), y.data(), z.data(), N) == MIZHODAN_SINGULAR );
+      flag &= CHECK( mizhodan_observations(model) == 0 );
+
+      mizhodan_destroy(model);
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_MizhodanC
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_MizhodanC()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestMizhodanFitPredict() );
+   TALLY( TestMizhodanErrors() );
+
+   return std::make_pair( nsucc, nfail );
+}
@@ -0,0 +1,21 @@
+//=============================================================================
+// test_mizhodan_c.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_MIZHODAN_C_H
+#define TEST_MIZHODAN_C_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_MizhodanC();
+
+//=============================================================================
+#endif  // TEST_MIZHODAN_C_H
@@ -0,0 +1,100 @@
+//=============================================================================
+// test_packed_matrix.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cmath>
+#include <utility>
+
+#include "test_packed_matrix.h"
+#include "unit_test.h"
+#include "..\src\linear_systems.h"
+#include "..\src\matrix.h"
+#include "..\src\packed_matrix.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double TOLERANCE = 1e-9;
+
+   //--------------------------------------------------------------------------
+   // TestPackedMatrix
+   //--------------------------------------------------------------------------
+   bool TestPackedMatrix()
+   {
+      Matrix A("4,6,4,4; 6,10,9,7; 4,9,17,11; 4,7,11,18");
+      PackedMatrix P(A);
+
+      bool flag = true;
+      flag &= CHECK( P.nRows() == 4 );
+      flag &= CHECK( P.Size() == 10 );
+      flag &= CHECK( isClose(P(2,1), 9, TOLERANCE) && isClose(P(3,3), 18, TOLERANCE) );
+      flag &= CHECK( isClose(P.Base(2)[0], 4, TOLERANCE) && isClose(P.Base(3)[2], 11, TOLERANCE) );
+
+      Matrix B;
+      Unpack(P, B);
+      flag &= CHECK( isClose(A, B, TOLERANCE) );
+
+      Matrix X("1,2; 2,-1; 3,0; 4,1"), Y, Z;
+      Multiply_MM(A, X, Y);
+      Multiply_SM(P, X, Z);
+      flag &= CHECK( isClose(Y, Z, TOLERANCE) );
+
+      flag &= CHECK( isClose(Trace(P), 49, TOLERANCE) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestPackedCholesky
+   //
+   //    The decomposition and the inverse, both computed in place.
+   //--------------------------------------------------------------------------
+   bool TestPackedCholesky()
+   {
+      PackedMatrix P( Matrix("4,6,4,4; 6,10,9,7; 4,9,17,11; 4,7,11,18") );
+
+      bool flag = true;
+      flag &= CHECK( CholeskyDecomposition(P, P) );
+
+      Matrix L, B("2,0,0,0; 3,1,0,0; 2,3,2,0; 2,1,2,3");
+      UnpackLower(P, L);
+      flag &= CHECK( isClose(L, B, TOLERANCE) );
+
+      Matrix b("44,4; 81,2; 117,1; 123,0"), x;
+      Matrix z("1,17.875; 2,-12.75; 3,3.25; 4,-1");
+      CholeskySolve(P, b, x);
+      flag &= CHECK( isClose(x, z, TOLERANCE) );
+
+      CholeskyInverse(P, P);
+
+      Matrix Ainv, C;
+      Unpack(P, Ainv);
+      Multiply_aM(1.0/144.0, Matrix("945,-690,174,-48; -690,532,-140,32; 174,-140,52,-16; -48,32,-16,16"), C);
+      flag &= CHECK( isClose(Ainv, C, TOLERANCE) );
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_PackedMatrix
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_PackedMatrix()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestPackedMatrix() );
+   TALLY( TestPackedCholesky() );
+
+   return std::make_pair( nsucc, nfail );
+}
@@ -0,0 +1,21 @@
+//=============================================================================
+// test_packed_matrix.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_PACKED_MATRIX_H
+#define TEST_PACKED_MATRIX_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_PackedMatrix();
+
+//=============================================================================
+#endif  // TEST_PACKED_MATRIX_H
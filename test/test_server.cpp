@@ -0,0 +1,132 @@
+//=============================================================================
+// test_server.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_server.h"
+#include "unit_test.h"
+#include "..\src\kriging_model.h"
+#include "..\src\server.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   //--------------------------------------------------------------------------
+   // TestLatencyCounter
+   //--------------------------------------------------------------------------
+   bool TestLatencyCounter()
+   {
+      LatencyCounter latency;
+
+      bool flag = true;
+      flag &= CHECK( latency.Count() == 0 );
+      flag &= CHECK( isClose(latency.Percentile(50), 0.0, 1e-12) );
+
+      for (int k = 100; k >= 1; --k)
+         latency.Record(k);
+
+      flag &= CHECK( latency.Count() == 100 );
+      flag &= CHECK( isClose(latency.Percentile(50), 50.0, 1e-12) );
+      flag &= CHECK( isClose(latency.Percentile(99), 99.0, 1e-12) );
+      flag &= CHECK( isClose(latency.Percentile(100), 100.0, 1e-12) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestServe
+   //
+   //    The replies come back in the order of the queries, and match the
+   //    model's own predictions.
+   //--------------------------------------------------------------------------
+   bool TestServe()
+   {
+      std::vector<ObsRecord> obs;
+      for (int k = 0; k < 40; ++k) {
+         ObsRecord s = { "", fmod(k*618.034, 1000.0), fmod(k*414.214, 1000.0), 10.0 + sin(0.3*k) };
+         obs.push_back(s);
+      }
+
+      KrigingModel model(1.0, 5.0, 300.0);
+      model.Fit(obs);
+
+      std::istringstream in(
+         "# a comment line\n"
+         "A, 100, 200\n"
+         "\n"
+         "B,350.5,  400 \n"
+         "C, 1, two\n"
+         "stats\n"
+         "quit\n"
+         "D, 1, 1\n" );
+      std::ostringstream out;
+
+      LatencyCounter latency;
+      Serve(model, in, out, latency);
+
+      std::istringstream replies( out.str() );
+      std::string line;
+      std::vector<std::string> lines;
+      while (std::getline(replies, line))
+         lines.push_back(line);
+
+      bool flag = true;
+      flag &= CHECK( lines.size() == 4 );
+      flag &= CHECK( latency.Count() == 2 );
+      if (lines.size() != 4) return false;
+
+      const char* ids[] = { "A", "B" };
+      const double xs[] = { 100.0, 350.5 };
+      const double ys[] = { 200.0, 400.0 };
+      for (int k = 0; k < 2; ++k) {
+         TargetRecord target = { ids[k], xs[k], ys[k] };
+         ResultRecord expected;
+         model.Predict(target, expected);
+
+         std::istringstream fields( lines[k] );
+         std::string id;
+         char comma;
+         double x, y, zhat, kstd;
+         std::getline(fields, id, ',');
+         fields >> x >> comma >> y >> comma >> zhat >> comma >> kstd;
+
+         flag &= CHECK( id == ids[k] );
+         flag &= CHECK( isClose(x, xs[k], 1e-12) && isClose(y, ys[k], 1e-12) );
+         flag &= CHECK( isClose(zhat, expected.zhat, 1e-14) );
+         flag &= CHECK( isClose(kstd, expected.kstd, 1e-14) );
+      }
+
+      flag &= CHECK( lines[2].compare(0, 7, "# ERROR") == 0 );
+      flag &= CHECK( lines[3].compare(0, 17, "# queries 2, p50 ") == 0 );
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_Server
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_Server()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestLatencyCounter() );
+   TALLY( TestServe() );
+
+   return std::make_pair( nsucc, nfail );
+}
@@ -0,0 +1,156 @@
+//=============================================================================
+// test_sparse_matrix.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "test_sparse_matrix.h"
+#include "unit_test.h"
+#include "..\src\matrix.h"
+#include "..\src\read_obs.h"
+#include "..\src\sparse_matrix.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double SILL  = 10.0;
+   const double TAPER = 600.0;
+
+   //--------------------------------------------------------------------------
+   // Scattered observation locations from a linear congruential generator.
+   //--------------------------------------------------------------------------
+   std::vector<ObsRecord> ScatteredObs( int N )
+   {
+      std::vector<ObsRecord> obs;
+      unsigned long seed = 2468;
+      for (int n = 0; n < N; ++n) {
+         seed = (1103515245*seed + 12345) % 2147483648UL;
+         double x = 5000.0 * seed / 2147483648.0;
+         seed = (1103515245*seed + 12345) % 2147483648UL;
+         double y = 5000.0 * seed / 2147483648.0;
+         ObsRecord s = { "", x, y, sin(x/700.0) + cos(y/900.0) };
+         obs.push_back(s);
+      }
+      return obs;
+   }
+
+   //--------------------------------------------------------------------------
+   // Assemble a compactly supported covariance matrix in the given order.
+   //--------------------------------------------------------------------------
+   void Assemble( const std::vector<ObsRecord>& obs, const std::vector<int>& perm, SparseMatrix& A )
+   {
+      const int N = obs.size();
+      for (int i = 0; i < N; ++i) {
+         for (int j = 0; j <= i; ++j) {
+            double h = hypot(obs[perm[i]].x - obs[perm[j]].x, obs[perm[i]].y - obs[perm[j]].y);
+            double r = h/TAPER;
+            if (i == j)
+               A.Append(j, SILL);
+            else if (r < 1.0)
+               A.Append(j, 8.0*pow(1.0-r, 4)*(4.0*r + 1.0));
+         }
+         A.EndRow();
+      }
+   }
+
+   //--------------------------------------------------------------------------
+   // TestSparseCholesky
+   //--------------------------------------------------------------------------
+   bool TestSparseCholesky()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(500);
+      const int N = obs.size();
+
+      std::vector<int> perm;
+      NestedDissection(obs, TAPER, perm);
+
+      SparseMatrix A;
+      Assemble(obs, perm, A);
+
+      bool flag = true;
+
+      SparseCholesky L;
+      flag &= CHECK( L.Factor(A) );
+      flag &= CHECK( L.nRows() == N );
+      flag &= CHECK( L.nNonZeros() >= A.nNonZeros() );
+
+      Matrix b(N, 2);
+      for (int n = 0; n < N; ++n) {
+         b(n,0) = 1.0;
+         b(n,1) = obs[perm[n]].z;
+      }
+
+      Matrix x, Ax, e;
+      L.Solve(b, x);
+      A.Multiply(x, Ax);
+      Subtract_MM(Ax, b, e);
+
+      flag &= CHECK( FNorm(e) < 1e-10 * FNorm(b) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestNestedDissection
+   //
+   //    The order is a permutation, and it has less fill than the original
+   //    (random) order.
+   //--------------------------------------------------------------------------
+   bool TestNestedDissection()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(500);
+      const int N = obs.size();
+
+      std::vector<int> perm;
+      NestedDissection(obs, TAPER, perm);
+
+      bool flag = true;
+
+      std::vector<int> sorted(perm);
+      std::sort(sorted.begin(), sorted.end());
+      for (int n = 0; n < N; ++n)
+         flag &= CHECK( sorted[n] == n );
+
+      std::vector<int> identity(N);
+      for (int n = 0; n < N; ++n)
+         identity[n] = n;
+
+      SparseMatrix A, B;
+      Assemble(obs, perm, A);
+      Assemble(obs, identity, B);
+
+      SparseCholesky LA, LB;
+      LA.Factor(A);
+      LB.Factor(B);
+
+      flag &= CHECK( LA.nNonZeros() < LB.nNonZeros() );
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_SparseMatrix
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_SparseMatrix()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestSparseCholesky() );
+   TALLY( TestNestedDissection() );
+
+   return std::make_pair( nsucc, nfail );
+}
@@ -0,0 +1,21 @@
+//=============================================================================
+// test_sparse_matrix.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_SPARSE_MATRIX_H
+#define TEST_SPARSE_MATRIX_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_SparseMatrix();
+
+//=============================================================================
+#endif  // TEST_SPARSE_MATRIX_H
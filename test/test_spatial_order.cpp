@@ -0,0 +1,99 @@
+//=============================================================================
+// test_spatial_order.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "test_spatial_order.h"
+#include "unit_test.h"
+#include "..\src\spatial_order.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   //--------------------------------------------------------------------------
+   // TestHilbertIndex
+   //
+   //    The first level of the curve visits the quadrants in the order
+   //    lower left, upper left, upper right, lower right.
+   //--------------------------------------------------------------------------
+   bool TestHilbertIndex()
+   {
+      const unsigned H = 1u << 15;
+      const unsigned long long Q = 1ULL << 30;
+
+      bool flag = true;
+      flag &= CHECK( HilbertIndex(0, 0) == 0 );
+      flag &= CHECK( HilbertIndex(0, H) / Q == 1 );
+      flag &= CHECK( HilbertIndex(H, H) / Q == 2 );
+      flag &= CHECK( HilbertIndex(H, 0) / Q == 3 );
+      flag &= CHECK( HilbertIndex(2*H-1, 0) == 4*Q-1 );
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestHilbertOrder
+   //
+   //    On a regular 8 x 8 grid, listed row by row, the order is a
+   //    permutation in which every step is to an adjacent grid point.
+   //--------------------------------------------------------------------------
+   bool TestHilbertOrder()
+   {
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 8; ++i) {
+         for (int j = 0; j < 8; ++j) {
+            TargetRecord s = { "", 10.0 + 5.0*j, -3.0 + 5.0*i };
+            targets.push_back(s);
+         }
+      }
+
+      std::vector<int> perm;
+      HilbertOrder(targets, perm);
+
+      bool flag = true;
+      flag &= CHECK( perm.size() == targets.size() );
+
+      std::vector<int> sorted(perm);
+      std::sort(sorted.begin(), sorted.end());
+      for (unsigned k = 0; k < sorted.size(); ++k)
+         flag &= CHECK( sorted[k] == static_cast<int>(k) );
+
+      for (unsigned k = 1; k < perm.size(); ++k) {
+         const TargetRecord& a = targets[perm[k-1]];
+         const TargetRecord& b = targets[perm[k]];
+         flag &= CHECK( isClose(std::fabs(a.x - b.x) + std::fabs(a.y - b.y), 5.0, 1e-9) );
+      }
+
+      std::vector<ObsRecord> one(1);
+      HilbertOrder(one, perm);
+      flag &= CHECK( perm.size() == 1 && perm[0] == 0 );
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_SpatialOrder
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_SpatialOrder()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestHilbertIndex() );
+   TALLY( TestHilbertOrder() );
+
+   return std::make_pair( nsucc, nfail );
+}
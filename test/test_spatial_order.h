@@ -0,0 +1,21 @@
+//=============================================================================
+// test_spatial_order.h
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#ifndef TEST_SPATIAL_ORDER_H
+#define TEST_SPATIAL_ORDER_H
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_SpatialOrder();
+
+//=============================================================================
+#endif  // TEST_SPATIAL_ORDER_H
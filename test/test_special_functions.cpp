@@ -11,6 +11,7 @@
 //=============================================================================
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 #include "test_special_functions.h"
 #include "unit_test.h"
@@ -270,6 +271,84 @@ namespace{
 
       return flag;
    }
+
+   //--------------------------------------------------------------------------
+   // TestGaussianCDFBatch
+   //
+   //    The batch version matches the reference values from erfc to within
+   //    3e-16, and to a relative error of 1e-8 in the lower tail; it agrees
+   //    with the series, which is itself only good to about 1e-15 near
+   //    |x| = 8, to within 2e-15; and it reaches far into the tails.
+   //--------------------------------------------------------------------------
+   bool TestGaussianCDFBatch()
+   {
+      const int N = 1601;
+      std::vector<double> x(N), y(N);
+      for (int i = 0; i < N; ++i)
+         x[i] = -8.0 + 0.01*i;
+
+      GaussianCDF( x.data(), y.data(), N );
+
+      bool flag = true;
+
+      for (int i = 0; i < N; ++i) {
+         const double exact = 0.5*erfc(-x[i]/sqrt(2.0));
+         flag &= isClose( y[i], exact, 3e-16 );
+         if (x[i] < 0.0)
+            flag &= isClose( y[i]/exact, 1.0, 1e-8 );
+         flag &= isClose( y[i], GaussianCDF(x[i]), 2e-15 );
+      }
+
+      // Phi(-10) = 7.619853024160527e-24, Phi(-20) = 2.753624118606233e-89.
+      const double t[] = { -10.0, -20.0, 40.0 };
+      double p[3];
+      GaussianCDF( t, p, 3 );
+      flag &= isClose( p[0]/7.619853024160527e-24, 1.0, 1e-12 );
+      flag &= isClose( p[1]/2.753624118606233e-89, 1.0, 1e-12 );
+      flag &= isClose( p[2], 1.0, 1e-16 );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestGaussianCDFInvBatch
+   //
+   //    The batch version inverts the batch GaussianCDF, from deep in the
+   //    lower tail to deep in the upper tail.
+   //--------------------------------------------------------------------------
+   bool TestGaussianCDFInvBatch()
+   {
+      std::vector<double> p;
+      for (int k = 300; k >= 2; --k)
+         p.push_back( pow(10.0, -k) );
+      for (int i = 11; i < 990; ++i)
+         p.push_back( 0.001*i );
+      for (int k = 2; k <= 15; ++k)
+         p.push_back( 1.0 - pow(10.0, -k) );
+      const int N = p.size();
+
+      std::vector<double> x(N), q(N);
+      GaussianCDFInv( p.data(), x.data(), N );
+      GaussianCDF( x.data(), q.data(), N );
+
+      bool flag = true;
+
+      for (int i = 0; i < N; ++i) {
+         if (p[i] < 0.5)
+            flag &= ( fabs(q[i] - p[i]) < 1e-10*p[i] );
+         else
+            flag &= ( fabs(q[i] - p[i]) < 1e-10*(1.0 - p[i]) );
+         if (i > 0)
+            flag &= ( x[i-1] < x[i] );
+      }
+
+      for (int i = 0; i < N; ++i) {
+         if (p[i] >= 1e-4 && p[i] <= 1.0 - 1e-4)
+            flag &= isClose( x[i], GaussianCDFInv(p[i]), TOLERANCE );
+      }
+
+      return flag;
+   }
 }
 
 //-----------------------------------------------------------------------------
@@ -288,6 +367,8 @@ std::pair<int,int> test_SpecialFunctions()
    TALLY( TestIncompleteGammaInv() );
    TALLY( TestGaussianCDF() );
    TALLY( TestGaussianCDFInv() );
+   TALLY( TestGaussianCDFBatch() );
+   TALLY( TestGaussianCDFInvBatch() );
 
    return std::make_pair( nsucc, nfail );
 }
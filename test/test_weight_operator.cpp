@@ -0,0 +1,249 @@
+//=============================================================================
+// test_weight_operator.cpp
+//
+// author:
+//    Dr. Randal J. Barnes
+//    Department of Civil, Environmental, and Geo- Engineering
+//    University of Minnesota
+//
+// version:
+//    18 October 2026
+//=============================================================================
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "test_weight_operator.h"
+#include "unit_test.h"
+#include "..\src\engine.h"
+#include "..\src\weight_operator.h"
+
+//-----------------------------------------------------------------------------
+// Hide all of the testing details inside an unnamed namespace. This allows me
+// to create many small unit tests with polluting the global namespace.
+//-----------------------------------------------------------------------------
+namespace{
+   const double TOLERANCE = 1e-9;
+
+   const double NUGGET = 2.0;
+   const double SILL   = 30.0;
+   const double RANGE  = 400.0;
+
+   //--------------------------------------------------------------------------
+   // A scattered data set on a 1000 x 1000 square.
+   //--------------------------------------------------------------------------
+   std::vector<ObsRecord> ScatteredObs( int n, double phase )
+   {
+      std::vector<ObsRecord> obs;
+      for (int k = 0; k < n; ++k) {
+         double x = fmod(k * 618.034, 1000.0);
+         double y = fmod(k * 414.214 + 50.0, 1000.0);
+         ObsRecord s = { "", x, y, 100.0 + 0.01*x - 0.02*y + 3.0*sin(0.1*k + phase) };
+         obs.push_back(s);
+      }
+      return obs;
+   }
+
+   std::vector<TargetRecord> GridTargets()
+   {
+      std::vector<TargetRecord> targets;
+      for (int i = 0; i < 15; ++i) {
+         for (int j = 0; j < 15; ++j) {
+            TargetRecord s = { "", 35.0 + 65.0*i, 20.0 + 67.0*j };
+            targets.push_back(s);
+         }
+      }
+      return targets;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestWeightOperatorDense
+   //
+   //    The full weights reproduce Engine for new values at the same
+   //    locations, before and after a round trip through a file.
+   //--------------------------------------------------------------------------
+   bool TestWeightOperatorDense()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(120, 0.0);
+      std::vector<TargetRecord> targets = GridTargets();
+
+      WeightOperator W;
+      Weight_Engine(NUGGET, SILL, RANGE, obs, targets, 0, W);
+
+      bool flag = true;
+      flag &= CHECK( W.nObservations() == 120 );
+      flag &= CHECK( W.nTargets() == 225 );
+      flag &= CHECK( W.nWeights() == 120 );
+
+      std::stringstream file;
+      W.Save( file );
+      WeightOperator V;
+      V.Load( file );
+
+      for (int day = 1; day <= 3; ++day) {
+         std::vector<ObsRecord> today = ScatteredObs(120, day);
+         std::vector<ResultRecord> exact = Engine(NUGGET, SILL, RANGE, today, targets);
+         std::vector<ResultRecord> fromW = W.Apply(today);
+         std::vector<ResultRecord> fromV = V.Apply(today);
+
+         for (unsigned m = 0; m < targets.size(); ++m) {
+            flag &= CHECK( isClose(fromW[m].zhat, exact[m].zhat, TOLERANCE) );
+            flag &= CHECK( isClose(fromW[m].kstd, exact[m].kstd, TOLERANCE) );
+            flag &= CHECK( memcmp(&fromV[m].zhat, &fromW[m].zhat, sizeof(double)) == 0 );
+            flag &= CHECK( memcmp(&fromV[m].kstd, &fromW[m].kstd, sizeof(double)) == 0 );
+         }
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestWeightOperatorSparse
+   //
+   //    The kept weights are the largest, in increasing column order, and
+   //    sum to one, so a constant field is reproduced exactly.
+   //--------------------------------------------------------------------------
+   bool TestWeightOperatorSparse()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(120, 0.0);
+      std::vector<TargetRecord> targets = GridTargets();
+
+      WeightOperator full, W;
+      Weight_Engine(NUGGET, SILL, RANGE, obs, targets, 0, full);
+      Weight_Engine(NUGGET, SILL, RANGE, obs, targets, 16, W);
+
+      bool flag = true;
+      flag &= CHECK( W.nWeights() == 16 );
+
+      for (int m = 0; m < W.nTargets(); ++m) {
+         double sum = 0.0, smallest = 1e300;
+         for (int k = 0; k < 16; ++k) {
+            if (k > 0)
+               flag &= CHECK( W.Col(m,k) > W.Col(m,k-1) );
+            sum += W.Weight(m,k);
+            smallest = std::min(smallest, fabs(full.Weight(m, W.Col(m,k))));
+         }
+         flag &= CHECK( isClose(sum, 1.0, TOLERANCE) );
+
+         int larger = 0;
+         for (int n = 0; n < full.nWeights(); ++n)
+            larger += ( fabs(full.Weight(m,n)) > smallest );
+         flag &= CHECK( larger < 16 );
+      }
+
+      for (unsigned n = 0; n < obs.size(); ++n)
+         obs[n].z = 42.0;
+      std::vector<ResultRecord> results = W.Apply(obs);
+      for (unsigned m = 0; m < targets.size(); ++m)
+         flag &= CHECK( isClose(results[m].zhat, 42.0, TOLERANCE) );
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestWeightOperatorFewWeights
+   //
+   //    Keeping only one or two weights still gives finite rows that sum to
+   //    one.
+   //--------------------------------------------------------------------------
+   bool TestWeightOperatorFewWeights()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(120, 0.0);
+      std::vector<TargetRecord> targets = GridTargets();
+
+      bool flag = true;
+
+      for (int keep = 1; keep <= 2; ++keep) {
+         WeightOperator W;
+         Weight_Engine(NUGGET, SILL, RANGE, obs, targets, keep, W);
+         flag &= CHECK( W.nWeights() == keep );
+
+         for (int m = 0; m < W.nTargets(); ++m) {
+            double sum = 0.0;
+            for (int k = 0; k < keep; ++k) {
+               flag &= CHECK( std::isfinite(W.Weight(m,k)) );
+               sum += W.Weight(m,k);
+            }
+            flag &= CHECK( isClose(sum, 1.0, TOLERANCE) );
+         }
+      }
+
+      return flag;
+   }
+
+   //--------------------------------------------------------------------------
+   // TestWeightOperatorErrors
+   //
+   //    Values at other locations, and damaged files, are rejected.
+   //--------------------------------------------------------------------------
+   bool TestWeightOperatorErrors()
+   {
+      std::vector<ObsRecord> obs = ScatteredObs(60, 0.0);
+      std::vector<TargetRecord> targets = GridTargets();
+
+      WeightOperator W;
+      Weight_Engine(NUGGET, SILL, RANGE, obs, targets, 10, W);
+
+      bool flag = true;
+
+      std::vector<ObsRecord> moved = obs;
+      moved[7].x += 1.0;
+      try {
+         W.Apply(moved);
+         flag &= CHECK( false );
+      }
+      catch (ObservationMismatch&) {
+      }
+
+      try {
+         W.Apply( ScatteredObs(61, 0.0) );
+         flag &= CHECK( false );
+      }
+      catch (ObservationMismatch&) {
+      }
+
+      std::stringstream file;
+      W.Save( file );
+      std::string bytes = file.str();
+
+      std::stringstream truncated( bytes.substr(0, bytes.size()-5) );
+      WeightOperator V;
+      try {
+         V.Load( truncated );
+         flag &= CHECK( false );
+      }
+      catch (InvalidWeightsFile&) {
+      }
+      flag &= CHECK( V.nTargets() == 0 );
+
+      bytes[0] = 'X';
+      std::stringstream foreign( bytes );
+      try {
+         V.Load( foreign );
+         flag &= CHECK( false );
+      }
+      catch (InvalidWeightsFile&) {
+      }
+
+      return flag;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// test_WeightOperator
+//-----------------------------------------------------------------------------
+std::pair<int,int> test_WeightOperator()
+{
+   int nsucc = 0;
+   int nfail = 0;
+
+   TALLY( TestWeightOperatorDense() );
+   TALLY( TestWeightOperatorSparse() );
+   TALLY( TestWeightOperatorFewWeights() );
+   TALLY( TestWeightOperatorErrors() );
+
+   return std::make_pair( nsucc, nfail );
+}